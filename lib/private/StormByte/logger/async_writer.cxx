@@ -0,0 +1,216 @@
+#include <StormByte/logger/async_writer.hxx>
+#include <StormByte/logger/crash_registry.hxx>
+
+#include <algorithm>
+#include <chrono>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Safety net only: producers wake the writer explicitly.
+	constexpr auto idle_timeout = std::chrono::milliseconds(50);
+}
+
+AsyncWriter::AsyncWriter(std::ostream& out, const Level& level, const HeaderFormat& format,
+						 std::size_t capacity, const OverflowPolicy& policy):
+	m_out(out),
+	m_policy(policy),
+	m_recorder(),
+	m_stages(level, format, &m_recorder),
+	m_exited(),
+	m_ring(capacity),
+	m_sleeping(false),
+	m_stop(false),
+	m_retired(0),
+	m_dropped(0),
+	m_high_water(0),
+	m_writes(),
+	m_thread() {
+	// An exiting producer queues what it left unterminated, like the destructor does.
+	m_stages.OnRetire([this](Stage& stage) {
+		if (stage.Finish())
+			Push(stage.buffer.Data());
+		m_exited.Absorb(stage.impl.Counters());
+	});
+	CrashRegistry::Add(*this);
+	m_thread = std::thread(&AsyncWriter::Run, this);
+}
+
+AsyncWriter::~AsyncWriter() noexcept {
+	m_stages.Close();
+	CrashRegistry::Remove(*this);
+	try {
+		m_stages.ForEach([this](Stage& stage) {
+			if (stage.Finish())
+				Push(stage.buffer.Data());
+		});
+	} catch (...) {}
+
+	m_stop.store(true, std::memory_order_release);
+	{
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		m_wake.notify_one();
+	}
+	if (m_thread.joinable())
+		m_thread.join();
+
+	try {
+		m_out.flush();
+	} catch (...) {}
+}
+
+void AsyncWriter::Attach(const std::shared_ptr<FlightRecorder>& recorder) {
+	m_recorder = recorder;
+	m_stages.ForEach([&recorder](Stage& stage) {
+		stage.impl.SetRecorder(recorder);
+	});
+}
+
+void AsyncWriter::Collect(LogStats& stats) {
+	m_stages.ForEach([&stats](Stage& stage) {
+		stage.impl.Counters().Collect(stats);
+	}, [this, &stats] {
+		m_exited.Collect(stats);
+	});
+	m_writes.Collect(stats);
+	stats.queue_high_water = std::max(stats.queue_high_water, m_high_water.load(std::memory_order_relaxed));
+	stats.dropped += m_dropped.load(std::memory_order_relaxed);
+}
+
+void AsyncWriter::Push(std::string& record) noexcept {
+	for (;;) {
+		if (m_ring.TryPush(record)) [[likely]] {
+			const std::uint64_t retired = m_retired.load(std::memory_order_acquire);
+			const std::uint64_t depth = Queued(retired) - retired;
+			// Only a new maximum pays for the compare-exchange.
+			std::uint64_t high = m_high_water.load(std::memory_order_relaxed);
+			while (depth > high && !m_high_water.compare_exchange_weak(high, depth, std::memory_order_relaxed)) {}
+			Wake();
+			return;
+		}
+
+		switch (m_policy) {
+			case OverflowPolicy::DropNewest:
+				m_dropped.fetch_add(1, std::memory_order_relaxed);
+				record.clear();
+				return;
+
+			case OverflowPolicy::DropOldest: {
+				std::string victim;
+				if (m_ring.TryPop(victim)) {
+					m_dropped.fetch_add(1, std::memory_order_relaxed);
+					Retire(1);
+				}
+				break;
+			}
+
+			case OverflowPolicy::Synchronous: {
+				// Drain first so the record does not overtake lines already queued.
+				std::string scratch;
+				std::lock_guard<std::mutex> lock(m_sink_mutex);
+				Retire(Drain(scratch));
+				const std::uint64_t started = m_writes.Begin(record.size());
+				try {
+					m_out.write(record.data(), static_cast<std::streamsize>(record.size()));
+				} catch (...) {}
+				m_writes.End(started);
+				record.clear();
+				return;
+			}
+
+			case OverflowPolicy::Block:
+			default:
+				Wake();
+				std::this_thread::yield();
+				break;
+		}
+	}
+}
+
+std::size_t AsyncWriter::Drain(std::string& scratch) noexcept {
+	std::size_t written = 0;
+	// After a fatal signal the handler takes the remaining records itself.
+	while (!CrashRegistry::Crashing() && m_ring.TryPop(scratch)) {
+		const std::uint64_t started = m_writes.Begin(scratch.size());
+		try {
+			m_out.write(scratch.data(), static_cast<std::streamsize>(scratch.size()));
+		} catch (...) {}
+		m_writes.End(started);
+		++written;
+	}
+	return written;
+}
+
+void AsyncWriter::Retire(std::uint64_t count) noexcept {
+	if (count == 0)
+		return;
+	m_retired.fetch_add(count, std::memory_order_release);
+	m_retired.notify_all();
+}
+
+std::uint64_t AsyncWriter::Queued(std::uint64_t retired) const noexcept {
+	// The ring's position wraps at std::size_t. Read after @p retired (acquired), it is never
+	// behind it: every retired record was claimed first.
+	return retired + static_cast<std::size_t>(m_ring.Enqueued() - static_cast<std::size_t>(retired));
+}
+
+void AsyncWriter::Wake() noexcept {
+	// Pairs with the fence in Run(): either we see m_sleeping or the writer sees our record.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (m_sleeping.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		m_wake.notify_one();
+	}
+}
+
+void AsyncWriter::Flush() noexcept {
+	// Every slot claimed so far counts, so the caller's own records are in even while another
+	// producer is still storing one it claimed earlier.
+	std::uint64_t retired = m_retired.load(std::memory_order_acquire);
+	const std::uint64_t target = Queued(retired);
+	Wake();
+
+	while (retired < target) {
+		m_retired.wait(retired, std::memory_order_acquire);
+		retired = m_retired.load(std::memory_order_acquire);
+	}
+
+	std::lock_guard<std::mutex> lock(m_sink_mutex);
+	try {
+		m_out.flush();
+	} catch (...) {}
+}
+
+void AsyncWriter::Run() noexcept {
+	std::string scratch;
+	bool dirty = false;
+
+	for (;;) {
+		std::size_t written;
+		{
+			std::lock_guard<std::mutex> lock(m_sink_mutex);
+			written = Drain(scratch);
+			// Going idle: hand what we have to the OS before sleeping.
+			if (written == 0 && dirty) {
+				try {
+					m_out.flush();
+				} catch (...) {}
+				dirty = false;
+			}
+		}
+		if (written > 0) {
+			dirty = true;
+			Retire(written);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(m_wake_mutex);
+		if (m_stop.load(std::memory_order_acquire) && m_ring.Empty())
+			break;
+		m_sleeping.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_ring.Empty() && !m_stop.load(std::memory_order_acquire))
+			m_wake.wait_for(lock, idle_timeout);
+		m_sleeping.store(false, std::memory_order_relaxed);
+	}
+}
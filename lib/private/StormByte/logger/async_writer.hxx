@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/line_stage.hxx>
+#include <StormByte/logger/log_counters.hxx>
+#include <StormByte/logger/record_ring.hxx>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class AsyncWriter
+	 * @brief Shared state behind AsyncLog (private).
+	 *
+	 * Producers format into their own Stage and push finished lines into a RecordRing;
+	 * a dedicated thread drains the ring into the output stream. The sink mutex is only
+	 * contended between the writer and producers using OverflowPolicy::Synchronous.
+	 *
+	 * Destruction commits any unterminated staged text as a line, drains the ring and joins the
+	 * writer, so nothing accepted by the queue is lost.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE AsyncWriter final {
+		public:
+			/**
+			 * @brief Construct the writer and start its thread.
+			 * @param out Output stream drained into.
+			 * @param level Minimum Level for producer stages.
+			 * @param format Compiled header format for producer stages.
+			 * @param capacity Queue capacity in records.
+			 * @param policy Behaviour when the queue is full.
+			 */
+			AsyncWriter(std::ostream& out, const Level& level, const HeaderFormat& format,
+						std::size_t capacity, const OverflowPolicy& policy);
+
+			AsyncWriter(const AsyncWriter&) = delete;
+			AsyncWriter(AsyncWriter&&) noexcept = delete;
+			AsyncWriter& operator=(const AsyncWriter&) = delete;
+			AsyncWriter& operator=(AsyncWriter&&) noexcept = delete;
+
+			/**
+			 * @brief Commit unterminated lines, drain the queue and join the writer thread.
+			 */
+			~AsyncWriter() noexcept;
+
+			/**
+			 * @brief Id of the stage registry, for Log::StageFilter().
+			 * @return The id.
+			 */
+			std::uint64_t Registry() const noexcept {
+				return m_stages.Id();
+			}
+
+			/**
+			 * @brief Get the calling thread's stage.
+			 * @return Reference to the stage.
+			 */
+			Stage& Local() {
+				return m_stages.Local();
+			}
+
+			/**
+			 * @brief Capture filtered records of every stage, current and future, into @p recorder.
+			 * @param recorder Shared recorder.
+			 */
+			void Attach(const std::shared_ptr<FlightRecorder>& recorder);
+
+			/**
+			 * @brief Queue the stage's text if it ends a line.
+			 * @param stage Calling thread's stage.
+			 */
+			void Commit(Stage& stage) noexcept {
+				if (stage.Complete())
+					Push(stage.buffer.Data());
+			}
+
+			/**
+			 * @brief Wait until every record queued so far is written, then flush the stream.
+			 */
+			void Flush() noexcept;
+
+			/**
+			 * @brief Stream drained into.
+			 * @return The output stream.
+			 */
+			const std::ostream& Stream() const noexcept {
+				return m_out;
+			}
+
+			/**
+			 * @brief Take the oldest queued record from a fatal signal handler (see CrashRegistry).
+			 * @param record Receives the record; swapped in, so nothing is allocated.
+			 * @return false if the queue is empty.
+			 */
+			bool CrashPop(std::string& record) noexcept {
+				return m_ring.TryPop(record);
+			}
+
+			/**
+			 * @brief Number of records discarded by the overflow policy.
+			 * @return Dropped record count.
+			 */
+			std::uint64_t Dropped() const noexcept {
+				return m_dropped.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Add the counters of every stage, the queue and the writes to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			void Collect(LogStats& stats);
+
+		private:
+			std::ostream& m_out;						///< Output stream
+			const OverflowPolicy m_policy;				///< Full-queue behaviour
+			std::shared_ptr<FlightRecorder> m_recorder;	///< Given to new stages
+			StageRegistry<Stage> m_stages;				///< Producer stages
+			LevelCounters m_exited;						///< Counters of stages whose thread exited, under the registry mutex
+			RecordRing m_ring;							///< Finished records
+			std::mutex m_sink_mutex;					///< Serializes writes to m_out
+			std::mutex m_wake_mutex;					///< Guards m_wake
+			std::condition_variable m_wake;				///< Wakes the idle writer
+			std::atomic<bool> m_sleeping;				///< Writer is (about to be) idle
+			std::atomic<bool> m_stop;					///< Shutdown requested
+			std::atomic<std::uint64_t> m_retired;		///< Records popped from the ring: written or discarded
+			std::atomic<std::uint64_t> m_dropped;		///< Records discarded by the policy
+			std::atomic<std::uint64_t> m_high_water;	///< Most records queued and not yet written, seen by a producer
+			WriteCounters m_writes;						///< Record writes, under m_sink_mutex
+			std::thread m_thread;						///< Writer thread (started last)
+
+			/**
+			 * @brief Queue a finished record according to the overflow policy.
+			 * @param record Record text; cleared on return.
+			 */
+			void Push(std::string& record) noexcept;
+
+			/**
+			 * @brief Pop and write every queued record. Caller holds m_sink_mutex.
+			 * @param scratch Reusable buffer.
+			 * @return Number of records written.
+			 */
+			std::size_t Drain(std::string& scratch) noexcept;
+
+			/**
+			 * @brief Mark records retired and wake Flush() waiters.
+			 * @param count Number of records.
+			 */
+			void Retire(std::uint64_t count) noexcept;
+
+			/**
+			 * @brief Records queued so far, on the scale of m_retired.
+			 * @param retired Value of m_retired read before the call.
+			 * @return Pushes claimed so far, including those still storing their record.
+			 */
+			std::uint64_t Queued(std::uint64_t retired) const noexcept;
+
+			/**
+			 * @brief Wake the writer thread if it is idle.
+			 */
+			void Wake() noexcept;
+
+			/**
+			 * @brief Writer thread body.
+			 */
+			void Run() noexcept;
+	};
+}
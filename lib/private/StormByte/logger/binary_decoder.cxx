@@ -0,0 +1,276 @@
+#include <StormByte/logger/binary_decoder.hxx>
+#include <StormByte/logger/binary_format.hxx>
+#include <StormByte/logger/implementation.hxx>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Output of the manipulator being replayed; read by replay_manipulator().
+	thread_local std::string_view t_manipulator_output;
+
+	std::ostream& replay_manipulator(std::ostream& out) {
+		out.write(t_manipulator_output.data(), static_cast<std::streamsize>(t_manipulator_output.size()));
+		return out;
+	}
+
+	// Bounds-checked cursor over one chunk.
+	class Cursor final {
+		public:
+			explicit Cursor(std::string_view data) noexcept: m_data(data), m_offset(0) {}
+
+			bool AtEnd() const noexcept {
+				return m_offset == m_data.size();
+			}
+
+			template <typename T>
+			bool Get(T& value) noexcept {
+				if (m_data.size() - m_offset < sizeof(T))
+					return false;
+				std::memcpy(&value, m_data.data() + m_offset, sizeof(T));
+				m_offset += sizeof(T);
+				return true;
+			}
+
+			bool Bytes(std::string_view& text) noexcept {
+				std::uint32_t size;
+				if (!Get(size) || m_data.size() - m_offset < size)
+					return false;
+				text = m_data.substr(m_offset, size);
+				m_offset += size;
+				return true;
+			}
+
+		private:
+			std::string_view m_data;
+			std::size_t m_offset;
+	};
+
+	template <typename T>
+	bool read(std::istream& in, T& value) {
+		return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+
+	// Replay state of one producer thread.
+	struct Slot {
+		std::string thread;
+		std::string tid;
+		std::string name;
+		std::vector<std::string> literals;
+		Implementation impl;
+
+		Slot(std::ostream& out, const Level& level, const HeaderFormat& format): impl(out, level, format) {}
+	};
+
+	template <typename T>
+	bool value(Cursor& cursor, Implementation& impl) {
+		T v;
+		if (!cursor.Get(v))
+			return false;
+		impl << v;
+		return true;
+	}
+
+	bool replay(Cursor& cursor, Slot& slot) {
+		Implementation& impl = slot.impl;
+		std::uint8_t tag;
+		while (!cursor.AtEnd()) {
+			if (!cursor.Get(tag))
+				return false;
+			switch (static_cast<BinaryTag>(tag)) {
+				case BinaryTag::ThreadLabel: {
+					std::string_view text;
+					if (!cursor.Bytes(text))
+						return false;
+					slot.thread.assign(text);
+					break;
+				}
+				case BinaryTag::ThreadName: {
+					std::string_view tid, name;
+					if (!cursor.Bytes(tid) || !cursor.Bytes(name))
+						return false;
+					slot.tid.assign(tid);
+					slot.name.assign(name);
+					break;
+				}
+				case BinaryTag::Define: {
+					std::uint32_t id;
+					std::string_view text;
+					if (!cursor.Get(id) || !cursor.Bytes(text) || id > slot.literals.size())
+						return false;
+					if (id == slot.literals.size())
+						slot.literals.emplace_back(text);
+					else
+						slot.literals[id].assign(text);
+					impl << slot.literals[id];
+					break;
+				}
+				case BinaryTag::Literal: {
+					std::uint32_t id;
+					if (!cursor.Get(id) || id >= slot.literals.size())
+						return false;
+					impl << slot.literals[id];
+					break;
+				}
+				case BinaryTag::Text: {
+					std::string_view text;
+					if (!cursor.Bytes(text))
+						return false;
+					impl << std::string(text);
+					break;
+				}
+				case BinaryTag::Bool: {
+					std::uint8_t v;
+					if (!cursor.Get(v))
+						return false;
+					impl << (v != 0);
+					break;
+				}
+				case BinaryTag::Char:				if (!value<char>(cursor, impl)) return false; break;
+				case BinaryTag::SignedChar:			if (!value<signed char>(cursor, impl)) return false; break;
+				case BinaryTag::UnsignedChar:		if (!value<unsigned char>(cursor, impl)) return false; break;
+				case BinaryTag::Short:				if (!value<short>(cursor, impl)) return false; break;
+				case BinaryTag::UnsignedShort:		if (!value<unsigned short>(cursor, impl)) return false; break;
+				case BinaryTag::Int:				if (!value<int>(cursor, impl)) return false; break;
+				case BinaryTag::UnsignedInt:		if (!value<unsigned int>(cursor, impl)) return false; break;
+				case BinaryTag::Long:				if (!value<long>(cursor, impl)) return false; break;
+				case BinaryTag::UnsignedLong:		if (!value<unsigned long>(cursor, impl)) return false; break;
+				case BinaryTag::LongLong:			if (!value<long long>(cursor, impl)) return false; break;
+				case BinaryTag::UnsignedLongLong:	if (!value<unsigned long long>(cursor, impl)) return false; break;
+				case BinaryTag::Float:				if (!value<float>(cursor, impl)) return false; break;
+				case BinaryTag::Double:				if (!value<double>(cursor, impl)) return false; break;
+				case BinaryTag::LongDouble:			if (!value<long double>(cursor, impl)) return false; break;
+				case BinaryTag::Level: {
+					std::uint8_t level;
+					if (!cursor.Get(level) || level > static_cast<std::uint8_t>(Level::Fatal))
+						return false;
+					impl << static_cast<Level>(level);
+					break;
+				}
+				case BinaryTag::Header: {
+					std::int64_t seconds;
+					std::uint32_t nanoseconds;
+					if (!cursor.Get(seconds) || !cursor.Get(nanoseconds))
+						return false;
+					impl.Replay(Instant{ static_cast<std::time_t>(seconds), nanoseconds }, ThreadText{ slot.thread, slot.tid, slot.name });
+					break;
+				}
+				case BinaryTag::Manipulator: {
+					std::uint8_t flush;
+					std::string_view output;
+					if (!cursor.Get(flush) || !cursor.Bytes(output))
+						return false;
+					t_manipulator_output = output;
+					impl << replay_manipulator;
+					if (flush)
+						impl << static_cast<std::ostream& (*)(std::ostream&)>(std::flush);
+					break;
+				}
+				case BinaryTag::EndRecord:
+					impl.EndRecord();
+					break;
+				case BinaryTag::HumanReadable: {
+					std::uint8_t format;
+					if (!cursor.Get(format))
+						return false;
+					if (format == 1)
+						humanreadable_number(impl);
+					else if (format == 2)
+						humanreadable_bytes(impl);
+					else
+						nohumanreadable(impl);
+					break;
+				}
+				case BinaryTag::Redact: {
+					std::uint8_t active, keep_first;
+					std::uint64_t count;
+					if (!cursor.Get(active) || !cursor.Get(count) || !cursor.Get(keep_first))
+						return false;
+					impl.SetRedact(active != 0, static_cast<std::size_t>(count), keep_first != 0);
+					break;
+				}
+				case BinaryTag::Precision: {
+					std::int32_t digits;
+					if (!cursor.Get(digits))
+						return false;
+					impl.SetPrecision(digits);
+					break;
+				}
+				case BinaryTag::Base: {
+					std::uint8_t base;
+					if (!cursor.Get(base))
+						return false;
+					if (base == 16)
+						impl << static_cast<std::ios_base& (*)(std::ios_base&)>(std::hex);
+					else if (base == 8)
+						impl << static_cast<std::ios_base& (*)(std::ios_base&)>(std::oct);
+					else
+						impl << static_cast<std::ios_base& (*)(std::ios_base&)>(std::dec);
+					break;
+				}
+				case BinaryTag::Key: {
+					std::string_view key;
+					if (!cursor.Bytes(key))
+						return false;
+					impl.SetKey(key);
+					break;
+				}
+				default:
+					return false;
+			}
+		}
+		return true;
+	}
+}
+
+bool BinaryDecoder::Decode(std::istream& in, std::ostream& out, const std::optional<HeaderFormat>& format) noexcept {
+	try {
+		char magic[BinaryFormat::Magic.size()];
+		std::uint32_t version;
+		std::uint8_t print_level;
+		std::uint8_t encoding;
+		std::uint32_t pattern_size;
+		if (!in.read(magic, sizeof(magic)) || std::string_view(magic, sizeof(magic)) != BinaryFormat::Magic)
+			return false;
+		if (!read(in, version) || version < BinaryFormat::OldestVersion || version > BinaryFormat::Version)
+			return false;
+		if (!read(in, print_level) || print_level > static_cast<std::uint8_t>(Level::Fatal) || !read(in, encoding)
+			|| encoding > static_cast<std::uint8_t>(Encoding::Logfmt) || !read(in, pattern_size))
+			return false;
+		std::string pattern(pattern_size, '\0');
+		if (!in.read(pattern.data(), static_cast<std::streamsize>(pattern_size)))
+			return false;
+
+		const HeaderFormat header = format ? *format : HeaderFormat(pattern, static_cast<Encoding>(encoding));
+		const auto level = static_cast<Level>(print_level);
+		std::unordered_map<std::uint32_t, std::unique_ptr<Slot>> slots;
+		std::string chunk;
+		std::uint32_t slot_id, size;
+		while (read(in, slot_id)) {
+			if (!read(in, size))
+				return false;
+			chunk.resize(size);
+			if (!in.read(chunk.data(), static_cast<std::streamsize>(size)))
+				return false;
+
+			auto& slot = slots[slot_id];
+			if (!slot)
+				slot = std::make_unique<Slot>(out, level, header);
+			Cursor cursor(chunk);
+			if (!replay(cursor, *slot))
+				return false;
+		}
+		out.flush();
+		// Stopping anywhere but at a chunk boundary means the file was cut short.
+		return in.eof() && in.gcount() == 0;
+	} catch (...) {
+		return false;
+	}
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/header_format.hxx>
+
+#include <istream>
+#include <optional>
+#include <ostream>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct BinaryDecoder
+	 * @brief Renders deferred-formatting logs back to text (private).
+	 *
+	 * Every slot (producer thread) replays its tags through its own Implementation writing
+	 * to the output, with the recorded header instants and thread id, so the text is the
+	 * one a Log with the same level and format would have written.
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE BinaryDecoder {
+		/**
+		 * @brief Decode @p in into @p out.
+		 * @param in Binary log.
+		 * @param out Text output.
+		 * @param format Header format overriding the recorded one.
+		 * @return false if @p in is not a binary log or is truncated/corrupt; what was
+		 *         decoded up to that point has been written.
+		 */
+		static bool Decode(std::istream& in, std::ostream& out, const std::optional<HeaderFormat>& format) noexcept;
+	};
+}
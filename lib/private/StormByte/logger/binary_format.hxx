@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @enum BinaryTag
+	 * @brief Tags of the deferred-formatting log format (private).
+	 *
+	 * A file starts with @ref BinaryFormat::Magic, the format version, the print level, the
+	 * line encoding and the header format pattern. It is followed by chunks `[u32 slot][u32 size][tags]`, one
+	 * producer thread per slot; a chunk always ends at a line boundary, so decoding chunks in
+	 * file order reproduces the line interleaving of the text loggers. Every value is stored
+	 * in native byte order and size: files are decoded on the platform that wrote them.
+	 */
+	enum class BinaryTag : std::uint8_t {
+		ThreadLabel = 1,							///< u32 size, bytes: thread id text of the slot
+		Define,										///< u32 id, u32 size, bytes: intern a literal, then write it
+		Literal,									///< u32 id: write an interned literal
+		Text,										///< u32 size, bytes
+		Bool,										///< u8
+		Char,										///< char
+		SignedChar,									///< signed char
+		UnsignedChar,								///< unsigned char
+		Short,										///< short
+		UnsignedShort,								///< unsigned short
+		Int,										///< int
+		UnsignedInt,								///< unsigned int
+		Long,										///< long
+		UnsignedLong,								///< unsigned long
+		LongLong,									///< long long
+		UnsignedLongLong,							///< unsigned long long
+		Float,										///< float
+		Double,										///< double
+		LongDouble,									///< long double
+		Level,										///< u8 Level
+		Header,										///< i64 seconds, u32 nanoseconds: instant of the next header
+		Manipulator,								///< u8 flush, u32 size, bytes: output of a stream manipulator
+		EndRecord,									///< endr
+		HumanReadable,								///< u8: 0 raw, 1 number, 2 bytes
+		Redact,										///< u8 active, u64 count, u8 keep_first
+		Precision,									///< i32 digits
+		Base,										///< u8 base (8, 10 or 16)
+		Key,										///< u32 size, bytes: name of the next value
+		ThreadName									///< u32 size, bytes: kernel thread id; u32 size, bytes: name of the slot's thread
+	};
+
+	/**
+	 * @struct BinaryFormat
+	 * @brief File-level constants of the deferred-formatting log format (private).
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE BinaryFormat {
+		static constexpr std::string_view Magic = "SBLOGBIN";	///< File signature
+		static constexpr std::uint32_t Version = 3;				///< Format version (also detects byte order)
+		static constexpr std::uint32_t OldestVersion = 2;		///< Oldest version still decoded
+	};
+}
@@ -0,0 +1,285 @@
+#include <StormByte/logger/binary_writer.hxx>
+
+#include <cstring>
+#include <streambuf>
+
+using namespace StormByte::Logger;
+
+namespace {
+	constexpr std::size_t max_interned_literals = 4096;
+
+	// Keeps whatever a stream manipulator writes, remembering whether it asked for a sync.
+	class CaptureBuffer final: public std::streambuf {
+		public:
+			std::string text;
+			bool synced = false;
+		protected:
+			int sync() override { synced = true; return 0; }
+			int_type overflow(int_type ch) override {
+				if (!traits_type::eq_int_type(ch, traits_type::eof()))
+					text.push_back(traits_type::to_char_type(ch));
+				return traits_type::not_eof(ch);
+			}
+			std::streamsize xsputn(const char* s, std::streamsize count) override {
+				text.append(s, static_cast<std::size_t>(count));
+				return count;
+			}
+	};
+}
+
+BinaryStage::BinaryStage(const Level& level, std::atomic<std::uint32_t>* slots):
+	null(nullptr),
+	shadow(null, level),
+	record(),
+	slot(slots->fetch_add(1, std::memory_order_relaxed)),
+	thread_generation(0),
+	header_open(false),
+	has_level(false),
+	level_tag(std::string::npos),
+	literals(),
+	next_literal(0),
+	secrets(),
+	secret_buffer() {
+	put_tag(BinaryTag::ThreadLabel);
+	put_bytes(ThreadIdentity::Local().Text().id);
+	put_thread_name();
+}
+
+void BinaryStage::Text(std::string_view text) noexcept {
+	if (!Enabled())
+		return;
+	if (shadow.MasksSecrets()) [[unlikely]]
+		secrets.Mask(text, secret_buffer);
+	put_text(text);
+}
+
+void BinaryStage::Key(std::string_view key) noexcept {
+	// Like Implementation::SetKey, a key alone does not start a line.
+	if (!Enabled())
+		return;
+	if (shadow.MasksSecrets() && SecretScanner::IsSecretKey(key)) [[unlikely]]
+		secrets.Expect();
+	put_tag(BinaryTag::Key);
+	put_bytes(key);
+}
+
+void BinaryStage::Literal(const char* text) noexcept {
+	if (!Enabled())
+		return;
+	if (!text) {
+		Text({});
+		return;
+	}
+	if (shadow.MasksSecrets()) [[unlikely]] {
+		// Masked text differs from the literal, and a clean one still advances the scanner.
+		std::string_view view(text);
+		secrets.Mask(view, secret_buffer);
+		put_text(view);
+		return;
+	}
+
+	auto it = literals.find(text);
+	if (it != literals.end() && std::strncmp(text, it->second.text.c_str(), it->second.text.size() + 1) == 0) [[likely]] {
+		open_header();
+		put_tag(BinaryTag::Literal);
+		put(it->second.id);
+		return;
+	}
+
+	const std::string_view view(text);
+	try {
+		if (it == literals.end()) {
+			if (literals.size() >= max_interned_literals) {
+				put_text(view);
+				return;
+			}
+			it = literals.emplace(text, Interned{ 0, {} }).first;
+		}
+		it->second.id = next_literal++;
+		it->second.text.assign(view);
+	} catch (...) {
+		put_text(view);
+		return;
+	}
+	open_header();
+	put_tag(BinaryTag::Define);
+	put(it->second.id);
+	put_bytes(view);
+}
+
+bool BinaryStage::SetLevel(const Level& level) noexcept {
+	// Same rule as Implementation::operator<<(Level).
+	const bool line_end = header_open && has_level && level != shadow.CurrentLevel()
+		&& shadow.CurrentLevel() >= shadow.PrintLevel();
+
+	// Between lines a level switch is pure state: consecutive ones fold into the last.
+	const bool foldable = !header_open;
+	if (foldable && level_tag != std::string::npos)
+		record.resize(level_tag);
+	const std::size_t offset = record.size();
+	put_tag(BinaryTag::Level);
+	put(static_cast<std::uint8_t>(level));
+	level_tag = foldable ? offset : std::string::npos;
+
+	shadow << level;
+	has_level = true;
+	if (line_end) {
+		header_open = false;
+		secrets.Clear();
+	}
+	return line_end;
+}
+
+bool BinaryStage::Manipulator(std::ostream& (*manip)(std::ostream&), bool& flush) noexcept {
+	flush = false;
+	if (!Enabled())
+		return false;
+
+	using StreamManipulator = std::ostream& (*)(std::ostream&);
+	std::string_view output;
+	CaptureBuffer capture;
+	if (manip == static_cast<StreamManipulator>(std::endl)) [[likely]] {
+		output = "\n";
+		flush = true;
+	} else if (manip == static_cast<StreamManipulator>(std::flush)) {
+		flush = true;
+	} else {
+		// std::ends, an unknown manipulator, or a standard one whose address differs across
+		// shared objects: keep exactly what it writes.
+		try {
+			std::ostream probe(&capture);
+			manip(probe);
+		} catch (...) {}
+		output = capture.text;
+		flush = capture.synced;
+	}
+
+	put_tag(BinaryTag::Manipulator);
+	put(static_cast<std::uint8_t>(flush));
+	put_bytes(output);
+	header_open = false;
+	secrets.Clear();
+	return output.find('\n') != std::string_view::npos || flush;
+}
+
+bool BinaryStage::EndRecord() noexcept {
+	if (!header_open)
+		return false;
+	put_tag(BinaryTag::EndRecord);
+	header_open = false;
+	secrets.Clear();
+	return true;
+}
+
+void BinaryStage::Base(std::ios_base& (*manip)(std::ios_base&)) noexcept {
+	// Same approach as Implementation: apply it and read the basefield back.
+	const std::ios_base::fmtflags saved = null.flags();
+	manip(null);
+	const std::ios_base::fmtflags base = null.flags() & std::ios_base::basefield;
+	null.flags(saved);
+	if (base == std::ios_base::hex)
+		State(BinaryTag::Base, static_cast<std::uint8_t>(16));
+	else if (base == std::ios_base::oct)
+		State(BinaryTag::Base, static_cast<std::uint8_t>(8));
+	else if (base == std::ios_base::dec)
+		State(BinaryTag::Base, static_cast<std::uint8_t>(10));
+}
+
+void BinaryStage::put_text(std::string_view text) noexcept {
+	open_header();
+	put_tag(BinaryTag::Text);
+	put_bytes(text);
+}
+
+void BinaryStage::put_bytes(std::string_view text) noexcept {
+	put(static_cast<std::uint32_t>(text.size()));
+	try {
+		record.append(text);
+	} catch (...) {}
+}
+
+void BinaryStage::put_thread_name() noexcept {
+	const ThreadIdentity& identity = ThreadIdentity::Local();
+	const ThreadText text = identity.Text();
+	put_tag(BinaryTag::ThreadName);
+	put_bytes(text.tid);
+	put_bytes(text.name);
+	thread_generation = identity.Generation();
+}
+
+void BinaryStage::open_header() noexcept {
+	if (header_open)
+		return;
+	if (thread_generation != ThreadIdentity::Local().Generation()) [[unlikely]]
+		put_thread_name();
+	shadow.Counters().Emitted(shadow.CurrentLevel());
+	const Instant now = Instant::Now();
+	put_tag(BinaryTag::Header);
+	put(static_cast<std::int64_t>(now.seconds));
+	put(now.nanoseconds);
+	header_open = true;
+}
+
+BinaryWriter::BinaryWriter(std::ostream& out, const Level& level, const HeaderFormat& format):
+	m_out(out), m_mutex(), m_writes(), m_slots(0), m_stages(level, &m_slots), m_exited() {
+	// An exiting producer commits its pending tags, like the destructor does.
+	m_stages.OnRetire([this](BinaryStage& stage) {
+		if (!stage.record.empty())
+			Emit(stage);
+		m_exited.Absorb(stage.shadow.Counters());
+	});
+	const std::string pattern = format.Pattern();
+	const std::uint32_t version = BinaryFormat::Version;
+	const auto print_level = static_cast<std::uint8_t>(level);
+	const auto encoding = static_cast<std::uint8_t>(format.LineEncoding());
+	const auto pattern_size = static_cast<std::uint32_t>(pattern.size());
+	try {
+		m_out.write(BinaryFormat::Magic.data(), static_cast<std::streamsize>(BinaryFormat::Magic.size()));
+		m_out.write(reinterpret_cast<const char*>(&version), sizeof(version));
+		m_out.write(reinterpret_cast<const char*>(&print_level), sizeof(print_level));
+		m_out.write(reinterpret_cast<const char*>(&encoding), sizeof(encoding));
+		m_out.write(reinterpret_cast<const char*>(&pattern_size), sizeof(pattern_size));
+		m_out.write(pattern.data(), static_cast<std::streamsize>(pattern.size()));
+	} catch (...) {}
+}
+
+BinaryWriter::~BinaryWriter() noexcept {
+	m_stages.Close();
+	try {
+		m_stages.ForEach([this](BinaryStage& stage) {
+			if (!stage.record.empty())
+				Emit(stage);
+		});
+	} catch (...) {}
+	Flush();
+}
+
+void BinaryWriter::Flush() noexcept {
+	try {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_out.flush();
+	} catch (...) {}
+}
+
+void BinaryWriter::Collect(LogStats& stats) {
+	m_stages.ForEach([&stats](BinaryStage& stage) {
+		stage.shadow.Counters().Collect(stats);
+	}, [this, &stats] {
+		m_exited.Collect(stats);
+	});
+	m_writes.Collect(stats);
+}
+
+void BinaryWriter::Emit(BinaryStage& stage) noexcept {
+	const auto size = static_cast<std::uint32_t>(stage.record.size());
+	try {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		const std::uint64_t started = m_writes.Begin(sizeof(stage.slot) + sizeof(size) + size);
+		m_out.write(reinterpret_cast<const char*>(&stage.slot), sizeof(stage.slot));
+		m_out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+		m_out.write(stage.record.data(), static_cast<std::streamsize>(size));
+		m_writes.End(started);
+	} catch (...) {}
+	stage.record.clear();
+	stage.level_tag = std::string::npos;
+}
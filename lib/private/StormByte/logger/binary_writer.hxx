@@ -0,0 +1,296 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/binary_format.hxx>
+#include <StormByte/logger/line_stage.hxx>
+#include <StormByte/logger/log_counters.hxx>
+#include <StormByte/logger/secret_scanner.hxx>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct BinaryStage
+	 * @brief Per-thread record buffer of BinaryLog (private).
+	 *
+	 * Values are appended as tagged raw bytes; nothing is formatted. A shadow Implementation
+	 * over a stream without buffer tracks the level filter (and serves Log::Active()), while
+	 * the header/newline bookkeeping of Implementation is mirrored here so the stage knows
+	 * where lines end without rendering them.
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE BinaryStage {
+		/**
+		 * @struct Interned
+		 * @brief A `const char*` already sent to the file.
+		 */
+		struct Interned {
+			std::uint32_t id;							///< Literal id within the slot
+			std::string text;							///< Text it was interned with
+		};
+
+		std::ostream null;								///< Stream without buffer (writes nothing)
+		Implementation shadow;							///< Level filter state
+		std::string record;								///< Tags not yet committed
+		const std::uint32_t slot;						///< Slot of this thread in the file
+		std::uint32_t thread_generation;				///< Name generation last recorded (see ThreadIdentity)
+		bool header_open;								///< A header was recorded for the current line
+		bool has_level;									///< A level was ever set
+		std::size_t level_tag;							///< Offset of a trailing state-only Level tag, or npos
+		std::unordered_map<const char*, Interned> literals;	///< Interned literals by address
+		std::uint32_t next_literal;						///< Next literal id
+		SecretScanner secrets;							///< Secret detection state (see mask_secrets)
+		std::string secret_buffer;						///< Reusable storage for masked text
+
+		/**
+		 * @brief Construct a stage; its first tag labels the calling thread.
+		 * @param level Minimum Level that will be recorded.
+		 * @param slots Slot counter of the writer.
+		 */
+		BinaryStage(const Level& level, std::atomic<std::uint32_t>* slots);
+
+		/**
+		 * @brief Whether the current level is enabled.
+		 * @return true if values are recorded.
+		 */
+		bool Enabled() const noexcept {
+			return shadow.Enabled();
+		}
+
+		/**
+		 * @brief Record an arithmetic value if the current level is enabled.
+		 * @tparam T Arithmetic type matching @p tag.
+		 * @param tag Tag of @p value.
+		 * @param value Value.
+		 */
+		template <typename T>
+		void Value(const BinaryTag& tag, const T& value) noexcept {
+			if (!Enabled())
+				return;
+			secrets.Clear();
+			open_header();
+			put_tag(tag);
+			put(value);
+		}
+
+		/**
+		 * @brief Record text if the current level is enabled.
+		 *
+		 * With mask_secrets active, detected secrets are masked before recording, so they
+		 * never reach the file.
+		 * @param text Text.
+		 */
+		void Text(std::string_view text) noexcept;
+
+		/**
+		 * @brief Record the key of the next value if the current level is enabled.
+		 * @param key Field name.
+		 */
+		void Key(std::string_view key) noexcept;
+
+		/**
+		 * @brief Record a C string, interning it by address if the current level is enabled.
+		 *
+		 * Addresses are not trusted blindly: the cached text is compared before it is
+		 * referenced, so reused buffers are re-sent.
+		 * @param text C string (may be null).
+		 */
+		void Literal(const char* text) noexcept;
+
+		/**
+		 * @brief Record a level switch.
+		 * @param level New level.
+		 * @return true if the switch ends the current line.
+		 */
+		bool SetLevel(const Level& level) noexcept;
+
+		/**
+		 * @brief Record the output of a stream manipulator if the current level is enabled.
+		 * @param manip Stream manipulator.
+		 * @param flush Set to whether the manipulator flushes.
+		 * @return true if the current line ended.
+		 */
+		bool Manipulator(std::ostream& (*manip)(std::ostream&), bool& flush) noexcept;
+
+		/**
+		 * @brief Record the end of a record (see @ref endr).
+		 * @return true if a line ended.
+		 */
+		bool EndRecord() noexcept;
+
+		/**
+		 * @brief Record a state change without payload check.
+		 * @tparam T Payload types.
+		 * @param tag State tag.
+		 * @param values Payload.
+		 */
+		template <typename... T>
+		void State(const BinaryTag& tag, const T&... values) noexcept {
+			put_tag(tag);
+			(put(values), ...);
+		}
+
+		/**
+		 * @brief Record a numeric base manipulator (std::dec, std::hex, std::oct).
+		 * @param manip Base manipulator; others are ignored.
+		 */
+		void Base(std::ios_base& (*manip)(std::ios_base&)) noexcept;
+
+		private:
+			/**
+			 * @brief Append the raw bytes of @p value.
+			 * @tparam T Trivially copyable type.
+			 * @param value Value.
+			 */
+			template <typename T>
+			void put(const T& value) noexcept {
+				try {
+					record.append(reinterpret_cast<const char*>(&value), sizeof(T));
+				} catch (...) {}
+			}
+
+			/**
+			 * @brief Append a tag; a Level tag followed by anything else can no longer be folded.
+			 * @param tag Tag.
+			 */
+			void put_tag(const BinaryTag& tag) noexcept {
+				level_tag = std::string::npos;
+				put(tag);
+			}
+
+			/**
+			 * @brief Record text as it is.
+			 * @param text Text.
+			 */
+			void put_text(std::string_view text) noexcept;
+
+			/**
+			 * @brief Append `u32 size` and the bytes of @p text.
+			 * @param text Text.
+			 */
+			void put_bytes(std::string_view text) noexcept;
+
+			/**
+			 * @brief Append the calling thread's kernel thread id and name.
+			 */
+			void put_thread_name() noexcept;
+
+			/**
+			 * @brief Record the header instant unless this line already has one.
+			 */
+			void open_header() noexcept;
+	};
+
+	/**
+	 * @class BinaryWriter
+	 * @brief Shared state behind BinaryLog (private).
+	 *
+	 * Each thread records into its own BinaryStage; a finished line is appended to the
+	 * output as one chunk under the writer mutex. Unterminated records are written when
+	 * the last owner goes away.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE BinaryWriter final {
+		public:
+			/**
+			 * @brief Construct the writer and write the file header.
+			 * @param out Output stream.
+			 * @param level Minimum Level that will be recorded.
+			 * @param format Header format stored for the decoder.
+			 */
+			BinaryWriter(std::ostream& out, const Level& level, const HeaderFormat& format);
+
+			BinaryWriter(const BinaryWriter&) = delete;
+			BinaryWriter(BinaryWriter&&) noexcept = delete;
+			BinaryWriter& operator=(const BinaryWriter&) = delete;
+			BinaryWriter& operator=(BinaryWriter&&) noexcept = delete;
+
+			/**
+			 * @brief Write every uncommitted record and flush.
+			 */
+			~BinaryWriter() noexcept;
+
+			/**
+			 * @brief Id of the stage registry, for Log::StageFilter().
+			 * @return The id.
+			 */
+			std::uint64_t Registry() const noexcept {
+				return m_stages.Id();
+			}
+
+			/**
+			 * @brief Get the calling thread's stage.
+			 * @return Reference to the stage.
+			 */
+			BinaryStage& Local() {
+				return m_stages.Local();
+			}
+
+			/**
+			 * @brief Write the stage's record as a chunk if a line ended.
+			 *
+			 * Records holding only state changes are also written once they grow past a few
+			 * KiB, so a thread logging only filtered levels does not accumulate them.
+			 * @param stage Calling thread's stage.
+			 * @param line_end Whether the last operation ended a line.
+			 */
+			void Commit(BinaryStage& stage, bool line_end) noexcept {
+				if (line_end || (!stage.header_open && stage.record.size() >= state_commit_size))
+					Emit(stage);
+			}
+
+			/**
+			 * @brief Flush the output stream under the writer mutex.
+			 */
+			void Flush() noexcept;
+
+			/**
+			 * @brief Add the counters of every stage and of the chunk writes to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			void Collect(LogStats& stats);
+
+		private:
+			static constexpr std::size_t state_commit_size = 4096;	///< Threshold for state-only records
+
+			std::ostream& m_out;						///< Output stream
+			std::mutex m_mutex;							///< Serializes chunks
+			WriteCounters m_writes;						///< Chunk writes, under m_mutex
+			std::atomic<std::uint32_t> m_slots;			///< Next slot
+			StageRegistry<BinaryStage> m_stages;		///< Producer stages
+			LevelCounters m_exited;						///< Counters of stages whose thread exited, under the registry mutex
+
+			/**
+			 * @brief Write the stage's record as one chunk, then clear it.
+			 * @param stage Stage.
+			 */
+			void Emit(BinaryStage& stage) noexcept;
+	};
+}
@@ -0,0 +1,91 @@
+#include <StormByte/logger/async_writer.hxx>
+#include <StormByte/logger/crash_registry.hxx>
+#include <StormByte/logger/sink.hxx>
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+using namespace StormByte::Logger;
+
+namespace {
+	constexpr std::size_t max_entries = 64;
+
+	template <typename T>
+	class Table {
+		public:
+			void Add(T& entry) noexcept {
+				for (auto& slot : m_slots) {
+					T* expected = nullptr;
+					if (slot.compare_exchange_strong(expected, &entry, std::memory_order_release, std::memory_order_relaxed))
+						return;
+				}
+			}
+
+			void Remove(T& entry) noexcept {
+				for (auto& slot : m_slots) {
+					T* expected = &entry;
+					if (slot.compare_exchange_strong(expected, nullptr, std::memory_order_release, std::memory_order_relaxed))
+						return;
+				}
+			}
+
+			template <typename F>
+			void ForEach(F&& fn) noexcept {
+				for (auto& slot : m_slots) {
+					if (T* entry = slot.load(std::memory_order_acquire))
+						fn(*entry);
+				}
+			}
+
+		private:
+			std::atomic<T*> m_slots[max_entries] = {};
+	};
+
+	Table<Sink> sinks;
+	Table<AsyncWriter> writers;
+	std::atomic<bool> crashing{ false };
+	std::string crash_record;		// Receives queued records in the handler; swapping never allocates
+}
+
+void CrashRegistry::Add(Sink& sink) noexcept {
+	sinks.Add(sink);
+}
+
+void CrashRegistry::Remove(Sink& sink) noexcept {
+	sinks.Remove(sink);
+}
+
+void CrashRegistry::Add(AsyncWriter& writer) noexcept {
+	writers.Add(writer);
+}
+
+void CrashRegistry::Remove(AsyncWriter& writer) noexcept {
+	writers.Remove(writer);
+}
+
+void CrashRegistry::Drain(std::string_view record) noexcept {
+	crashing.store(true, std::memory_order_relaxed);
+	sinks.ForEach([record](Sink& sink) {
+		bool complete = sink.CrashDrain();
+		writers.ForEach([&](AsyncWriter& writer) {
+			if (&writer.Stream() != &sink.Stream())
+				return;
+			while (writer.CrashPop(crash_record)) {
+				if (crash_record.empty())
+					continue;
+				if (!complete)
+					sink.CrashWrite("\n", 1);
+				sink.CrashWrite(crash_record.data(), crash_record.size());
+				complete = crash_record.back() == '\n';
+			}
+		});
+		if (!complete)
+			sink.CrashWrite("\n", 1);
+		sink.CrashWrite(record.data(), record.size());
+	});
+}
+
+bool CrashRegistry::Crashing() noexcept {
+	return crashing.load(std::memory_order_relaxed);
+}
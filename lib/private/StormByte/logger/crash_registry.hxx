@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <string_view>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	class AsyncWriter;
+	class Sink;
+
+	/**
+	 * @class CrashRegistry
+	 * @brief Live sinks and asynchronous queues a fatal signal handler drains (private).
+	 *
+	 * Entries live in fixed tables of atomic pointers, so registering is a compare-exchange
+	 * and the handler walks them without locks or allocation. Objects beyond a table's
+	 * capacity are simply not drained.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE CrashRegistry final {
+		public:
+			CrashRegistry() = delete;
+
+			/**
+			 * @brief Register a constructed sink.
+			 * @param sink Sink; remove it before it is destroyed.
+			 */
+			static void Add(Sink& sink) noexcept;
+
+			/**
+			 * @brief Unregister a sink.
+			 * @param sink Sink.
+			 */
+			static void Remove(Sink& sink) noexcept;
+
+			/**
+			 * @brief Register an asynchronous writer.
+			 * @param writer Writer; remove it before it is destroyed.
+			 */
+			static void Add(AsyncWriter& writer) noexcept;
+
+			/**
+			 * @brief Unregister an asynchronous writer.
+			 * @param writer Writer.
+			 */
+			static void Remove(AsyncWriter& writer) noexcept;
+
+			/**
+			 * @brief Write everything pending to every registered sink, then @p record.
+			 *
+			 * Each sink first writes its own buffer, then the records still queued by writers
+			 * whose stream is that sink's, then @p record on a line of its own. Only
+			 * async-signal-safe operations are used.
+			 * @param record Final record, ending with a newline.
+			 */
+			static void Drain(std::string_view record) noexcept;
+
+			/**
+			 * @brief Whether Drain() has started: writer threads stop taking records from their queue.
+			 * @return true once a fatal signal is being handled.
+			 */
+			static bool Crashing() noexcept;
+	};
+}
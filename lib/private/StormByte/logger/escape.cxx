@@ -0,0 +1,118 @@
+#include <StormByte/logger/escape.hxx>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+using namespace StormByte::Logger;
+
+namespace {
+	constexpr bool json_special(unsigned char c) noexcept {
+		return c < 0x20 || c == '"' || c == '\\';
+	}
+
+	constexpr bool logfmt_special(unsigned char c) noexcept {
+		return json_special(c) || c == ' ' || c == '=';
+	}
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+	// Index of the lowest set bit of a non-zero mask.
+	std::size_t first_bit(unsigned mask) noexcept {
+#if defined(_MSC_VER)
+		unsigned long bit;
+		_BitScanForward(&bit, mask);
+		return bit;
+#else
+		return static_cast<std::size_t>(__builtin_ctz(mask));
+#endif
+	}
+#endif
+
+	template <bool Logfmt>
+	std::size_t find_special(std::string_view text) noexcept {
+		const char* const data = text.data();
+		const std::size_t size = text.size();
+		std::size_t i = 0;
+
+#if defined(__AVX2__)
+		const __m256i quote = _mm256_set1_epi8('"');
+		const __m256i backslash = _mm256_set1_epi8('\\');
+		const __m256i control = _mm256_set1_epi8(0x1F);
+		const __m256i space = _mm256_set1_epi8(' ');
+		const __m256i equals = _mm256_set1_epi8('=');
+		for (; i + 32 <= size; i += 32) {
+			const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+			// Unsigned c <= 0x1F  <=>  max(c, 0x1F) == 0x1F
+			__m256i hits = _mm256_or_si256(
+				_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, backslash)),
+				_mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control), control));
+			if constexpr (Logfmt)
+				hits = _mm256_or_si256(hits, _mm256_or_si256(_mm256_cmpeq_epi8(chunk, space), _mm256_cmpeq_epi8(chunk, equals)));
+			const auto mask = static_cast<unsigned>(_mm256_movemask_epi8(hits));
+			if (mask)
+				return i + first_bit(mask);
+		}
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+		const __m128i quote16 = _mm_set1_epi8('"');
+		const __m128i backslash16 = _mm_set1_epi8('\\');
+		const __m128i control16 = _mm_set1_epi8(0x1F);
+		const __m128i space16 = _mm_set1_epi8(' ');
+		const __m128i equals16 = _mm_set1_epi8('=');
+		for (; i + 16 <= size; i += 16) {
+			const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+			__m128i hits = _mm_or_si128(
+				_mm_or_si128(_mm_cmpeq_epi8(chunk, quote16), _mm_cmpeq_epi8(chunk, backslash16)),
+				_mm_cmpeq_epi8(_mm_max_epu8(chunk, control16), control16));
+			if constexpr (Logfmt)
+				hits = _mm_or_si128(hits, _mm_or_si128(_mm_cmpeq_epi8(chunk, space16), _mm_cmpeq_epi8(chunk, equals16)));
+			const auto mask = static_cast<unsigned>(_mm_movemask_epi8(hits));
+			if (mask)
+				return i + first_bit(mask);
+		}
+#endif
+		for (; i < size; ++i) {
+			const auto c = static_cast<unsigned char>(data[i]);
+			if (Logfmt ? logfmt_special(c) : json_special(c))
+				return i;
+		}
+		return size;
+	}
+}
+
+std::size_t Escape::FindJson(std::string_view text) noexcept {
+	return find_special<false>(text);
+}
+
+std::size_t Escape::FindLogfmt(std::string_view text) noexcept {
+	return find_special<true>(text);
+}
+
+void Escape::Write(std::ostream& out, std::string_view text) noexcept {
+	static constexpr char hex[] = "0123456789abcdef";
+	try {
+		while (!text.empty()) {
+			const std::size_t clean = FindJson(text);
+			out.write(text.data(), static_cast<std::streamsize>(clean));
+			if (clean == text.size())
+				return;
+
+			const auto c = static_cast<unsigned char>(text[clean]);
+			switch (c) {
+				case '"':	out.write("\\\"", 2); break;
+				case '\\':	out.write("\\\\", 2); break;
+				case '\n':	out.write("\\n", 2); break;
+				case '\r':	out.write("\\r", 2); break;
+				case '\t':	out.write("\\t", 2); break;
+				case '\b':	out.write("\\b", 2); break;
+				case '\f':	out.write("\\f", 2); break;
+				default: {
+					const char unicode[] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xF] };
+					out.write(unicode, sizeof(unicode));
+					break;
+				}
+			}
+			text.remove_prefix(clean + 1);
+		}
+	} catch (...) {}
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct Escape
+	 * @brief String escaping for structured encodings (private).
+	 *
+	 * The scans test 32 (AVX2) or 16 (SSE2) bytes per step for the characters that need
+	 * attention, so clean runs are copied in one write; other targets scan byte by byte.
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE Escape {
+		/**
+		 * @brief Offset of the first byte that must be escaped in a JSON string: `"`, `\`, or below 0x20.
+		 * @param text Text to scan.
+		 * @return Offset, or text.size() if there is none.
+		 */
+		static std::size_t FindJson(std::string_view text) noexcept;
+
+		/**
+		 * @brief Offset of the first byte that forces quoting of a logfmt value: those of
+		 *        FindJson(), space or `=`.
+		 * @param text Text to scan.
+		 * @return Offset, or text.size() if there is none.
+		 */
+		static std::size_t FindLogfmt(std::string_view text) noexcept;
+
+		/**
+		 * @brief Write @p text escaped as the body of a JSON (or quoted logfmt) string.
+		 * @param out Stream to write to.
+		 * @param text Text to escape.
+		 */
+		static void Write(std::ostream& out, std::string_view text) noexcept;
+	};
+}
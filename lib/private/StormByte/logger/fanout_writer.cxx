@@ -0,0 +1,122 @@
+#include <StormByte/logger/fanout_writer.hxx>
+
+using namespace StormByte::Logger;
+
+namespace {
+	bool same_format(const HeaderFormat& a, const HeaderFormat& b) noexcept {
+		return a.LineEncoding() == b.LineEncoding() && a.Tokens() == b.Tokens() && a.Literals() == b.Literals();
+	}
+}
+
+FanoutStage::FanoutStage(const Level& level, const HeaderFormat& format):
+	buffer(), stream(&buffer), impl(stream, level, format), thread(), marks() {
+	impl.Listen(this);
+}
+
+void FanoutStage::OnHeader(const Level& level, const Instant& now) noexcept {
+	// Called on the owning thread, which may have been renamed since the last header.
+	if (thread.Stale()) [[unlikely]]
+		thread.Refresh();
+	try {
+		marks.push_back(Mark{ buffer.Data().size(), level, now });
+	} catch (...) {}
+}
+
+FanoutWriter::FanoutWriter(const std::vector<Route>& routes, const HeaderFormat& format):
+	m_destinations(), m_renderings(), m_mutex(), m_writes(), m_stages(LowestLevel(routes), format), m_exited() {
+	for (const Route& route : routes) {
+		if (!route.out)
+			continue;
+		HeaderFormat header = route.format ? *route.format : format;
+		if (header.LineEncoding() != format.LineEncoding())
+			header = HeaderFormat(header.Pattern(), format.LineEncoding());
+		std::size_t index = 0;
+		while (index < m_renderings.size() && !same_format(m_renderings[index]->format, header))
+			++index;
+		if (index == m_renderings.size())
+			m_renderings.push_back(std::make_unique<Rendering>(header));
+		m_destinations.push_back(Destination{ route.out, route.level, index });
+	}
+	// An exiting producer delivers what it left unterminated, like the destructor does.
+	m_stages.OnRetire([this](FanoutStage& stage) {
+		if (stage.Finish())
+			Emit(stage);
+		m_exited.Absorb(stage.impl.Counters());
+	});
+}
+
+FanoutWriter::~FanoutWriter() noexcept {
+	m_stages.Close();
+	try {
+		m_stages.ForEach([this](FanoutStage& stage) {
+			if (stage.Finish())
+				Emit(stage);
+		});
+	} catch (...) {}
+	Flush();
+}
+
+Level FanoutWriter::LowestLevel(const std::vector<Route>& routes) noexcept {
+	Level lowest = Level::Fatal;
+	for (const Route& route : routes) {
+		if (route.out && route.level < lowest)
+			lowest = route.level;
+	}
+	return lowest;
+}
+
+void FanoutWriter::Flush() noexcept {
+	try {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (const Destination& destination : m_destinations)
+			destination.out->flush();
+	} catch (...) {}
+}
+
+void FanoutWriter::Collect(LogStats& stats) {
+	m_stages.ForEach([&stats](FanoutStage& stage) {
+		stage.impl.Counters().Collect(stats);
+	}, [this, &stats] {
+		m_exited.Collect(stats);
+	});
+	m_writes.Collect(stats);
+}
+
+void FanoutWriter::Emit(FanoutStage& stage) noexcept {
+	// A line carries the level of its header; text without one (a bare std::endl) the current level.
+	const Level level = stage.marks.empty() ? stage.impl.CurrentLevel() : stage.marks.front().level;
+	try {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (auto& rendering : m_renderings)
+			rendering->ready = false;
+		for (const Destination& destination : m_destinations) {
+			if (level < destination.level)
+				continue;
+			Rendering& rendering = *m_renderings[destination.format];
+			if (!rendering.ready) {
+				Render(stage, rendering);
+				rendering.ready = true;
+			}
+			const std::string& line = rendering.buffer.Data();
+			const std::uint64_t started = m_writes.Begin(line.size());
+			destination.out->write(line.data(), static_cast<std::streamsize>(line.size()));
+			m_writes.End(started);
+		}
+	} catch (...) {}
+	stage.buffer.Data().clear();
+	stage.marks.clear();
+}
+
+void FanoutWriter::Render(FanoutStage& stage, Rendering& rendering) noexcept {
+	const std::string& text = stage.buffer.Data();
+	rendering.buffer.Data().clear();
+	std::size_t offset = 0;
+	try {
+		for (const FanoutStage::Mark& mark : stage.marks) {
+			rendering.stream.write(text.data() + offset, static_cast<std::streamsize>(mark.offset - offset));
+			Implementation::RenderHeader(rendering.stream, rendering.format, mark.level, mark.now, stage.thread.Text());
+			offset = mark.offset;
+		}
+		rendering.stream.write(text.data() + offset, static_cast<std::streamsize>(text.size() - offset));
+	} catch (...) {}
+}
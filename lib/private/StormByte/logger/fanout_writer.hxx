@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/fanout_log.hxx>
+#include <StormByte/logger/line_stage.hxx>
+#include <StormByte/logger/log_counters.hxx>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct FanoutStage
+	 * @brief Per-thread line assembly area of FanoutLog (private).
+	 *
+	 * The Implementation writes only message text into the buffer; headers are recorded as
+	 * marks (position, level, instant) and rendered per destination format on commit.
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE FanoutStage final: public HeaderListener {
+		/**
+		 * @struct Mark
+		 * @brief Where a header goes in the staged text.
+		 */
+		struct Mark {
+			std::size_t offset;							///< Position in the staged text
+			Level level;								///< Level of the line
+			Instant now;								///< Instant of the header
+		};
+
+		LineBuffer buffer;								///< Staged message text
+		std::ostream stream;							///< Stream over buffer
+		Implementation impl;							///< Formatter writing into stream
+		ThreadLabel thread;								///< Identity of the owner, refreshed per header
+		std::vector<Mark> marks;						///< Headers of the staged text
+
+		/**
+		 * @brief Construct a stage owned by the calling thread.
+		 * @param level Lowest level of any destination.
+		 * @param format Logger header format; its encoding shapes the message text.
+		 */
+		FanoutStage(const Level& level, const HeaderFormat& format);
+
+		/**
+		 * @brief Record a header at the current end of the staged text.
+		 * @param level Level of the line.
+		 * @param now Instant of the header.
+		 */
+		void OnHeader(const Level& level, const Instant& now) noexcept override;
+
+		/**
+		 * @brief Whether the staged text ends a line and is ready to commit.
+		 * @return true if the buffer is non-empty and ends with a newline.
+		 */
+		bool Complete() noexcept {
+			const std::string& data = buffer.Data();
+			return !data.empty() && data.back() == '\n';
+		}
+
+		/**
+		 * @brief End unterminated staged text with a newline, so it cannot run into another line.
+		 * @return true if there is text to commit.
+		 */
+		bool Finish() {
+			std::string& data = buffer.Data();
+			if (data.empty())
+				return false;
+			if (data.back() != '\n')
+				data.push_back('\n');
+			return true;
+		}
+	};
+
+	/**
+	 * @class FanoutWriter
+	 * @brief Shared state behind FanoutLog (private).
+	 *
+	 * Lines are formatted once per thread; on commit the header is rendered once per
+	 * distinct format among the routes accepting the line's level, and every accepting
+	 * route receives the finished line with a single write, under the writer mutex.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE FanoutWriter final {
+		public:
+			/**
+			 * @brief Construct the writer.
+			 * @param routes Destinations.
+			 * @param format Header format of routes without their own. Its line encoding
+			 * applies to every route, since the message text is formatted only once.
+			 */
+			FanoutWriter(const std::vector<Route>& routes, const HeaderFormat& format);
+
+			FanoutWriter(const FanoutWriter&) = delete;
+			FanoutWriter(FanoutWriter&&) noexcept = delete;
+			FanoutWriter& operator=(const FanoutWriter&) = delete;
+			FanoutWriter& operator=(FanoutWriter&&) noexcept = delete;
+
+			/**
+			 * @brief Write out every unterminated staged line, ended with a newline.
+			 */
+			~FanoutWriter() noexcept;
+
+			/**
+			 * @brief Lowest level accepted by any route.
+			 * @param routes Destinations.
+			 * @return The level (Level::Fatal when there are none).
+			 */
+			static Level LowestLevel(const std::vector<Route>& routes) noexcept;
+
+			/**
+			 * @brief Id of the stage registry, for Log::StageFilter().
+			 * @return The id.
+			 */
+			std::uint64_t Registry() const noexcept {
+				return m_stages.Id();
+			}
+
+			/**
+			 * @brief Get the calling thread's stage.
+			 * @return Reference to the stage.
+			 */
+			FanoutStage& Local() {
+				return m_stages.Local();
+			}
+
+			/**
+			 * @brief Deliver the stage's text if it ends a line.
+			 * @param stage Calling thread's stage.
+			 */
+			void Commit(FanoutStage& stage) noexcept {
+				if (stage.Complete())
+					Emit(stage);
+			}
+
+			/**
+			 * @brief Flush every route's stream under the writer mutex.
+			 */
+			void Flush() noexcept;
+
+			/**
+			 * @brief Add the counters of every stage and of the deliveries to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			void Collect(LogStats& stats);
+
+		private:
+			/**
+			 * @struct Destination
+			 * @brief A route with its format resolved to an index into m_renderings.
+			 */
+			struct Destination {
+				std::ostream* out;						///< Destination stream
+				Level level;							///< Minimum level
+				std::size_t format;						///< Index of its rendering
+			};
+
+			/**
+			 * @struct Rendering
+			 * @brief A distinct header format and the line rendered with it.
+			 */
+			struct Rendering {
+				HeaderFormat format;					///< Header format
+				LineBuffer buffer;						///< Rendered line
+				std::ostream stream;					///< Stream over buffer
+				bool ready;								///< Rendered for the current line
+
+				explicit Rendering(const HeaderFormat& header): format(header), buffer(), stream(&buffer), ready(false) {}
+			};
+
+			std::vector<Destination> m_destinations;	///< Routes
+			std::vector<std::unique_ptr<Rendering>> m_renderings;	///< One per distinct format
+			std::mutex m_mutex;							///< Serializes deliveries
+			WriteCounters m_writes;						///< Writes to every route, under m_mutex
+			StageRegistry<FanoutStage> m_stages;		///< Producer stages
+			LevelCounters m_exited;						///< Counters of stages whose thread exited, under the registry mutex
+
+			/**
+			 * @brief Deliver the stage's text to every accepting route, then clear it.
+			 * @param stage Stage.
+			 */
+			void Emit(FanoutStage& stage) noexcept;
+
+			/**
+			 * @brief Render the stage's text with @p rendering's header format.
+			 * @param stage Stage.
+			 * @param rendering Target rendering.
+			 */
+			static void Render(FanoutStage& stage, Rendering& rendering) noexcept;
+	};
+}
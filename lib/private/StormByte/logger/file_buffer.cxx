@@ -0,0 +1,188 @@
+#include <StormByte/logger/file_buffer.hxx>
+#include <StormByte/platform.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#ifdef WINDOWS
+	#include <fcntl.h>
+	#include <io.h>
+	#include <sys/stat.h>
+#else
+	#include <fcntl.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+#endif
+
+using namespace StormByte::Logger;
+
+namespace {
+	constexpr std::size_t buffer_alignment = 4096;
+	constexpr std::size_t min_buffer_size = 4096;
+	constexpr std::size_t max_buffer_size = std::size_t{1} << 30;	// pbump() takes an int
+
+	// Write @p size bytes; returns false on error. Only async-signal-safe calls on POSIX.
+	bool write_all(int fd, const char* data, std::size_t size) noexcept {
+		while (size > 0) {
+#ifdef WINDOWS
+			const int written = ::_write(fd, data, static_cast<unsigned int>(std::min<std::size_t>(size, 1u << 30)));
+#else
+			const ssize_t written = ::write(fd, data, size);
+			if (written < 0 && errno == EINTR)
+				continue;
+#endif
+			if (written < 0)
+				return false;
+			data += written;
+			size -= static_cast<std::size_t>(written);
+		}
+		return true;
+	}
+}
+
+FileBuffer::FileBuffer(int fd, bool owns_fd, std::size_t buffer_size, std::size_t flush_threshold, const FlushPolicy& policy):
+	m_fd(fd),
+	m_owns_fd(owns_fd),
+	m_buffer(nullptr),
+	m_size(std::clamp(buffer_size, min_buffer_size, max_buffer_size)),
+	m_threshold(std::min(flush_threshold, m_size)),
+	m_policy(policy),
+	m_dropped(0),
+	m_written(0),
+	m_last_newline(true) {
+	m_buffer = static_cast<char*>(::operator new(m_size, std::align_val_t{ buffer_alignment }));
+	setp(m_buffer, m_buffer + m_size);
+}
+
+FileBuffer::~FileBuffer() noexcept {
+	Drain();
+	if (m_owns_fd)
+		Close(m_fd);
+	::operator delete(m_buffer, std::align_val_t{ buffer_alignment });
+}
+
+int FileBuffer::OpenAppend(const std::filesystem::path& path, bool truncate) noexcept {
+#ifdef WINDOWS
+	return ::_wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | (truncate ? _O_TRUNC : 0), _S_IREAD | _S_IWRITE);
+#else
+	return ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+#endif
+}
+
+void FileBuffer::Close(int fd) noexcept {
+	if (fd < 0)
+		return;
+#ifdef WINDOWS
+	::_close(fd);
+#else
+	::close(fd);
+#endif
+}
+
+void FileBuffer::Drain() noexcept {
+	emit(nullptr, 0);
+}
+
+bool FileBuffer::CrashDrain() noexcept {
+	const auto buffered = static_cast<std::size_t>(pptr() - pbase());
+	if (m_fd >= 0 && buffered > 0)
+		write_all(m_fd, pbase(), buffered);
+	return AtRecordBoundary();
+}
+
+void FileBuffer::CrashWrite(const char* data, std::size_t size) noexcept {
+	if (m_fd >= 0)
+		write_all(m_fd, data, size);
+}
+
+FileBuffer::int_type FileBuffer::overflow(int_type ch) {
+	emit(nullptr, 0);
+	if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(ch);
+		pbump(1);
+	}
+	return traits_type::not_eof(ch);
+}
+
+std::streamsize FileBuffer::xsputn(const char* s, std::streamsize count) {
+	const auto size = static_cast<std::size_t>(count);
+	auto buffered = static_cast<std::size_t>(pptr() - pbase());
+
+	// Past the threshold and at a record boundary: write out the complete records first.
+	if (m_threshold > 0 && buffered >= m_threshold && pptr()[-1] == '\n') {
+		emit(nullptr, 0);
+		buffered = 0;
+	}
+
+	if (size <= m_size - buffered) [[likely]] {
+		std::memcpy(pptr(), s, size);
+		pbump(static_cast<int>(size));
+	} else {
+		emit(s, size);
+	}
+	return count;
+}
+
+int FileBuffer::Replace(int fd) noexcept {
+	emit(nullptr, 0);
+	const int previous = m_fd;
+	m_fd = fd;
+	m_written = 0;
+	return previous;
+}
+
+int FileBuffer::sync() {
+	const auto buffered = static_cast<std::size_t>(pptr() - pbase());
+	if (m_policy == FlushPolicy::Immediate || (m_threshold > 0 && buffered >= m_threshold))
+		emit(nullptr, 0);
+	return 0;
+}
+
+void FileBuffer::emit(const char* extra, std::size_t extra_size) noexcept {
+	const auto buffered = static_cast<std::size_t>(pptr() - pbase());
+	setp(m_buffer, m_buffer + m_size);
+	if (buffered + extra_size == 0)
+		return;
+	m_written += buffered + extra_size;
+	m_last_newline = extra_size > 0 ? extra[extra_size - 1] == '\n' : m_buffer[buffered - 1] == '\n';
+	if (m_fd < 0) {
+		m_dropped += buffered + extra_size;
+		return;
+	}
+
+#ifdef WINDOWS
+	if (!write_all(m_fd, m_buffer, buffered))
+		m_dropped += buffered;
+	if (extra_size > 0 && !write_all(m_fd, extra, extra_size))
+		m_dropped += extra_size;
+#else
+	iovec parts[2] = {
+		{ m_buffer, buffered },
+		{ const_cast<char*>(extra), extra_size }
+	};
+	iovec* part = buffered > 0 ? parts : parts + 1;
+	int remaining_parts = (buffered > 0) + (extra_size > 0);
+	while (remaining_parts > 0) {
+		const ssize_t written = ::writev(m_fd, part, remaining_parts);
+		if (written < 0) {
+			if (errno == EINTR)
+				continue;
+			for (int i = 0; i < remaining_parts; ++i)
+				m_dropped += part[i].iov_len;
+			break;
+		}
+		auto left = static_cast<std::size_t>(written);
+		while (remaining_parts > 0 && left >= part->iov_len) {
+			left -= part->iov_len;
+			++part;
+			--remaining_parts;
+		}
+		if (remaining_parts > 0) {
+			part->iov_base = static_cast<char*>(part->iov_base) + left;
+			part->iov_len -= left;
+		}
+	}
+#endif
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/typedefs.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <streambuf>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class FileBuffer
+	 * @brief Stream buffer writing to a file descriptor in large batches (private).
+	 *
+	 * Characters are accumulated in one page-aligned buffer that the stream fills through
+	 * its put area, so single characters never cost a virtual call. The buffer is written
+	 * out with one write() when it fills, once the flush threshold is reached at a record
+	 * boundary, or on a stream flush under FlushPolicy::Immediate. Text that does not fit
+	 * is written together with the buffered bytes in a single writev().
+	 *
+	 * Write errors never put the owning stream in a failed state: the data is dropped and
+	 * counted, so logging keeps working once the descriptor recovers.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE FileBuffer: public std::streambuf {
+		public:
+			/**
+			 * @brief Construct the buffer.
+			 * @param fd Descriptor to write to (may be -1: everything is discarded).
+			 * @param owns_fd Close @p fd on destruction.
+			 * @param buffer_size Buffer capacity in bytes (minimum 4 KiB).
+			 * @param flush_threshold Buffered bytes that trigger a write at the next record boundary; 0 = only when full.
+			 * @param policy Effect of stream flushes.
+			 */
+			FileBuffer(int fd, bool owns_fd, std::size_t buffer_size, std::size_t flush_threshold, const FlushPolicy& policy);
+
+			FileBuffer(const FileBuffer&) = delete;
+			FileBuffer(FileBuffer&&) noexcept = delete;
+			FileBuffer& operator=(const FileBuffer&) = delete;
+			FileBuffer& operator=(FileBuffer&&) noexcept = delete;
+
+			/**
+			 * @brief Write out buffered data and close the descriptor if owned.
+			 */
+			~FileBuffer() noexcept override;
+
+			/**
+			 * @brief Write out everything buffered, regardless of policy.
+			 */
+			void Drain() noexcept;
+
+			/**
+			 * @brief Write the buffered bytes with plain write() calls from a fatal signal handler.
+			 *
+			 * The put area is left untouched, since the thread that crashed may be using it.
+			 * @return true if the output now ends with a complete record.
+			 */
+			bool CrashDrain() noexcept;
+
+			/**
+			 * @brief Write @p size bytes straight to the descriptor from a fatal signal handler.
+			 * @param data Bytes to write.
+			 * @param size Number of bytes.
+			 */
+			void CrashWrite(const char* data, std::size_t size) noexcept;
+
+			/**
+			 * @brief Open @p path for appending, created with mode 0644 if missing.
+			 * @param path File to open.
+			 * @param truncate Discard any existing content.
+			 * @return The descriptor, or -1 on error.
+			 */
+			static int OpenAppend(const std::filesystem::path& path, bool truncate = false) noexcept;
+
+			/**
+			 * @brief Close a descriptor.
+			 * @param fd Descriptor (ignored if negative).
+			 */
+			static void Close(int fd) noexcept;
+
+			/**
+			 * @brief Descriptor written to.
+			 * @return The descriptor, or -1.
+			 */
+			int Descriptor() const noexcept {
+				return m_fd;
+			}
+
+			/**
+			 * @brief Bytes dropped because a write failed.
+			 * @return Dropped byte count.
+			 */
+			std::uint64_t DroppedBytes() const noexcept {
+				return m_dropped;
+			}
+
+		protected:
+			int_type overflow(int_type ch) override;
+			std::streamsize xsputn(const char* s, std::streamsize count) override;
+			int sync() override;
+
+			/**
+			 * @brief Whether everything handed to the buffer so far ends with a complete record.
+			 * @return true at a record boundary.
+			 */
+			bool AtRecordBoundary() const noexcept {
+				return pptr() != pbase() ? pptr()[-1] == '\n' : m_last_newline;
+			}
+
+			/**
+			 * @brief Bytes written to (or dropped for) the current descriptor plus those still buffered.
+			 * @return Size of the current output in bytes.
+			 */
+			std::uint64_t OutputSize() const noexcept {
+				return m_written + static_cast<std::uint64_t>(pptr() - pbase());
+			}
+
+			/**
+			 * @brief Write out the buffer and continue on another descriptor.
+			 * @param fd New descriptor (owned like the previous one).
+			 * @return The previous descriptor, which the caller now owns.
+			 */
+			int Replace(int fd) noexcept;
+
+		private:
+			int m_fd;									///< Target descriptor
+			const bool m_owns_fd;						///< Close m_fd on destruction
+			char* m_buffer;								///< Page-aligned storage
+			const std::size_t m_size;					///< Capacity of m_buffer
+			const std::size_t m_threshold;				///< Write at a record boundary once this many bytes are buffered
+			const FlushPolicy m_policy;					///< Effect of sync()
+			std::uint64_t m_dropped;					///< Bytes lost to write errors
+			std::uint64_t m_written;					///< Bytes emitted to m_fd
+			bool m_last_newline;						///< Last emitted byte ended a record
+
+			/**
+			 * @brief Write the buffered bytes followed by @p extra, then empty the buffer.
+			 * @param extra Additional bytes (may be null).
+			 * @param extra_size Size of @p extra.
+			 */
+			void emit(const char* extra, std::size_t extra_size) noexcept;
+	};
+}
@@ -0,0 +1,275 @@
+#include <StormByte/logger/flight_ring.hxx>
+#include <StormByte/logger/implementation.hxx>
+#include <StormByte/logger/line_stage.hxx>
+#include <StormByte/logger/tick_clock.hxx>
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+using namespace StormByte::Logger;
+
+namespace {
+	constexpr std::size_t size_field = sizeof(std::uint32_t);
+
+	// Reads a captured record front to back; every read is bounds checked.
+	class Reader final {
+		public:
+			explicit Reader(std::string_view data) noexcept: m_data(data) {}
+
+			bool Done() const noexcept {
+				return m_data.empty();
+			}
+
+			template <typename T>
+			bool Get(T& value) noexcept {
+				if (m_data.size() < sizeof(T))
+					return false;
+				std::memcpy(&value, m_data.data(), sizeof(T));
+				m_data.remove_prefix(sizeof(T));
+				return true;
+			}
+
+			bool Bytes(std::size_t size, std::string_view& bytes) noexcept {
+				if (m_data.size() < size)
+					return false;
+				bytes = m_data.substr(0, size);
+				m_data.remove_prefix(size);
+				return true;
+			}
+
+		private:
+			std::string_view m_data;
+	};
+
+	template <typename T>
+	bool value(Reader& reader, Implementation& impl) noexcept {
+		T v;
+		if (!reader.Get(v))
+			return false;
+		impl << v;
+		return true;
+	}
+
+	bool text(Reader& reader, std::string_view& bytes, std::size_t unit) noexcept {
+		std::uint32_t length;
+		return reader.Get(length) && reader.Bytes(static_cast<std::size_t>(length) * unit, bytes);
+	}
+
+	// Render one captured record; stops at the first malformed tag.
+	void render(Implementation& impl, const FlightRing::Captured& record) noexcept {
+		Reader reader(record.data);
+		std::uint8_t level;
+		std::uint64_t stamp;
+		FlightStyle style;
+		if (!reader.Get(level) || level > static_cast<std::uint8_t>(Level::Fatal) || !reader.Get(stamp) || !reader.Get(style))
+			return;
+
+		impl.Replay(record.now, record.thread.Text());
+		impl << static_cast<Level>(level);
+		impl.SetStyle(style);
+		try {
+			while (!reader.Done()) {
+				std::uint8_t tag;
+				std::string_view bytes;
+				if (!reader.Get(tag))
+					break;
+				bool ok = true;
+				switch (static_cast<FlightTag>(tag)) {
+					case FlightTag::Style:
+						if ((ok = reader.Get(style)))
+							impl.SetStyle(style);
+						break;
+					case FlightTag::Key:
+						if ((ok = text(reader, bytes, 1)))
+							impl.SetKey(bytes);
+						break;
+					case FlightTag::Text:
+						if ((ok = text(reader, bytes, 1)))
+							impl << std::string(bytes);
+						break;
+					case FlightTag::WideText:
+						if ((ok = text(reader, bytes, sizeof(wchar_t)))) {
+							std::wstring wide(bytes.size() / sizeof(wchar_t), L'\0');
+							std::memcpy(wide.data(), bytes.data(), bytes.size());
+							impl << wide;
+						}
+						break;
+					case FlightTag::Bool: {
+						std::uint8_t v;
+						if ((ok = reader.Get(v)))
+							impl << (v != 0);
+						break;
+					}
+					case FlightTag::Char:				ok = value<char>(reader, impl); break;
+					case FlightTag::SignedChar:			ok = value<signed char>(reader, impl); break;
+					case FlightTag::UnsignedChar:		ok = value<unsigned char>(reader, impl); break;
+					case FlightTag::WideChar:			ok = value<wchar_t>(reader, impl); break;
+					case FlightTag::Short:				ok = value<short>(reader, impl); break;
+					case FlightTag::UnsignedShort:		ok = value<unsigned short>(reader, impl); break;
+					case FlightTag::Int:				ok = value<int>(reader, impl); break;
+					case FlightTag::UnsignedInt:		ok = value<unsigned int>(reader, impl); break;
+					case FlightTag::Long:				ok = value<long>(reader, impl); break;
+					case FlightTag::UnsignedLong:		ok = value<unsigned long>(reader, impl); break;
+					case FlightTag::LongLong:			ok = value<long long>(reader, impl); break;
+					case FlightTag::UnsignedLongLong:	ok = value<unsigned long long>(reader, impl); break;
+					case FlightTag::Float:				ok = value<float>(reader, impl); break;
+					case FlightTag::Double:				ok = value<double>(reader, impl); break;
+					case FlightTag::LongDouble:			ok = value<long double>(reader, impl); break;
+					default:							ok = false; break;
+				}
+				if (!ok)
+					break;
+			}
+		} catch (...) {}
+		impl.EndRecord();
+	}
+
+	void sort_by_time(std::vector<FlightRing::Captured>& records) {
+		std::stable_sort(records.begin(), records.end(), [](const FlightRing::Captured& a, const FlightRing::Captured& b) {
+			return a.now.seconds != b.now.seconds ? a.now.seconds < b.now.seconds : a.now.nanoseconds < b.now.nanoseconds;
+		});
+	}
+
+	void keep_newest(std::vector<FlightRing::Captured>& records, std::size_t limit) {
+		if (records.size() > limit)
+			records.erase(records.begin(), records.end() - static_cast<std::ptrdiff_t>(limit));
+	}
+}
+
+FlightRing::FlightRing(std::size_t budget):
+	m_mutex(),
+	m_thread(),
+	m_data(std::max<std::size_t>(budget, size_field + 1)),
+	m_head(0),
+	m_used(0),
+	m_count(0),
+	m_record(),
+	m_size(0),
+	m_style() {
+}
+
+void FlightRing::Begin(const Level& level, const FlightStyle& style) {
+	m_size = 0;
+	m_style = style;
+	put(static_cast<std::uint8_t>(level));
+	put(TickClock::Capture());
+	put(style);
+}
+
+void FlightRing::End() noexcept {
+	const std::size_t size = m_size;
+	if (size == 0)
+		return;
+	m_size = 0;
+	const std::size_t capacity = m_data.size();
+	if (size_field + size > capacity)
+		return;
+
+	const auto field = static_cast<std::uint32_t>(size);
+	std::lock_guard<std::mutex> lock(m_mutex);
+	// A rename is picked up here, under the lock Take() reads the label with.
+	if (m_thread.Stale()) [[unlikely]]
+		m_thread.Refresh();
+	while (m_used + size_field + size > capacity)
+		evict();
+	const std::size_t tail = wrap(m_head + m_used);
+	copy_in(tail, reinterpret_cast<const char*>(&field), size_field);
+	copy_in(wrap(tail + size_field), m_record.data(), size);
+	m_used += size_field + size;
+	++m_count;
+}
+
+void FlightRing::grow(std::size_t size) {
+	m_record.resize(std::max(m_record.size() * 2, m_size + size + 256));
+}
+
+void FlightRing::Take(std::vector<Captured>& out, std::size_t limit) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	while (m_count > limit)
+		evict();
+	std::size_t offset = m_head;
+	for (; m_count > 0; --m_count) {
+		std::uint32_t size;
+		copy_out(offset, reinterpret_cast<char*>(&size), size_field);
+		offset = wrap(offset + size_field);
+		Captured& record = out.emplace_back(Captured{ Instant{}, m_thread, std::string(size, '\0') });
+		copy_out(offset, record.data.data(), size);
+		offset = wrap(offset + size);
+		std::uint64_t stamp;
+		std::memcpy(&stamp, record.data.data() + sizeof(std::uint8_t), sizeof(stamp));
+		record.now = TickClock::Convert(stamp);
+	}
+	m_head = 0;
+	m_used = 0;
+}
+
+void FlightRing::copy_in(std::size_t offset, const char* data, std::size_t size) noexcept {
+	const std::size_t first = std::min(size, m_data.size() - offset);
+	std::memcpy(m_data.data() + offset, data, first);
+	std::memcpy(m_data.data(), data + first, size - first);
+}
+
+void FlightRing::copy_out(std::size_t offset, char* data, std::size_t size) const noexcept {
+	const std::size_t first = std::min(size, m_data.size() - offset);
+	std::memcpy(data, m_data.data() + offset, first);
+	std::memcpy(data + first, m_data.data(), size - first);
+}
+
+void FlightRing::evict() noexcept {
+	std::uint32_t size;
+	copy_out(m_head, reinterpret_cast<char*>(&size), size_field);
+	m_head = wrap(m_head + size_field + size);
+	m_used -= size_field + size;
+	--m_count;
+}
+
+FlightRecorder::FlightRecorder(const FlightRecorderOptions& options):
+	m_options(options),
+	m_rings(std::make_unique<StageRegistry<FlightRing>>(options.budget)),
+	m_exited_mutex(),
+	m_exited() {
+	if (options.scope != FlightScope::All)
+		return;
+	m_rings->OnRetire([this](FlightRing& ring) {
+		std::lock_guard<std::mutex> lock(m_exited_mutex);
+		ring.Take(m_exited, m_options.records);
+		sort_by_time(m_exited);
+		keep_newest(m_exited, m_options.records);
+	});
+}
+
+FlightRecorder::~FlightRecorder() noexcept {
+	m_rings->Close();
+}
+
+FlightRing& FlightRecorder::Local() {
+	return m_rings->Local();
+}
+
+void FlightRecorder::Dump(std::ostream& out, const HeaderFormat& format) noexcept {
+	if (m_options.records == 0)
+		return;
+	try {
+		std::vector<FlightRing::Captured> records;
+		if (m_options.scope == FlightScope::Thread) {
+			Local().Take(records, m_options.records);
+		} else {
+			m_rings->ForEach([&](FlightRing& ring) {
+				ring.Take(records, m_options.records);
+			}, [&] {
+				std::lock_guard<std::mutex> lock(m_exited_mutex);
+				std::move(m_exited.begin(), m_exited.end(), std::back_inserter(records));
+				m_exited.clear();
+			});
+			sort_by_time(records);
+			keep_newest(records, m_options.records);
+		}
+		if (records.empty())
+			return;
+
+		Implementation impl(out, Level::LowLevel, format);
+		for (const auto& record : records)
+			render(impl, record);
+	} catch (...) {}
+}
@@ -0,0 +1,358 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/flight_recorder.hxx>
+#include <StormByte/logger/header_format.hxx>
+#include <StormByte/logger/thread_identity.hxx>
+#include <StormByte/logger/timestamp.hxx>
+#include <StormByte/string.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	template <typename T>
+	class StageRegistry;
+
+	/**
+	 * @struct FlightStyle
+	 * @brief Formatting state a captured value is rendered with (private).
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE FlightStyle {
+		String::Format human_readable;				///< Human-readable number format
+		int precision;								///< -1 = shortest round-trip; N = fixed with N decimals
+		int base;									///< Integer base (10, 16 or 8)
+		std::size_t redact_count;					///< 0 = all '*'; N = keep N chars
+		bool redact_active;							///< Values are redacted
+		bool redact_keep_first;						///< true = keep first N, false = keep last N
+		bool mask_secrets;							///< Detected secrets in text are masked
+
+		bool operator==(const FlightStyle&) const noexcept = default;
+	};
+
+	/**
+	 * @enum FlightTag
+	 * @brief Tags of a captured record (private).
+	 *
+	 * A record starts with its u8 Level, its TickClock stamp and its FlightStyle, followed by tagged
+	 * values in native byte order and size; it never leaves the process that captured it.
+	 */
+	enum class FlightTag : std::uint8_t {
+		Style = 1,									///< FlightStyle of the following values
+		Key,										///< u32 size, bytes: name of the next value
+		Text,										///< u32 size, bytes
+		WideText,									///< u32 length, wchar_t[length]
+		Bool,										///< u8
+		Char,										///< char
+		SignedChar,									///< signed char
+		UnsignedChar,								///< unsigned char
+		WideChar,									///< wchar_t
+		Short,										///< short
+		UnsignedShort,								///< unsigned short
+		Int,										///< int
+		UnsignedInt,								///< unsigned int
+		Long,										///< long
+		UnsignedLong,								///< unsigned long
+		LongLong,									///< long long
+		UnsignedLongLong,							///< unsigned long long
+		Float,										///< float
+		Double,										///< double
+		LongDouble									///< long double
+	};
+
+	/**
+	 * @class FlightRing
+	 * @brief One thread's captured records (private).
+	 *
+	 * The record being captured is assembled in a reusable string by its own thread, without
+	 * locking; finishing it copies it into a circular buffer of fixed size under the ring's
+	 * mutex, evicting the oldest records to make room. The mutex is only contended by a dump
+	 * reading the ring from another thread.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE FlightRing final {
+		public:
+			/**
+			 * @brief A finished record copied out of the ring.
+			 */
+			struct Captured {
+				Instant now;							///< Instant the record started, converted when taken
+				ThreadLabel thread;						///< Identity of the ring's thread
+				std::string data;						///< Record, from its level on
+			};
+
+			/**
+			 * @brief Construct the calling thread's ring.
+			 * @param budget Bytes of finished records kept.
+			 */
+			explicit FlightRing(std::size_t budget);
+
+			FlightRing(const FlightRing&) = delete;
+			FlightRing(FlightRing&&) noexcept = delete;
+			FlightRing& operator=(const FlightRing&) = delete;
+			FlightRing& operator=(FlightRing&&) noexcept = delete;
+			~FlightRing() noexcept = default;
+
+			/**
+			 * @brief Start a record.
+			 * @param level Level of the record.
+			 * @param style Formatting state of its first value.
+			 */
+			void Begin(const Level& level, const FlightStyle& style);
+
+			/**
+			 * @brief Note the formatting state of the next value, if it changed.
+			 * @param style Formatting state.
+			 */
+			void Restyle(const FlightStyle& style) {
+				if (style == m_style) [[likely]]
+					return;
+				m_style = style;
+				put(FlightTag::Style);
+				put(style);
+			}
+
+			/**
+			 * @brief Name the next value.
+			 * @param key Field name.
+			 */
+			void Key(std::string_view key) {
+				put_text(FlightTag::Key, key.data(), key.size());
+			}
+
+			/**
+			 * @brief Capture a value.
+			 * @tparam T Any type Implementation accepts.
+			 * @param value Value; text is copied.
+			 */
+			template <typename T>
+			void Value(const T& value) {
+				using DecayedT = std::decay_t<T>;
+
+				if constexpr (std::is_same_v<DecayedT, bool>) {
+					put(FlightTag::Bool);
+					put(static_cast<std::uint8_t>(value));
+				}
+				else if constexpr (std::is_arithmetic_v<DecayedT>) {
+					put(tag_of<DecayedT>());
+					put(value);
+				}
+				else if constexpr (std::is_same_v<DecayedT, std::string>) {
+					put_text(FlightTag::Text, value.data(), value.size());
+				}
+				else if constexpr (std::is_same_v<DecayedT, const char*>) {
+					const std::string_view text = value ? std::string_view{value} : std::string_view{};
+					put_text(FlightTag::Text, text.data(), text.size());
+				}
+				else if constexpr (std::is_same_v<DecayedT, std::wstring>) {
+					put_text(FlightTag::WideText, value.data(), value.size());
+				}
+				else if constexpr (std::is_same_v<DecayedT, const wchar_t*>) {
+					const std::wstring_view text = value ? std::wstring_view{value} : std::wstring_view{};
+					put_text(FlightTag::WideText, text.data(), text.size());
+				}
+				else if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_extent_t<T>, char>) {
+					const std::string_view text{value};
+					put_text(FlightTag::Text, text.data(), text.size());
+				}
+				else {
+					static_assert(!std::is_same_v<T, T>, "Unsupported type for FlightRing::Value");
+				}
+			}
+
+			/**
+			 * @brief Finish the current record and keep it, unless it exceeds the whole budget.
+			 */
+			void End() noexcept;
+
+			/**
+			 * @brief Copy out the most recent finished records and forget every one.
+			 * @param out Receives up to @p limit records, oldest first.
+			 * @param limit Maximum records copied.
+			 */
+			void Take(std::vector<Captured>& out, std::size_t limit);
+
+		private:
+			std::mutex m_mutex;							///< Guards the finished records
+			ThreadLabel m_thread;						///< Identity of the owning thread
+			std::vector<char> m_data;					///< Finished records: [u32 size][record], circular
+			std::size_t m_head;							///< Offset of the oldest finished record
+			std::size_t m_used;							///< Bytes of finished records
+			std::size_t m_count;						///< Number of finished records
+			std::string m_record;						///< Storage of the record being captured (owning thread only)
+			std::size_t m_size;							///< Bytes of m_record in use
+			FlightStyle m_style;						///< Formatting state of the last captured value
+
+			/**
+			 * @brief Claim @p size bytes at the end of the record being captured.
+			 * @param size Byte count.
+			 * @return Where to write them.
+			 */
+			char* claim(std::size_t size) {
+				if (m_size + size > m_record.size()) [[unlikely]]
+					grow(size);
+				char* at = m_record.data() + m_size;
+				m_size += size;
+				return at;
+			}
+
+			/**
+			 * @brief Enlarge m_record to hold @p size more bytes.
+			 * @param size Byte count.
+			 */
+			void grow(std::size_t size);
+
+			template <typename T>
+			void put(const T& value) {
+				std::memcpy(claim(sizeof(T)), &value, sizeof(T));
+			}
+
+			template <typename C>
+			void put_text(FlightTag tag, const C* data, std::size_t length) {
+				const std::size_t bytes = length * sizeof(C);
+				char* at = claim(sizeof(FlightTag) + sizeof(std::uint32_t) + bytes);
+				const auto size = static_cast<std::uint32_t>(length);
+				*at = static_cast<char>(tag);
+				std::memcpy(at + sizeof(FlightTag), &size, sizeof(size));
+				std::memcpy(at + sizeof(FlightTag) + sizeof(size), data, bytes);
+			}
+
+			template <typename T>
+			static constexpr FlightTag tag_of() noexcept {
+				if constexpr (std::is_same_v<T, char>)					return FlightTag::Char;
+				else if constexpr (std::is_same_v<T, signed char>)		return FlightTag::SignedChar;
+				else if constexpr (std::is_same_v<T, unsigned char>)		return FlightTag::UnsignedChar;
+				else if constexpr (std::is_same_v<T, wchar_t>)			return FlightTag::WideChar;
+				else if constexpr (std::is_same_v<T, short>)				return FlightTag::Short;
+				else if constexpr (std::is_same_v<T, unsigned short>)	return FlightTag::UnsignedShort;
+				else if constexpr (std::is_same_v<T, int>)				return FlightTag::Int;
+				else if constexpr (std::is_same_v<T, unsigned int>)		return FlightTag::UnsignedInt;
+				else if constexpr (std::is_same_v<T, long>)				return FlightTag::Long;
+				else if constexpr (std::is_same_v<T, unsigned long>)		return FlightTag::UnsignedLong;
+				else if constexpr (std::is_same_v<T, long long>)			return FlightTag::LongLong;
+				else if constexpr (std::is_same_v<T, unsigned long long>)	return FlightTag::UnsignedLongLong;
+				else if constexpr (std::is_same_v<T, float>)				return FlightTag::Float;
+				else if constexpr (std::is_same_v<T, double>)			return FlightTag::Double;
+				else if constexpr (std::is_same_v<T, long double>)		return FlightTag::LongDouble;
+				else static_assert(!std::is_same_v<T, T>, "Unsupported arithmetic type for FlightRing");
+			}
+
+			/**
+			 * @brief Bring an offset at most one lap past the end back into the circular buffer.
+			 * @param offset Offset below twice the buffer size.
+			 * @return Offset within the buffer.
+			 */
+			std::size_t wrap(std::size_t offset) const noexcept {
+				return offset >= m_data.size() ? offset - m_data.size() : offset;
+			}
+
+			/**
+			 * @brief Copy @p size bytes into the circular buffer at @p offset.
+			 * @param offset Start offset; wraps around the end.
+			 * @param data Bytes to copy.
+			 * @param size Byte count.
+			 */
+			void copy_in(std::size_t offset, const char* data, std::size_t size) noexcept;
+
+			/**
+			 * @brief Copy @p size bytes out of the circular buffer from @p offset.
+			 * @param offset Start offset; wraps around the end.
+			 * @param data Receives the bytes.
+			 * @param size Byte count.
+			 */
+			void copy_out(std::size_t offset, char* data, std::size_t size) const noexcept;
+
+			/**
+			 * @brief Forget the oldest finished record (m_mutex held).
+			 */
+			void evict() noexcept;
+	};
+
+	/**
+	 * @class FlightRecorder
+	 * @brief Flight recorder shared by every Implementation of a logger (private).
+	 *
+	 * Hands each producer thread its own FlightRing and renders captured records when a
+	 * trigger line is written (see FlightRecorderOptions). The ring of an exiting thread is
+	 * retired with the thread; with FlightScope::All its newest records are kept for the
+	 * next dump.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE FlightRecorder final {
+		public:
+			/**
+			 * @brief Construct a recorder.
+			 * @param options What is captured and dumped.
+			 */
+			explicit FlightRecorder(const FlightRecorderOptions& options);
+
+			FlightRecorder(const FlightRecorder&) = delete;
+			FlightRecorder(FlightRecorder&&) noexcept = delete;
+			FlightRecorder& operator=(const FlightRecorder&) = delete;
+			FlightRecorder& operator=(FlightRecorder&&) noexcept = delete;
+			~FlightRecorder() noexcept;
+
+			/**
+			 * @brief Lowest filtered level that is captured.
+			 * @return Capture level.
+			 */
+			const Level& CaptureLevel() const noexcept {
+				return m_options.capture;
+			}
+
+			/**
+			 * @brief Lowest level whose lines dump the captured records.
+			 * @return Trigger level.
+			 */
+			const Level& TriggerLevel() const noexcept {
+				return m_options.trigger;
+			}
+
+			/**
+			 * @brief Get (creating on first use) the calling thread's ring.
+			 * @return Reference to the ring.
+			 */
+			FlightRing& Local();
+
+			/**
+			 * @brief Render the captured records in scope to @p out and forget them.
+			 * @param out Stream written ahead of the trigger line.
+			 * @param format Header format of the logger.
+			 */
+			void Dump(std::ostream& out, const HeaderFormat& format) noexcept;
+
+		private:
+			const FlightRecorderOptions m_options;				///< What is captured and dumped
+			std::unique_ptr<StageRegistry<FlightRing>> m_rings;	///< One ring per producer thread
+			std::mutex m_exited_mutex;							///< Guards m_exited
+			std::vector<FlightRing::Captured> m_exited;			///< Newest records of exited threads, oldest first
+	};
+}
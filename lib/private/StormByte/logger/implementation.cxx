@@ -1,126 +1,434 @@
 #include <StormByte/logger/implementation.hxx>
+#include <StormByte/logger/escape.hxx>
 
-#include <chrono>
-#include <thread>
+#include <array>
 
 using namespace StormByte::Logger;
 
-std::string Implementation::CurrentTime() const noexcept {
-	try {
-		auto now = std::chrono::system_clock::now();
-		std::time_t rawtime = std::chrono::system_clock::to_time_t(now);
-		struct tm timeinfo{};
+namespace {
+	// Level names padded to the fixed header width, indexed by Level.
+	constexpr std::string_view padded_level_names[] = {
+		"LowLevel", "Debug   ", "Warning ", "Notice  ", "Info    ", "Error   ", "Fatal   "
+	};
+
+	constexpr std::string_view padded_level_name(const Level& level) noexcept {
+		const auto index = static_cast<std::size_t>(level);
+		return index < std::size(padded_level_names) ? padded_level_names[index] : padded_level_names[static_cast<std::size_t>(Level::Error)];
+	}
+
+	// Write @p count '*' from a static run, a block at a time.
+	void write_mask(std::ostream& out, std::size_t count) noexcept {
+		static constexpr std::size_t mask_chunk = 64;
+		static constexpr auto mask = [] {
+			std::array<char, mask_chunk> stars{};
+			stars.fill('*');
+			return stars;
+		}();
+		while (count > 0) {
+			const std::size_t chunk = count < mask_chunk ? count : mask_chunk;
+			out.write(mask.data(), static_cast<std::streamsize>(chunk));
+			count -= chunk;
+		}
+	}
+
+	// Level names without padding, for structured encodings.
+	constexpr std::string_view level_names[] = {
+		"LowLevel", "Debug", "Warning", "Notice", "Info", "Error", "Fatal"
+	};
+
+	constexpr std::string_view level_name(const Level& level) noexcept {
+		const auto index = static_cast<std::size_t>(level);
+		return index < std::size(level_names) ? level_names[index] : level_names[static_cast<std::size_t>(Level::Error)];
+	}
+
+	// Render a timestamp field from the per-thread cache; valid until the next call on this thread.
+	std::string_view time_text(const HeaderFormat::Field& field, const Instant& now) noexcept {
+		TimestampCache& cache = TimestampCache::Local();
+		switch (field) {
+			case HeaderFormat::Field::LocalTime:	return cache.LocalTime(now);
+			case HeaderFormat::Field::UtcTime:		return cache.UtcTime(now);
+			case HeaderFormat::Field::LocalIso:		return cache.LocalIso(now);
+			case HeaderFormat::Field::UtcIso:		return cache.UtcIso(now);
+			case HeaderFormat::Field::UtcOffset:	return cache.UtcOffset(now);
+			case HeaderFormat::Field::Milliseconds:	return cache.Fraction(now, 3);
+			case HeaderFormat::Field::Microseconds:	return cache.Fraction(now, 6);
+			case HeaderFormat::Field::Nanoseconds:	return cache.Fraction(now, 9);
+			default: return {};
+		}
+	}
+
+	bool is_thread_field(const HeaderFormat::Field& field) noexcept {
+		return field == HeaderFormat::Field::ThreadId || field == HeaderFormat::Field::ThreadName
+			|| field == HeaderFormat::Field::ThreadTid;
+	}
+
+	// Text of a thread field: the recorded identity, or the calling thread's cached one.
+	// An unnamed thread shows its kernel thread id as its name.
+	std::string_view thread_text(const HeaderFormat::Field& field, const ThreadText& recorded) noexcept {
+		const ThreadText text = recorded.id.empty() ? ThreadIdentity::Local().Text() : recorded;
+		switch (field) {
+			case HeaderFormat::Field::ThreadId:		return text.id;
+			case HeaderFormat::Field::ThreadTid:	return text.tid;
+			default: return text.name.empty() ? text.tid : text.name;
+		}
+	}
+
+	// Print a timestamp field from the per-thread cache.
+	void print_time(std::ostream& out, const HeaderFormat::Field& field, const Instant& now) noexcept {
+		const std::string_view text = time_text(field, now);
+		out.write(text.data(), static_cast<std::streamsize>(text.size()));
+	}
 
-#ifdef WINDOWS
-		localtime_s(&timeinfo, &rawtime);
-#elifdef UNIX
-		localtime_r(&rawtime, &timeinfo);
-#else
-		#error "Unsupported platform for CurrentTime()"
-#endif
+	bool is_time_field(const HeaderFormat::Field& field) noexcept {
+		return field != HeaderFormat::Field::Literal && field != HeaderFormat::Field::Level
+			&& !is_thread_field(field);
+	}
+
+	// Print the level name (padded).
+	void print_level(std::ostream& out, const Level& level) noexcept {
+		const std::string_view name = padded_level_name(level);
+		out.write(name.data(), static_cast<std::streamsize>(name.size()));
+	}
+
+	// Print a thread field without allocating.
+	void print_thread(std::ostream& out, const HeaderFormat::Field& field, const ThreadText& thread) noexcept {
+		const std::string_view text = thread_text(field, thread);
+		out.write(text.data(), static_cast<std::streamsize>(text.size()));
+	}
 
-		char timebuf[64];
-		std::size_t tn = std::strftime(timebuf, sizeof(timebuf), "%d/%m/%Y %H:%M:%S", &timeinfo);
-		return std::string(timebuf, tn);
-	} catch (...) {
-		return std::string();
+	// One text field of a structured header; logfmt quotes the value only if needed.
+	void write_field(std::ostream& out, bool json, std::string_view key, std::string_view value) noexcept {
+		if (json) {
+			out.write(",\"", 2);
+			out.write(key.data(), static_cast<std::streamsize>(key.size()));
+			out.write("\":\"", 3);
+			Escape::Write(out, value);
+			out.put('"');
+			return;
+		}
+		out.put(' ');
+		out.write(key.data(), static_cast<std::streamsize>(key.size()));
+		if (Escape::FindLogfmt(value) == value.size()) {
+			out.put('=');
+			out.write(value.data(), static_cast<std::streamsize>(value.size()));
+		} else {
+			out.write("=\"", 2);
+			Escape::Write(out, value);
+			out.put('"');
+		}
+	}
+
+	// Header of a structured encoding: level, then time (the time fields and the literal text
+	// between them, e.g. "%I.%6"), then thread, thread_name and tid, whatever their order in the format.
+	void render_structured_header(std::ostream& out, const HeaderFormat& format, const Level& level,
+								  std::optional<Instant> now, const ThreadText& thread) noexcept {
+		const auto& tokens = format.Tokens();
+		const std::string_view literals = format.Literals();
+		const bool json = format.LineEncoding() == Encoding::Json;
+
+		std::size_t first_time = tokens.size(), last_time = 0;
+		bool id = false, name = false, tid = false;
+		for (std::size_t i = 0; i < tokens.size(); ++i) {
+			if (is_time_field(tokens[i].field)) {
+				if (first_time == tokens.size())
+					first_time = i;
+				last_time = i;
+			} else {
+				id |= tokens[i].field == HeaderFormat::Field::ThreadId;
+				name |= tokens[i].field == HeaderFormat::Field::ThreadName;
+				tid |= tokens[i].field == HeaderFormat::Field::ThreadTid;
+			}
+		}
+
+		const std::string_view level_text = level_name(level);
+		if (json) {
+			out.write("{\"level\":\"", 10);
+			out.write(level_text.data(), static_cast<std::streamsize>(level_text.size()));
+			out.put('"');
+		} else {
+			out.write("level=", 6);
+			out.write(level_text.data(), static_cast<std::streamsize>(level_text.size()));
+		}
+
+		if (first_time != tokens.size()) {
+			// Assembled first: logfmt only quotes it if needed.
+			char buffer[128];
+			std::size_t size = 0;
+			auto append = [&](std::string_view text) {
+				const std::size_t n = text.size() < sizeof(buffer) - size ? text.size() : sizeof(buffer) - size;
+				text.copy(buffer + size, n);
+				size += n;
+			};
+			if (!now)
+				now = Instant::Now();
+			for (std::size_t i = first_time; i <= last_time; ++i) {
+				if (tokens[i].field == HeaderFormat::Field::Literal)
+					append(literals.substr(tokens[i].offset, tokens[i].length));
+				else if (is_time_field(tokens[i].field))
+					append(time_text(tokens[i].field, *now));
+			}
+			write_field(out, json, "time", { buffer, size });
+		}
+
+		if (id)
+			write_field(out, json, "thread", thread_text(HeaderFormat::Field::ThreadId, thread));
+		if (name)
+			write_field(out, json, "thread_name", thread_text(HeaderFormat::Field::ThreadName, thread));
+		if (tid)
+			write_field(out, json, "tid", thread_text(HeaderFormat::Field::ThreadTid, thread));
 	}
 }
 
-Implementation::Implementation(std::ostream& out, const Level& level, const std::string& format):
+Implementation::Implementation(std::ostream& out, const Level& level, const HeaderFormat& format):
 	m_out(out),
 	m_print_level(level),
 	m_current_level(std::nullopt),
 	m_enabled(true),
 	m_header_displayed(false),
 	m_format(format),
+	m_encoding(format.LineEncoding()),
 	m_human_readable_format(String::Format::Raw),
+	m_precision(-1),
+	m_base(10),
 	m_redact_active(false),
 	m_redact_count(0),
-	m_redact_keep_first(false) {
+	m_redact_keep_first(false),
+	m_replay_instant(std::nullopt),
+	m_replay_thread(),
+	m_header_listener(nullptr),
+	m_key(),
+	m_has_key(false),
+	m_message_open(false),
+	m_line_has_content(false),
+	m_mask_secrets(false),
+	m_secrets(),
+	m_secret_buffer(),
+	m_recorder(),
+	m_capturing(false),
+	m_flight(nullptr),
+	m_counters() {
 }
 
 Implementation& Implementation::operator<<(const Level& level) noexcept {
+	flight_close();
 	if (m_current_level) {
 		if (level != *m_current_level && *m_current_level >= m_print_level && m_header_displayed) {
+			close_line();
 			m_out << std::endl;
 			m_header_displayed = false;
 		}
 	}
 
 	m_current_level = level;
-	m_enabled.store(level >= m_print_level, std::memory_order_release);
+	const bool enabled = level >= m_print_level;
+	if (!enabled)
+		m_counters.Filtered(level);
+	const bool capturing = !enabled && m_recorder && level >= m_recorder->CaptureLevel();
+	m_capturing.store(capturing, std::memory_order_relaxed);
+	m_enabled.store(enabled || capturing, std::memory_order_release);
 	return *this;
 }
 
+void Implementation::EndRecord() noexcept {
+	flight_close();
+	if (!m_header_displayed)
+		return;
+	close_line();
+	try {
+		m_out.put('\n');
+	} catch (...) {}
+	m_header_displayed = false;
+}
+
 Implementation& Implementation::operator<<(std::ostream& (*manip)(std::ostream&)) noexcept {
+	if (m_capturing.load(std::memory_order_relaxed)) [[unlikely]] {
+		// Nothing reaches the stream; anything but a flush ends the captured record.
+		if (manip != static_cast<std::ostream& (*)(std::ostream&)>(std::flush))
+			flight_close();
+		return *this;
+	}
 	if (m_enabled.load(std::memory_order_acquire)) {
+		close_line();
 		m_out << manip;
 		m_header_displayed = false;
 	}
 	return *this;
 }
 
-void Implementation::print_time() const noexcept {
-	m_out << CurrentTime();
+Implementation& Implementation::operator<<(std::ios_base& (*manip)(std::ios_base&)) noexcept {
+	// Inline functions are not address-unique across shared objects, so apply the
+	// manipulator to the stream and read the resulting base back instead.
+	const std::ios_base::fmtflags saved = m_out.flags();
+	manip(m_out);
+	const std::ios_base::fmtflags base = m_out.flags() & std::ios_base::basefield;
+	m_out.flags(saved);
+	if (base == std::ios_base::hex)
+		m_base = 16;
+	else if (base == std::ios_base::oct)
+		m_base = 8;
+	else if (base == std::ios_base::dec)
+		m_base = 10;
+	return *this;
 }
 
-void Implementation::print_level() const noexcept {
-	constexpr std::size_t fixed_width = 8;
-	const std::string level_str = LevelToString(*m_current_level);
-	m_out << level_str;
-	for (std::size_t i = level_str.size(); i < fixed_width; ++i)
-		m_out.put(' ');
+void Implementation::write_redacted(std::string_view text) noexcept {
+	const std::size_t keep = m_redact_count < text.size() ? m_redact_count : text.size();
+	const std::size_t masked = text.size() - keep;
+	if (m_redact_keep_first) {
+		m_out.write(text.data(), static_cast<std::streamsize>(keep));
+		write_mask(m_out, masked);
+	} else {
+		write_mask(m_out, masked);
+		m_out.write(text.data() + masked, static_cast<std::streamsize>(keep));
+	}
 }
 
-void Implementation::print_thread_id() const noexcept {
-	m_out << std::this_thread::get_id();
+void Implementation::RenderHeader(std::ostream& out, const HeaderFormat& format, const Level& level,
+								  std::optional<Instant> now, const ThreadText& thread) noexcept {
+	if (format.LineEncoding() != Encoding::Text) [[unlikely]] {
+		render_structured_header(out, format, level, now, thread);
+		return;
+	}
+	const std::string_view literals = format.Literals();
+	for (const auto& token : format.Tokens()) {
+		switch (token.field) {
+			case HeaderFormat::Field::Literal:
+				out.write(literals.data() + token.offset, static_cast<std::streamsize>(token.length));
+				break;
+			case HeaderFormat::Field::Level:
+				print_level(out, level);
+				break;
+			case HeaderFormat::Field::ThreadId:
+			case HeaderFormat::Field::ThreadName:
+			case HeaderFormat::Field::ThreadTid:
+				print_thread(out, token.field, thread);
+				break;
+			default:
+				// Every time field of one header shows the same instant; sampled on first use.
+				if (!now)
+					now = Instant::Now();
+				print_time(out, token.field, *now);
+				break;
+		}
+	}
 }
 
 void Implementation::print_header() const noexcept {
-	const std::string& fmt = m_format;
-	constexpr std::size_t fixed_width = 8;
-
-	for (std::size_t i = 0; i < fmt.size(); ++i) {
-		if (fmt[i] == '%' && (i + 1) < fmt.size()) {
-			const char spec = fmt[i + 1];
-			switch (spec) {
-				case '%':
-					m_out.put('%');
-					++i;
-					break;
-				case 'L': {
-					const Level lvl = m_current_level ? *m_current_level : m_print_level;
-					std::string level_str = LevelToString(lvl);
-					m_out << level_str;
-					for (std::size_t p = level_str.size(); p < fixed_width; ++p)
-						m_out.put(' ');
-					++i;
-					break;
-				}
-				case 'T':
-					print_time();
-					++i;
-					break;
-				case 'i':
-					print_thread_id();
-					++i;
-					break;
-				default:
-					m_out.put('%');
-					break;
+	const Level& level = m_current_level ? *m_current_level : m_print_level;
+	if (m_header_listener) [[unlikely]] {
+		m_header_listener->OnHeader(level, m_replay_instant ? *m_replay_instant : Instant::Now());
+		return;
+	}
+	if (m_recorder && level >= m_recorder->TriggerLevel()) [[unlikely]]
+		m_recorder->Dump(m_out, m_format);
+	RenderHeader(m_out, m_format, level, m_replay_instant, m_replay_thread);
+}
+
+FlightRing& Implementation::flight_open() {
+	if (!m_flight) {
+		FlightRing& ring = m_recorder->Local();
+		ring.Begin(CurrentLevel(), Style());
+		m_flight = &ring;
+	} else {
+		m_flight->Restyle(Style());
+	}
+	if (m_has_key) {
+		m_has_key = false;
+		m_flight->Key(m_key);
+	}
+	return *m_flight;
+}
+
+void Implementation::close_structured() noexcept {
+	if (!m_header_displayed)
+		return;
+	try {
+		if (m_message_open)
+			m_out.put('"');
+		if (m_encoding == Encoding::Json)
+			m_out.put('}');
+	} catch (...) {}
+	m_message_open = false;
+}
+
+void Implementation::write_structured(std::string_view text, bool bare) noexcept {
+	const bool keyed = m_has_key;
+	m_has_key = false;
+	try {
+		if (m_encoding == Encoding::Text) {
+			if (m_line_has_content)
+				m_out.put(' ');
+			m_out.write(m_key.data(), static_cast<std::streamsize>(m_key.size()));
+			m_out.put('=');
+			m_line_has_content = true;
+			if (m_redact_active)
+				write_redacted(text);
+			else
+				m_out.write(text.data(), static_cast<std::streamsize>(text.size()));
+			return;
+		}
+
+		const bool json = m_encoding == Encoding::Json;
+		if (!keyed) {
+			if (!m_message_open) {
+				if (json)
+					m_out.write(",\"msg\":\"", 8);
+				else
+					m_out.write(" msg=\"", 6);
+				m_message_open = true;
 			}
+			write_escaped(text);
+			return;
+		}
+
+		if (m_message_open) {
+			m_out.put('"');
+			m_message_open = false;
+		}
+		if (json) {
+			m_out.write(",\"", 2);
+			Escape::Write(m_out, m_key);
+			m_out.write("\":", 2);
+		} else {
+			m_out.put(' ');
+			m_out.write(m_key.data(), static_cast<std::streamsize>(m_key.size()));
+			m_out.put('=');
+		}
+		m_line_has_content = true;
+
+		// Redacted values are always strings; logfmt leaves plain words unquoted.
+		const bool plain = !m_redact_active
+			&& (bare || (!json && !text.empty() && Escape::FindLogfmt(text) == text.size()));
+		if (plain) {
+			m_out.write(text.data(), static_cast<std::streamsize>(text.size()));
 		} else {
-			m_out.put(fmt[i]);
+			m_out.put('"');
+			write_escaped(text);
+			m_out.put('"');
 		}
+	} catch (...) {}
+}
+
+void Implementation::write_escaped(std::string_view text) noexcept {
+	if (!m_redact_active) [[likely]] {
+		Escape::Write(m_out, text);
+		return;
 	}
-	m_out.put(' ');
+	const std::size_t keep = m_redact_count < text.size() ? m_redact_count : text.size();
+	const std::size_t masked = text.size() - keep;
+	try {
+		if (m_redact_keep_first)
+			Escape::Write(m_out, text.substr(0, keep));
+		write_mask(m_out, masked);
+		if (!m_redact_keep_first)
+			Escape::Write(m_out, text.substr(masked));
+	} catch (...) {}
 }
 
 void Implementation::print_message(const std::string& message) noexcept {
 	if (!m_enabled.load(std::memory_order_acquire))
 		return;
-	write_text(message);
+	write_string(message);
 }
 
 void Implementation::print_message(const wchar_t& value) noexcept {
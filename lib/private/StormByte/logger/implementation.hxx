@@ -19,10 +19,20 @@
 
 #pragma once
 
+#include <StormByte/logger/flight_ring.hxx>
+#include <StormByte/logger/header_format.hxx>
+#include <StormByte/logger/log_counters.hxx>
+#include <StormByte/logger/secret_scanner.hxx>
+#include <StormByte/logger/thread_identity.hxx>
+#include <StormByte/logger/timestamp.hxx>
 #include <StormByte/logger/typedefs.hxx>
 #include <StormByte/string.hxx>
 
 #include <atomic>
+#include <charconv>
+#include <cmath>
+#include <ios>
+#include <memory>
 #include <optional>
 #include <ostream>
 #include <string>
@@ -34,6 +44,24 @@
  * @brief Logging utilities for StormByte.
  */
 namespace StormByte::Logger {
+	/**
+	 * @class HeaderListener
+	 * @brief Receives the headers of an Implementation instead of its stream (private).
+	 *
+	 * Lets a facade render each header itself, once per destination format.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE HeaderListener {
+		public:
+			virtual ~HeaderListener() noexcept = default;
+
+			/**
+			 * @brief A header would be printed now.
+			 * @param level Level of the line.
+			 * @param now Instant of the header.
+			 */
+			virtual void OnHeader(const Level& level, const Instant& now) noexcept = 0;
+	};
+
 	/**
 	 * @class Implementation
 	 * @brief Internal logger implementation (private).
@@ -52,9 +80,9 @@ namespace StormByte::Logger {
 			 * @brief Construct the internal logger implementation.
 			 * @param out Output stream to write log messages to.
 			 * @param level Initial minimum Level that will be emitted.
-			 * @param format Header format string (%L, %T, %i, %%).
+			 * @param format Compiled header format.
 			 */
-			Implementation(std::ostream& out, const Level& level = Level::Info, const std::string& format = "[%L] %T");
+			Implementation(std::ostream& out, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T");
 
 			/**
 			 * @brief Copy constructor (deleted).
@@ -101,10 +129,26 @@ namespace StormByte::Logger {
 
 			/**
 			 * @brief Whether the current message level will be emitted.
-			 * @return true if the message will be written.
+			 * @return true if the message will be written; false while it is only captured.
 			 */
 			bool Enabled() const noexcept {
-				return m_enabled.load(std::memory_order_acquire);
+				return m_enabled.load(std::memory_order_acquire) && !m_capturing.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Flag telling facades, inline, whether values are accepted (written or captured).
+			 * @return Reference to the flag; valid for the lifetime of this Implementation.
+			 */
+			const std::atomic<bool>& EnabledFlag() const noexcept {
+				return m_enabled;
+			}
+
+			/**
+			 * @brief Lines emitted and statements filtered through this Implementation.
+			 * @return Reference to the counters.
+			 */
+			LevelCounters& Counters() noexcept {
+				return m_counters;
 			}
 
 			/**
@@ -119,6 +163,128 @@ namespace StormByte::Logger {
 				m_redact_keep_first = keep_first;
 			}
 
+			/**
+			 * @brief Enable or disable secret detection on subsequent text values (see SecretScanner).
+			 * @param active true to mask detected secrets.
+			 */
+			void SetMaskSecrets(bool active) noexcept {
+				m_mask_secrets = active;
+				m_secrets.Clear();
+			}
+
+			/**
+			 * @brief Whether secret detection is enabled.
+			 * @return true if detected secrets are masked.
+			 */
+			bool MasksSecrets() const noexcept {
+				return m_mask_secrets;
+			}
+
+			/**
+			 * @brief Line encoding of the header format.
+			 * @return Text, Json or Logfmt.
+			 */
+			const Encoding& LineEncoding() const noexcept {
+				return m_encoding;
+			}
+
+			/**
+			 * @brief Name the next value: it is written as a field (see @ref kv) instead of free text.
+			 *
+			 * Ignored while the current level is filtered, so a filtered field never names a
+			 * later value. The key is copied.
+			 * @param key Field name.
+			 */
+			void SetKey(std::string_view key) noexcept {
+				if (!m_enabled.load(std::memory_order_acquire))
+					return;
+				try {
+					m_key.assign(key);
+					m_has_key = true;
+				} catch (...) {}
+				if (m_mask_secrets && SecretScanner::IsSecretKey(key)) [[unlikely]]
+					m_secrets.Expect();
+			}
+
+			/**
+			 * @brief Capture filtered records into @p recorder and dump them ahead of trigger lines.
+			 *
+			 * Applies from the next level change. Filtered values at or above the capture level
+			 * are then accepted (see EnabledFlag()) and kept raw in the calling thread's ring.
+			 * @param recorder Recorder, or nullptr to stop capturing.
+			 */
+			void SetRecorder(std::shared_ptr<FlightRecorder> recorder) noexcept {
+				m_recorder = std::move(recorder);
+			}
+
+			/**
+			 * @brief Formatting state applied to subsequent values.
+			 * @return Current state.
+			 */
+			FlightStyle Style() const noexcept {
+				return FlightStyle{ m_human_readable_format, m_precision, m_base, m_redact_count,
+									m_redact_active, m_redact_keep_first, m_mask_secrets };
+			}
+
+			/**
+			 * @brief Restore a formatting state returned by Style().
+			 * @param style State to apply to subsequent values.
+			 */
+			void SetStyle(const FlightStyle& style) noexcept {
+				m_human_readable_format = style.human_readable;
+				m_precision = style.precision;
+				m_base = style.base;
+				SetRedact(style.redact_active, style.redact_count, style.redact_keep_first);
+				if (style.mask_secrets != m_mask_secrets)
+					SetMaskSecrets(style.mask_secrets);
+			}
+
+			/**
+			 * @brief Set floating-point precision for subsequent values.
+			 * @param digits -1 = shortest round-trip representation; N = fixed notation with N decimals.
+			 */
+			void SetPrecision(int digits) noexcept {
+				m_precision = digits;
+			}
+
+			/**
+			 * @brief End the current record: write a newline if its header was printed.
+			 *
+			 * The level stays as it is, like after std::endl, but the stream is not flushed.
+			 */
+			void EndRecord() noexcept;
+
+			/**
+			 * @brief Render subsequent headers with a recorded instant and thread identity.
+			 *
+			 * Used when decoding deferred (binary) logs; live loggers never call it.
+			 * @param now Instant shown by the time fields of the next header.
+			 * @param thread Text shown by %i, %n and %t; must outlive this Implementation.
+			 */
+			void Replay(const Instant& now, const ThreadText& thread) noexcept {
+				m_replay_instant = now;
+				m_replay_thread = thread;
+			}
+
+			/**
+			 * @brief Hand headers to @p listener instead of writing them to the stream.
+			 * @param listener Listener (nullptr to render headers again); must outlive this Implementation.
+			 */
+			void Listen(HeaderListener* listener) noexcept {
+				m_header_listener = listener;
+			}
+
+			/**
+			 * @brief Render a header.
+			 * @param out Stream to write to.
+			 * @param format Compiled header format.
+			 * @param level Level shown by %L.
+			 * @param now Instant shown by the time fields; sampled on first use when empty.
+			 * @param thread Text shown by %i, %n and %t; the calling thread's when its id is empty.
+			 */
+			static void RenderHeader(std::ostream& out, const HeaderFormat& format, const Level& level,
+									 std::optional<Instant> now, const ThreadText& thread) noexcept;
+
 			/**
 			 * @brief Set the current logging level.
 			 * @param level New Level for subsequent messages.
@@ -133,6 +299,16 @@ namespace StormByte::Logger {
 			 */
 			Implementation& operator<<(std::ostream& (*manip)(std::ostream&)) noexcept;
 
+			/**
+			 * @brief Apply a numeric base manipulator (std::dec, std::hex, std::oct).
+			 *
+			 * The basefield it selects is applied to the logger's own number formatting; any
+			 * other std::ios_base manipulator is ignored. State changes even when filtered.
+			 * @param manip Base manipulator.
+			 * @return Reference to this Implementation.
+			 */
+			Implementation& operator<<(std::ios_base& (*manip)(std::ios_base&)) noexcept;
+
 			/**
 			 * @brief Apply an Implementation-specific manipulator.
 			 * @param manip Manipulator function.
@@ -151,46 +327,55 @@ namespace StormByte::Logger {
 			template <typename T>
 			Implementation& operator<<(const T& value) noexcept
 				requires (!std::is_same_v<std::decay_t<T>, Implementation& (*)(Implementation&) noexcept>) {
+				if (m_enabled.load(std::memory_order_acquire)) [[unlikely]]
+					Append(value);
+				return *this;
+			}
+
+			/**
+			 * @brief Write a value without testing the level; the caller already checked Enabled().
+			 * @tparam T Type of the value.
+			 * @param value Value to write.
+			 */
+			template <typename T>
+			void Append(const T& value) noexcept {
 				using DecayedT = std::decay_t<T>;
 
-				if (!m_enabled.load(std::memory_order_acquire)) [[likely]] {
-					return *this;
+				if (m_capturing.load(std::memory_order_relaxed)) [[unlikely]] {
+					try {
+						flight_ring().Value(value);
+					} catch (...) {}
+					return;
 				}
 
 				if constexpr (std::is_same_v<DecayedT, bool>) {
-					write_text(std::string_view{value ? "true" : "false"});
+					skip_secret();
+					write_text(std::string_view{value ? "true" : "false"}, true);
 				}
 				else if constexpr (std::is_same_v<DecayedT, wchar_t>) {
 					print_message(value);
 				}
 				else if constexpr (std::is_integral_v<DecayedT> || std::is_floating_point_v<DecayedT>) {
-					std::string message;
-					if (m_human_readable_format == String::Format::Raw) {
-						message = std::to_string(value);
-					} else {
-						message = String::HumanReadable(value, m_human_readable_format, "en_US.UTF-8");
-					}
-					write_text(message);
+					write_number(value);
 				}
 				else if constexpr (std::is_same_v<DecayedT, std::string>) {
-					write_text(value);
+					write_string(value);
 				}
 				else if constexpr (std::is_same_v<DecayedT, const char*>) {
-					write_text(value ? std::string_view{value} : std::string_view{});
+					write_string(value ? std::string_view{value} : std::string_view{});
 				}
 				else if constexpr (std::is_same_v<DecayedT, std::wstring>) {
-					write_text(String::UTF8Encode(value));
+					write_string(String::UTF8Encode(value));
 				}
 				else if constexpr (std::is_same_v<DecayedT, const wchar_t*>) {
-					write_text(value ? String::UTF8Encode(std::wstring(value)) : std::string{});
+					write_string(value ? String::UTF8Encode(std::wstring(value)) : std::string{});
 				}
 				else if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_extent_t<T>, char>) {
-					write_text(std::string_view{value});
+					write_string(std::string_view{value});
 				}
 				else {
 					static_assert(!std::is_same_v<T, T>, "Unsupported type for Implementation::operator<<");
 				}
-				return *this;
 			}
 
 		private:
@@ -199,106 +384,201 @@ namespace StormByte::Logger {
 			std::optional<Level> m_current_level;		///< Level of the current message
 			std::atomic<bool> m_enabled;				///< Whether the current level is enabled
 			bool m_header_displayed;					///< Whether the header has already been written
-			const std::string m_format;					///< Header format string
+			const HeaderFormat m_format;				///< Compiled header format
+			const Encoding m_encoding;					///< Line encoding (from m_format)
 			String::Format m_human_readable_format;		///< Current human-readable format
+			int m_precision;							///< -1 = shortest round-trip; N = fixed with N decimals
+			int m_base;									///< Integer base (10, 16 or 8); 16 also selects hex floats
 			bool m_redact_active;						///< When true, text and numbers are redacted
 			std::size_t m_redact_count;					///< 0 = all '*'; N = keep N chars
 			bool m_redact_keep_first;					///< true = keep first N, false = keep last N
+			std::optional<Instant> m_replay_instant;	///< Recorded header instant (decoding only)
+			ThreadText m_replay_thread;					///< Recorded thread identity (decoding only)
+			HeaderListener* m_header_listener;			///< Receives headers instead of m_out, if set
+			std::string m_key;							///< Name of the next value (see SetKey)
+			bool m_has_key;								///< m_key applies to the next value
+			bool m_message_open;						///< Structured: the msg string of this line is open
+			bool m_line_has_content;					///< Text or a field was written after this line's header
+			bool m_mask_secrets;						///< When true, detected secrets in text are masked
+			SecretScanner m_secrets;					///< Secret detection state of the line
+			std::string m_secret_buffer;				///< Reusable storage for masked text
+			std::shared_ptr<FlightRecorder> m_recorder;	///< Flight recorder, if enabled
+			std::atomic<bool> m_capturing;				///< The current level is captured instead of written
+			FlightRing* m_flight;						///< Ring of the record being captured, if any
+			LevelCounters m_counters;					///< Lines emitted and statements filtered
+
+			/**
+			 * @brief Ring of the record being captured, noting the formatting state and
+			 * pending key of the next value.
+			 * @return The calling thread's ring.
+			 */
+			FlightRing& flight_ring() {
+				if (m_flight && !m_has_key) [[likely]] {
+					m_flight->Restyle(Style());
+					return *m_flight;
+				}
+				return flight_open();
+			}
+
+			/**
+			 * @brief Slow path of flight_ring(): start the record or capture the pending key.
+			 * @return The calling thread's ring.
+			 */
+			FlightRing& flight_open();
+
+			/**
+			 * @brief Finish the record being captured, if any.
+			 */
+			void flight_close() noexcept {
+				if (m_flight) {
+					m_flight->End();
+					m_flight = nullptr;
+				}
+			}
 
 			/**
 			 * @brief Ensure the header has been printed for the current line.
 			 */
 			void ensure_header() noexcept {
 				if (!m_header_displayed) {
+					m_counters.Emitted(CurrentLevel());
 					print_header();
 					m_header_displayed = true;
+					m_message_open = false;
+					m_line_has_content = false;
 				}
 			}
 
 			/**
-			 * @brief Apply redaction policy.
-			 * @param in Input text.
-			 * @param count 0 = all '*'; N = keep N characters.
-			 * @param keep_first true = keep first N, false = keep last N.
-			 * @return Redacted string of the same length.
+			 * @brief Finish the current line's encoding before its newline and drop a pending key.
 			 */
-			static std::string ApplyRedact(std::string_view in, std::size_t count, bool keep_first) {
-				if (in.empty())
-					return {};
-				if (count >= in.size())
-					return std::string{in};
-
-				std::string out(in.size(), '*');
-				if (keep_first) {
-					for (std::size_t i = 0; i < count; ++i)
-						out[i] = in[i];
-				} else {
-					const std::size_t start = in.size() - count;
-					for (std::size_t i = 0; i < count; ++i)
-						out[start + i] = in[start + i];
-				}
-				return out;
+			void close_line() noexcept {
+				m_has_key = false;
+				m_secrets.Clear();
+				if (m_encoding != Encoding::Text) [[unlikely]]
+					close_structured();
 			}
 
+			/**
+			 * @brief Close the msg string and, for JSON, the object of the current line.
+			 */
+			void close_structured() noexcept;
+
 			/**
 			 * @brief Write text, applying redaction if active.
 			 * @param text Text to write.
+			 * @param bare true if @p text is a number or boolean that structured encodings may leave unquoted.
 			 */
-			void write_text(std::string_view text) noexcept {
+			void write_text(std::string_view text, bool bare = false) noexcept {
 				ensure_header();
-				if (m_redact_active)
-					m_out << ApplyRedact(text, m_redact_count, m_redact_keep_first);
+				if (m_encoding != Encoding::Text || m_has_key) [[unlikely]] {
+					write_structured(text, bare);
+					return;
+				}
+				m_line_has_content = true;
+				if (m_redact_active) [[unlikely]]
+					write_redacted(text);
 				else
-					m_out << text;
+					m_out.write(text.data(), static_cast<std::streamsize>(text.size()));
 			}
 
 			/**
-			 * @brief Write a std::string, applying redaction if active.
+			 * @brief Write a text value, masking detected secrets if enabled.
 			 * @param text Text to write.
 			 */
-			void write_text(const std::string& text) noexcept {
-				write_text(std::string_view{text});
+			void write_string(std::string_view text) noexcept {
+				if (m_mask_secrets) [[unlikely]]
+					m_secrets.Mask(text, m_secret_buffer);
+				write_text(text);
 			}
 
 			/**
-			 * @brief Print the current timestamp.
+			 * @brief A non-text value was written: a pending secret key no longer applies.
 			 */
-			void print_time() const noexcept;
+			void skip_secret() noexcept {
+				if (m_mask_secrets) [[unlikely]]
+					m_secrets.Clear();
+			}
 
 			/**
-			 * @brief Get the current time as a formatted string.
-			 * @return Formatted time string.
+			 * @brief Write a field value or structured message text.
+			 *
+			 * Text encoding: `key=value`, after a space if the line already has content. JSON: message text is escaped into the line's `msg`
+			 * member, fields become members. Logfmt: likewise as `msg="..."` and `key=value`,
+			 * quoting values that need it. Redaction applies to the value before escaping.
+			 * @param text Text of the value.
+			 * @param bare See write_text().
 			 */
-			std::string CurrentTime() const noexcept;
+			void write_structured(std::string_view text, bool bare) noexcept;
 
 			/**
-			 * @brief Print the current level name (padded).
+			 * @brief Write text escaped for a JSON / logfmt string, applying redaction if active.
+			 * @param text Text to write.
 			 */
-			void print_level() const noexcept;
+			void write_escaped(std::string_view text) noexcept;
 
 			/**
-			 * @brief Print the current thread id.
+			 * @brief Write text with the redaction policy applied, without copying it.
+			 *
+			 * The readable part is written straight from @p text and the masked part from a
+			 * static run of '*', so no intermediate string is built.
+			 * @param text Text to write.
 			 */
-			void print_thread_id() const noexcept;
+			void write_redacted(std::string_view text) noexcept;
 
 			/**
-			 * @brief Print the configured header.
+			 * @brief Write a std::string, applying redaction if active.
+			 * @param text Text to write.
+			 */
+			void write_text(const std::string& text) noexcept {
+				write_text(std::string_view{text});
+			}
+
+			/**
+			 * @brief Print the configured header, or hand it to the listener.
+			 *
+			 * A line at or above the flight recorder's trigger level is preceded by the dump.
 			 */
 			void print_header() const noexcept;
 
 			/**
-			 * @brief Helper to print an arithmetic value (with optional human-readable formatting).
+			 * @brief Write an arithmetic value.
+			 *
+			 * Raw values are rendered with std::to_chars into a stack buffer (no allocation);
+			 * human-readable formats go through String::HumanReadable.
 			 * @tparam T Arithmetic type.
-			 * @param value Value to print.
+			 * @param value Value to write.
 			 */
-			template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, wchar_t>>>
-			void print_message(const T& value) noexcept {
-				std::string message;
-				if (m_human_readable_format == String::Format::Raw)
-					message = std::to_string(value);
-				else
-					message = String::HumanReadable(value, m_human_readable_format, "en_US.UTF-8");
-				print_message(message);
+			template <typename T>
+			void write_number(const T& value) noexcept {
+				skip_secret();
+				if (m_human_readable_format != String::Format::Raw) [[unlikely]] {
+					write_text(String::HumanReadable(value, m_human_readable_format, "en_US.UTF-8"));
+					return;
+				}
+
+				char buffer[128];
+				char* const last = buffer + sizeof(buffer);
+				std::to_chars_result result;
+				bool bare = m_base == 10;
+				if constexpr (std::is_floating_point_v<T>) {
+					bare = bare && std::isfinite(value);
+					if (m_base == 16)
+						result = std::to_chars(buffer, last, value, std::chars_format::hex);
+					else if (m_precision >= 0)
+						result = std::to_chars(buffer, last, value, std::chars_format::fixed, m_precision);
+					else
+						result = std::to_chars(buffer, last, value);
+					// Huge values in fixed notation may not fit: fall back to the shortest form.
+					if (result.ec != std::errc{}) [[unlikely]]
+						result = std::to_chars(buffer, last, value);
+				} else {
+					// Small integer types print as numbers, as std::to_string did.
+					using Promoted = std::conditional_t<(sizeof(T) < sizeof(int)), int, T>;
+					result = std::to_chars(buffer, last, static_cast<Promoted>(value), m_base);
+				}
+				if (result.ec == std::errc{}) [[likely]]
+					write_text(std::string_view{ buffer, static_cast<std::size_t>(result.ptr - buffer) }, bare);
 			}
 
 			/**
@@ -0,0 +1,79 @@
+#include <StormByte/logger/line_stage.hxx>
+#include <StormByte/logger/log.hxx>
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include <vector>
+
+using namespace StormByte::Logger;
+
+namespace {
+	constexpr std::size_t max_cached_registries = 16;
+
+	std::atomic<std::uint64_t> s_next_registry_id{1};
+	std::atomic<std::uint64_t> s_next_thread{1};
+
+	// Trivially destructible, so it stays usable while the thread's other thread_locals go.
+	thread_local std::pair<std::uint64_t, void*> t_stage_cache[max_cached_registries];
+	thread_local std::size_t t_stage_cache_size = 0;
+	thread_local std::uint64_t t_thread = 0;
+	thread_local bool t_exiting = false;
+
+	/**
+	 * Links of the registries the thread has a stage in; destroyed, and so run, at thread exit.
+	 */
+	struct Watches {
+		std::vector<std::shared_ptr<StageLink>> links;
+
+		~Watches() {
+			t_exiting = true;
+			// The stages are about to be destroyed: stop handing them out.
+			t_stage_cache_size = 0;
+#ifndef WINDOWS
+			Detail::t_stage_flag = { 0, nullptr };
+#endif
+			for (const auto& link : links)
+				link->Retire(t_thread);
+		}
+	};
+
+	thread_local Watches t_watches;
+}
+
+std::uint64_t StageCache::NextId() noexcept {
+	return s_next_registry_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::uint64_t StageCache::Thread() noexcept {
+	if (t_thread == 0)
+		t_thread = s_next_thread.fetch_add(1, std::memory_order_relaxed);
+	return t_thread;
+}
+
+void* StageCache::Find(std::uint64_t id) noexcept {
+	for (std::size_t i = 0; i < t_stage_cache_size; ++i) {
+		if (t_stage_cache[i].first == id) [[likely]]
+			return t_stage_cache[i].second;
+	}
+	return nullptr;
+}
+
+void StageCache::Insert(std::uint64_t id, void* stage) noexcept {
+	// Ids are never reused, so entries of destroyed registries are only dead weight.
+	if (t_stage_cache_size >= max_cached_registries) {
+		std::move(t_stage_cache + 1, t_stage_cache + t_stage_cache_size, t_stage_cache);
+		--t_stage_cache_size;
+	}
+	t_stage_cache[t_stage_cache_size++] = { id, stage };
+}
+
+void StageCache::Watch(std::shared_ptr<StageLink> link) {
+	if (t_exiting)
+		return;
+	// Registries destroyed since the last stage was created need no retirement.
+	std::erase_if(t_watches.links, [](const std::shared_ptr<StageLink>& watched) {
+		return watched->Closed();
+	});
+	t_watches.links.push_back(std::move(link));
+}
@@ -0,0 +1,347 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/implementation.hxx>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class LineBuffer
+	 * @brief Stream buffer appending into a reusable std::string (private).
+	 *
+	 * Clearing the data keeps its capacity, so a staged line stops allocating once the
+	 * longest line has been seen.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE LineBuffer final: public std::streambuf {
+		public:
+			/**
+			 * @brief Access the accumulated text.
+			 * @return Reference to the internal string.
+			 */
+			std::string& Data() noexcept {
+				return m_data;
+			}
+
+		protected:
+			int_type overflow(int_type ch) override {
+				if (!traits_type::eq_int_type(ch, traits_type::eof()))
+					m_data.push_back(traits_type::to_char_type(ch));
+				return traits_type::not_eof(ch);
+			}
+
+			std::streamsize xsputn(const char* s, std::streamsize n) override {
+				m_data.append(s, static_cast<std::size_t>(n));
+				return n;
+			}
+
+		private:
+			std::string m_data;							///< Accumulated line text
+	};
+
+	/**
+	 * @struct Stage
+	 * @brief Per-thread line assembly area (private).
+	 *
+	 * Owns a private Implementation bound to a LineBuffer, so level, human-readable and
+	 * redaction state are per producer thread and formatting needs no shared lock.
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE Stage {
+		LineBuffer buffer;								///< Staged text
+		std::ostream stream;							///< Stream over buffer
+		Implementation impl;							///< Formatter writing into stream
+
+		/**
+		 * @brief Construct a stage.
+		 * @param level Minimum Level that will be emitted.
+		 * @param format Compiled header format.
+		 * @param recorder Owner's flight recorder slot, read when the stage is created; may be null.
+		 */
+		Stage(const Level& level, const HeaderFormat& format, const std::shared_ptr<FlightRecorder>* recorder = nullptr):
+			buffer(), stream(&buffer), impl(stream, level, format) {
+			if (recorder)
+				impl.SetRecorder(*recorder);
+		}
+
+		/**
+		 * @brief Whether the staged text ends a line and is ready to commit.
+		 * @return true if the buffer is non-empty and ends with a newline.
+		 */
+		bool Complete() noexcept {
+			const std::string& data = buffer.Data();
+			return !data.empty() && data.back() == '\n';
+		}
+
+		/**
+		 * @brief End unterminated staged text with a newline, so it cannot run into another line.
+		 * @return true if there is text to commit.
+		 */
+		bool Finish() {
+			std::string& data = buffer.Data();
+			if (data.empty())
+				return false;
+			if (data.back() != '\n')
+				data.push_back('\n');
+			return true;
+		}
+	};
+
+	/**
+	 * @class StageLink
+	 * @brief Handle through which an exiting thread retires its stage of one registry (private).
+	 *
+	 * Shared between the registry and every thread that has a stage in it, so a thread
+	 * outliving the registry finds the link closed instead of a dangling registry.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE StageLink final {
+		public:
+			/**
+			 * @brief Construct an open link.
+			 * @param retire Called with the token of each exiting thread.
+			 */
+			explicit StageLink(std::function<void(std::uint64_t)> retire): m_retire(std::move(retire)) {}
+
+			/**
+			 * @brief Retire the stage of the thread holding @p thread, unless closed.
+			 * @param thread Token of the exiting thread.
+			 */
+			void Retire(std::uint64_t thread) noexcept {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if (m_retire)
+					m_retire(thread);
+			}
+
+			/**
+			 * @brief Stop retiring stages; waits for a retirement in progress.
+			 */
+			void Close() noexcept {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_retire = nullptr;
+			}
+
+			/**
+			 * @brief Whether the link was closed.
+			 * @return true once Close() was called.
+			 */
+			bool Closed() noexcept {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return !m_retire;
+			}
+
+		private:
+			std::mutex m_mutex;							///< Serializes retirements with Close()
+			std::function<void(std::uint64_t)> m_retire;	///< Registry callback, empty once closed
+	};
+
+	/**
+	 * @struct StageCache
+	 * @brief Per-thread lookup cache and exit hooks shared by every StageRegistry (private).
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE StageCache {
+		/**
+		 * @brief Allocate a process-unique registry id.
+		 * @return The id (never reused).
+		 */
+		static std::uint64_t NextId() noexcept;
+
+		/**
+		 * @brief Process-unique token of the calling thread.
+		 *
+		 * Unlike std::thread::id, a token is never handed to another thread, so a new thread
+		 * cannot pick up the stage of an exited one.
+		 * @return The token.
+		 */
+		static std::uint64_t Thread() noexcept;
+
+		/**
+		 * @brief Calling thread's stage of registry @p id, if cached.
+		 * @param id Registry id.
+		 * @return The stage, or nullptr.
+		 */
+		static void* Find(std::uint64_t id) noexcept;
+
+		/**
+		 * @brief Remember the calling thread's stage of registry @p id.
+		 * @param id Registry id.
+		 * @param stage The stage.
+		 */
+		static void Insert(std::uint64_t id, void* stage) noexcept;
+
+		/**
+		 * @brief Retire the calling thread's stage through @p link when the thread exits.
+		 *
+		 * Ignored while the thread is already exiting: that stage stays with its registry.
+		 * @param link Link of the registry the thread just got a stage in.
+		 */
+		static void Watch(std::shared_ptr<StageLink> link);
+	};
+
+	/**
+	 * @class StageRegistry
+	 * @brief Owns one stage per producer thread of a logger (private).
+	 *
+	 * Lookup goes through a small thread_local cache keyed by a process-unique registry id,
+	 * so the mutex is only taken the first time a thread logs through a given logger.
+	 * Stages are keyed by thread token (see StageCache::Thread()) and retired when their
+	 * thread exits: the retire hook gets to flush what the thread left behind, then the
+	 * stage is destroyed. Stages still present when the registry goes are the owner's.
+	 * @tparam T Stage type.
+	 */
+	template <typename T>
+	class StageRegistry final {
+		public:
+			/**
+			 * @brief Construct a registry.
+			 * @param args Constructor arguments of each new stage (copied).
+			 */
+			template <typename... Args>
+			explicit StageRegistry(const Args&... args):
+				m_id(StageCache::NextId()),
+				m_factory([args...] { return std::make_unique<T>(args...); }),
+				m_link(std::make_shared<StageLink>([this](std::uint64_t thread) { retire(thread); })) {}
+
+			StageRegistry(const StageRegistry&) = delete;
+			StageRegistry(StageRegistry&&) noexcept = delete;
+			StageRegistry& operator=(const StageRegistry&) = delete;
+			StageRegistry& operator=(StageRegistry&&) noexcept = delete;
+			~StageRegistry() noexcept {
+				Close();
+			}
+
+			/**
+			 * @brief Set the hook run on a stage before it is retired (call before any Local()).
+			 *
+			 * Runs on the exiting thread, under the registry mutex.
+			 * @param hook Callable taking T&.
+			 */
+			void OnRetire(std::function<void(T&)> hook) {
+				m_hook = std::move(hook);
+			}
+
+			/**
+			 * @brief Stop retiring stages of exiting threads; waits for a retirement in progress.
+			 *
+			 * Owners call it first thing in their destructor, so the hook never runs on a
+			 * half-destroyed owner.
+			 */
+			void Close() noexcept {
+				m_link->Close();
+			}
+
+			/**
+			 * @brief Process-unique id of the registry.
+			 * @return The id (never reused).
+			 */
+			std::uint64_t Id() const noexcept {
+				return m_id;
+			}
+
+			/**
+			 * @brief Get (creating on first use) the calling thread's stage.
+			 * @return Reference to the stage.
+			 */
+			T& Local() {
+				if (void* cached = StageCache::Find(m_id)) [[likely]]
+					return *static_cast<T*>(cached);
+
+				T* stage;
+				bool created = false;
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					auto& slot = m_stages[StageCache::Thread()];
+					if (!slot) {
+						slot = m_factory();
+						created = true;
+					}
+					stage = slot.get();
+				}
+				if (created)
+					StageCache::Watch(m_link);
+				StageCache::Insert(m_id, stage);
+				return *stage;
+			}
+
+			/**
+			 * @brief Visit every stage under the registry mutex.
+			 * @param f Callable taking T&.
+			 */
+			template <typename F>
+			void ForEach(F&& f) {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (auto& entry : m_stages)
+					f(*entry.second);
+			}
+
+			/**
+			 * @brief Visit every stage, then run @p then, under the registry mutex.
+			 *
+			 * Retirement takes the same mutex, so @p then can read what the retire hook kept of
+			 * the stages gone without counting any of them twice or missing one.
+			 * @param f Callable taking T&.
+			 * @param then Callable taking no argument.
+			 */
+			template <typename F, typename G>
+			void ForEach(F&& f, G&& then) {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				for (auto& entry : m_stages)
+					f(*entry.second);
+				then();
+			}
+
+		private:
+			const std::uint64_t m_id;					///< Process-unique registry id
+			const std::function<std::unique_ptr<T>()> m_factory;	///< Creates new stages
+			std::function<void(T&)> m_hook;				///< Run on a stage before it is retired
+			std::mutex m_mutex;							///< Guards m_stages
+			std::unordered_map<std::uint64_t, std::unique_ptr<T>> m_stages; ///< Stages by thread token
+			const std::shared_ptr<StageLink> m_link;	///< Reached by exiting threads
+
+			/**
+			 * @brief Run the hook on the stage of @p thread and destroy it.
+			 * @param thread Token of the exiting thread.
+			 */
+			void retire(std::uint64_t thread) noexcept {
+				std::unique_ptr<T> stage;
+				std::lock_guard<std::mutex> lock(m_mutex);
+				const auto found = m_stages.find(thread);
+				if (found == m_stages.end())
+					return;
+				try {
+					if (m_hook)
+						m_hook(*found->second);
+				} catch (...) {}
+				stage = std::move(found->second);
+				m_stages.erase(found);
+			}
+	};
+}
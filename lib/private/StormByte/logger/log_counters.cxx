@@ -0,0 +1,100 @@
+#include <StormByte/logger/log_counters.hxx>
+
+#include <chrono>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Acquisitions by the calling thread, for LockCounters sampling.
+	thread_local std::uint64_t t_lock_acquisitions = 0;
+
+	// Monotonic nanoseconds.
+	std::int64_t monotonic_ns() noexcept {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// Monotonic nanoseconds; never 0, which marks an untimed operation.
+	std::uint64_t now_ns() noexcept {
+		return static_cast<std::uint64_t>(monotonic_ns()) | 1;
+	}
+
+	// Scale a sampled total to @p count operations.
+	std::uint64_t estimate(std::uint64_t sampled, std::uint64_t timed, std::uint64_t count) noexcept {
+		if (timed == 0)
+			return 0;
+		return static_cast<std::uint64_t>(static_cast<double>(sampled) * static_cast<double>(count) / static_cast<double>(timed));
+	}
+}
+
+void LevelCounters::Absorb(const LevelCounters& other) noexcept {
+	for (std::size_t level = 0; level < LogStats::Levels; ++level) {
+		m_emitted[level].Add(other.m_emitted[level].Load());
+		m_filtered[level].Add(other.m_filtered[level].Load());
+	}
+}
+
+void LevelCounters::Collect(LogStats& stats) const noexcept {
+	for (std::size_t level = 0; level < LogStats::Levels; ++level) {
+		stats.emitted[level] += m_emitted[level].Load();
+		stats.filtered[level] += m_filtered[level].Load();
+	}
+}
+
+std::uint64_t WriteCounters::Begin(std::size_t bytes) noexcept {
+	const std::uint64_t writes = m_writes.Load();
+	m_writes.Add();
+	m_bytes.Add(bytes);
+	return writes % SampleEvery == 0 ? now_ns() : 0;
+}
+
+void WriteCounters::record(std::uint64_t started) noexcept {
+	m_latency[LatencyHistogram::Bucket(now_ns() - started)].Add();
+}
+
+void WriteCounters::Collect(LogStats& stats) const noexcept {
+	stats.writes += m_writes.Load();
+	stats.bytes += m_bytes.Load();
+	for (std::size_t bucket = 0; bucket < LatencyHistogram::Buckets; ++bucket)
+		stats.write_latency.counts[bucket] += m_latency[bucket].Load();
+}
+
+std::uint64_t LockCounters::Lock(ThreadLock& lock) noexcept {
+	if (t_lock_acquisitions++ % SampleEvery != 0) [[likely]] {
+		lock.Lock();
+		m_acquisitions.Add();
+		return 0;
+	}
+	const std::uint64_t requested = now_ns();
+	lock.Lock();
+	const std::uint64_t acquired = now_ns();
+	m_acquisitions.Add();
+	m_timed.Add();
+	m_wait_ns.Add(acquired - requested);
+	return acquired;
+}
+
+void LockCounters::Unlock(ThreadLock& lock, std::uint64_t acquired) noexcept {
+	if (acquired != 0) [[unlikely]]
+		m_hold_ns.Add(now_ns() - acquired);
+	lock.Unlock();
+}
+
+void LockCounters::Collect(LogStats& stats) const noexcept {
+	const std::uint64_t acquisitions = m_acquisitions.Load();
+	const std::uint64_t timed = m_timed.Load();
+	stats.lock_acquisitions += acquisitions;
+	stats.lock_wait_ns += estimate(m_wait_ns.Load(), timed, acquisitions);
+	stats.lock_hold_ns += estimate(m_hold_ns.Load(), timed, acquisitions);
+}
+
+StatsReport::StatsReport(std::chrono::nanoseconds interval, const Level& level) noexcept:
+	m_interval(interval.count()), m_level(level), m_next(monotonic_ns() + interval.count()) {}
+
+bool StatsReport::Due() noexcept {
+	const std::int64_t now = monotonic_ns();
+	std::int64_t next = m_next.load(std::memory_order_relaxed);
+	if (now < next) [[likely]]
+		return false;
+	return m_next.compare_exchange_strong(next, now + m_interval, std::memory_order_relaxed);
+}
@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/stats.hxx>
+#include <StormByte/thread_lock.hxx>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class Counter
+	 * @brief Relaxed counter with one writer at a time (private).
+	 *
+	 * Every counter below is only written by whoever owns the state it describes (the line
+	 * lock holder, a stage's thread, a writer under its mutex), so an increment is a relaxed
+	 * load and store instead of a locked read-modify-write. Readers see a recent value.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE Counter final {
+		public:
+			/**
+			 * @brief Add @p n.
+			 * @param n Amount.
+			 */
+			void Add(std::uint64_t n = 1) noexcept {
+				m_value.store(m_value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Current value.
+			 * @return The value.
+			 */
+			std::uint64_t Load() const noexcept {
+				return m_value.load(std::memory_order_relaxed);
+			}
+
+		private:
+			std::atomic<std::uint64_t> m_value{0};		///< Value
+	};
+
+	/**
+	 * @class LevelCounters
+	 * @brief Lines emitted and statements filtered, per level, of one Implementation (private).
+	 */
+	class STORMBYTE_LOGGER_PRIVATE LevelCounters final {
+		public:
+			/**
+			 * @brief Count a line started at @p level.
+			 * @param level Level of the line.
+			 */
+			void Emitted(const Level& level) noexcept {
+				count(m_emitted, level);
+			}
+
+			/**
+			 * @brief Count a statement at @p level dropped by the level filter.
+			 * @param level Level of the statement.
+			 */
+			void Filtered(const Level& level) noexcept {
+				count(m_filtered, level);
+			}
+
+			/**
+			 * @brief Add the counts of @p other, whose owner is gone.
+			 * @param other Counters of a retired Implementation.
+			 */
+			void Absorb(const LevelCounters& other) noexcept;
+
+			/**
+			 * @brief Add the counts to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			void Collect(LogStats& stats) const noexcept;
+
+		private:
+			using Counts = std::array<Counter, LogStats::Levels>;
+
+			Counts m_emitted;							///< Lines by level
+			Counts m_filtered;							///< Filtered statements by level
+
+			static void count(Counts& counts, const Level& level) noexcept {
+				const auto index = static_cast<std::size_t>(level);
+				if (index < counts.size()) [[likely]]
+					counts[index].Add();
+			}
+	};
+
+	/**
+	 * @class WriteCounters
+	 * @brief Bytes and sampled latency of the finished lines a writer hands to its output (private).
+	 *
+	 * Every write is counted; one in WriteCounters::SampleEvery is timed into the histogram
+	 * (the first one always is). Callers serialize Begin() / End() with the write itself.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE WriteCounters final {
+		public:
+			static constexpr std::uint64_t SampleEvery = 64;	///< One write in this many is timed
+
+			/**
+			 * @brief Count a write of @p bytes about to start.
+			 * @param bytes Size of the write.
+			 * @return Start instant to pass to End() if this write is timed, else 0.
+			 */
+			std::uint64_t Begin(std::size_t bytes) noexcept;
+
+			/**
+			 * @brief Finish a write started with Begin().
+			 * @param started Value returned by Begin().
+			 */
+			void End(std::uint64_t started) noexcept {
+				if (started != 0) [[unlikely]]
+					record(started);
+			}
+
+			/**
+			 * @brief Add the counts to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			void Collect(LogStats& stats) const noexcept;
+
+		private:
+			Counter m_writes;							///< Writes
+			Counter m_bytes;							///< Bytes written
+			std::array<Counter, LatencyHistogram::Buckets> m_latency;	///< Timed writes by duration bucket
+
+			/**
+			 * @brief Record the duration of a timed write.
+			 * @param started Start instant.
+			 */
+			void record(std::uint64_t started) noexcept;
+	};
+
+	/**
+	 * @class LockCounters
+	 * @brief Acquisitions of a line lock, with sampled wait and hold times (private).
+	 *
+	 * Each thread times one acquisition in LockCounters::SampleEvery (its first one
+	 * always); the totals reported are scaled to every acquisition.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE LockCounters final {
+		public:
+			static constexpr std::uint64_t SampleEvery = 64;	///< One acquisition in this many is timed, per thread
+
+			/**
+			 * @brief Acquire @p lock.
+			 * @param lock Line lock.
+			 * @return Instant it was acquired if this acquisition is timed, else 0; pass it to Unlock().
+			 */
+			std::uint64_t Lock(ThreadLock& lock) noexcept;
+
+			/**
+			 * @brief Release @p lock.
+			 * @param lock Line lock.
+			 * @param acquired Value returned by Lock().
+			 */
+			void Unlock(ThreadLock& lock, std::uint64_t acquired) noexcept;
+
+			/**
+			 * @brief Add the counts to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			void Collect(LogStats& stats) const noexcept;
+
+		private:
+			Counter m_acquisitions;						///< Acquisitions
+			Counter m_timed;							///< Timed acquisitions
+			Counter m_wait_ns;							///< Wait of the timed acquisitions
+			Counter m_hold_ns;							///< Hold time of the timed acquisitions
+	};
+
+	/**
+	 * @class StatsReport
+	 * @brief Schedule of the periodic stats line (see Log::ReportStats()) (private).
+	 */
+	class STORMBYTE_LOGGER_PRIVATE StatsReport final {
+		public:
+			/**
+			 * @brief Schedule the first report one @p interval from now.
+			 * @param interval Time between reports.
+			 * @param level Level the report is written at.
+			 */
+			StatsReport(std::chrono::nanoseconds interval, const Level& level) noexcept;
+
+			/**
+			 * @brief Whether a report is due; true for exactly one caller per interval.
+			 * @return true if the caller must write the report.
+			 */
+			bool Due() noexcept;
+
+			/**
+			 * @brief Level the report is written at.
+			 * @return The level.
+			 */
+			const Level& ReportLevel() const noexcept {
+				return m_level;
+			}
+
+		private:
+			const std::int64_t m_interval;				///< Nanoseconds between reports
+			const Level m_level;						///< Report level
+			std::atomic<std::int64_t> m_next;			///< Monotonic nanoseconds of the next report
+	};
+}
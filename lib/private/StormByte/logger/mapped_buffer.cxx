@@ -0,0 +1,323 @@
+#include <StormByte/logger/mapped_buffer.hxx>
+#include <StormByte/logger/segment_files.hxx>
+#include <StormByte/platform.h>
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifndef WINDOWS
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+using namespace StormByte::Logger;
+
+namespace {
+	constexpr std::size_t page_size = 4096;
+	constexpr std::size_t min_segment_size = 64 * 1024;
+	constexpr std::size_t max_segment_size = std::size_t{1} << 30;	// pbump() takes an int
+	constexpr std::size_t header_size = sizeof(SegmentHeader);
+	constexpr std::chrono::seconds create_retry_delay{ 1 };
+
+	SegmentHeader& header_of(char* map) noexcept {
+		return *reinterpret_cast<SegmentHeader*>(map);
+	}
+}
+
+MappedBuffer::MappedBuffer(const std::filesystem::path& path, std::size_t segment_size):
+	m_path(path),
+	m_size((std::clamp(segment_size, min_segment_size, max_segment_size) + page_size - 1) / page_size * page_size),
+	m_current(),
+	m_committed(0),
+	m_discard(),
+	m_segments(0),
+	m_stalls(0),
+	m_dropped(0),
+	m_next_index(SegmentFiles::NextIndex(path)),
+	m_newest_index(0),
+	m_spare(),
+	m_retired(),
+	m_create_failed(false),
+	m_stop(false) {
+	m_retired.reserve(4);
+	m_current = create();
+	if (m_current.map) {
+		m_newest_index = m_current.index;
+		m_segments.store(1, std::memory_order_relaxed);
+		setp(m_current.map + header_size, m_current.map + m_size);
+	} else {
+		setp(m_discard.data(), m_discard.data() + m_discard.size());
+	}
+	m_thread = std::thread(&MappedBuffer::run, this);
+}
+
+MappedBuffer::~MappedBuffer() noexcept {
+	Commit();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_current.map)
+			m_retired.push_back(m_current);
+		m_stop = true;
+	}
+	m_current = Segment();
+	m_wake.notify_one();
+	m_thread.join();
+	if (m_spare.map)
+		destroy(m_spare);
+}
+
+void MappedBuffer::Commit() noexcept {
+	if (m_current.map)
+		commit(static_cast<std::size_t>(pptr() - pbase()));
+}
+
+bool MappedBuffer::CrashDrain() noexcept {
+	const char* const begin = pbase();
+	const char* end = pptr();
+	if (!m_current.map || end == begin)
+		return true;
+	const bool complete = end[-1] == '\n';
+	while (end != begin && end[-1] != '\n')
+		--end;
+	commit(static_cast<std::size_t>(end - begin));
+	return complete;
+}
+
+void MappedBuffer::CrashWrite(const char* data, std::size_t size) noexcept {
+	if (!m_current.map || size > static_cast<std::size_t>(epptr() - pptr()))
+		return;
+	std::memcpy(pptr(), data, size);
+	pbump(static_cast<int>(size));
+	commit(static_cast<std::size_t>(pptr() - pbase()));
+}
+
+std::string MappedBuffer::Read(const std::filesystem::path& path) {
+	std::ifstream in(path, std::ios::binary);
+	SegmentHeader header{};
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != SegmentHeader::Magic
+		|| header.version != SegmentHeader::Version || header.header_size < sizeof(header))
+		return {};
+
+	in.seekg(header.header_size);
+	std::string text(static_cast<std::size_t>(std::min(header.committed, header.capacity)), '\0');
+	in.read(text.data(), static_cast<std::streamsize>(text.size()));
+	text.resize(static_cast<std::size_t>(in.gcount()));
+	return text;
+}
+
+MappedBuffer::int_type MappedBuffer::overflow(int_type ch) {
+	advance();
+	if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+		*pptr() = traits_type::to_char_type(ch);
+		pbump(1);
+	}
+	return traits_type::not_eof(ch);
+}
+
+std::streamsize MappedBuffer::xsputn(const char* s, std::streamsize count) {
+	// The previous call ended a record: publish it.
+	if (m_current.map && pptr() != pbase() && pptr()[-1] == '\n')
+		commit(static_cast<std::size_t>(pptr() - pbase()));
+
+	auto left = static_cast<std::size_t>(count);
+	while (left > 0) {
+		const auto room = static_cast<std::size_t>(epptr() - pptr());
+		if (room == 0) [[unlikely]] {
+			advance();
+			continue;
+		}
+		const auto chunk = std::min(room, left);
+		std::memcpy(pptr(), s, chunk);
+		pbump(static_cast<int>(chunk));
+		s += chunk;
+		left -= chunk;
+	}
+	return count;
+}
+
+int MappedBuffer::sync() {
+	if (m_current.map && pptr() != pbase() && pptr()[-1] == '\n')
+		commit(static_cast<std::size_t>(pptr() - pbase()));
+	return 0;
+}
+
+void MappedBuffer::commit(std::size_t length) noexcept {
+	m_committed = length;
+	std::atomic_ref<std::uint64_t>(header_of(m_current.map).committed).store(length, std::memory_order_release);
+}
+
+void MappedBuffer::advance() noexcept {
+	const auto written = static_cast<std::size_t>(pptr() - pbase());
+	if (!m_current.map)
+		m_dropped.fetch_add(written, std::memory_order_relaxed);
+
+	Segment next;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::swap(next, m_spare);
+	}
+	if (!next.map && m_current.map) {
+		// The maintenance thread has not caught up: pay for the segment here.
+		next = create();
+		if (next.map)
+			m_stalls.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	std::size_t carried = 0;
+	if (m_current.map) {
+		const std::size_t capacity = m_size - header_size;
+		carried = written - m_committed;
+		if (carried == capacity || !next.map) {
+			// A record larger than a segment is split; without a next segment it is lost.
+			if (next.map)
+				commit(written);
+			else
+				m_dropped.fetch_add(carried, std::memory_order_relaxed);
+			carried = 0;
+		}
+		if (carried > 0)
+			std::memcpy(next.map + header_size, pbase() + m_committed, carried);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_current.map)
+			m_retired.push_back(m_current);
+		if (next.map)
+			m_newest_index = next.index;
+	}
+	m_wake.notify_one();
+
+	m_current = next;
+	m_committed = 0;
+	if (m_current.map) {
+		m_segments.fetch_add(1, std::memory_order_relaxed);
+		setp(m_current.map + header_size, m_current.map + m_size);
+		pbump(static_cast<int>(carried));
+	} else {
+		setp(m_discard.data(), m_discard.data() + m_discard.size());
+	}
+}
+
+MappedBuffer::Segment MappedBuffer::create() noexcept {
+	Segment segment;
+#ifndef WINDOWS
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		segment.index = m_next_index++;
+	}
+	std::filesystem::path path;
+	try {
+		path = SegmentFiles::Path(m_path, segment.index);
+	} catch (...) {
+		return Segment();
+	}
+
+	const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+	if (fd < 0)
+		return Segment();
+#ifdef LINUX
+	const bool allocated = ::posix_fallocate(fd, 0, static_cast<off_t>(m_size)) == 0;
+#else
+	const bool allocated = ::ftruncate(fd, static_cast<off_t>(m_size)) == 0;
+#endif
+	void* map = allocated ? ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+	if (map == MAP_FAILED) {
+		::close(fd);
+		::unlink(path.c_str());
+		return Segment();
+	}
+
+	// Take the write faults here rather than on the writer.
+	bool populated = false;
+#ifdef MADV_POPULATE_WRITE
+	populated = ::madvise(map, m_size, MADV_POPULATE_WRITE) == 0;
+#endif
+	if (!populated) {
+		for (std::size_t offset = 0; offset < m_size; offset += page_size)
+			static_cast<volatile char*>(map)[offset] = 0;
+	}
+
+	// The file is zero-filled, so committed and the reserved words already read 0.
+	SegmentHeader& header = header_of(static_cast<char*>(map));
+	header.magic = SegmentHeader::Magic;
+	header.version = SegmentHeader::Version;
+	header.header_size = static_cast<std::uint32_t>(header_size);
+	header.index = segment.index;
+	header.capacity = m_size - header_size;
+
+	segment.fd = fd;
+	segment.map = static_cast<char*>(map);
+	segment.size = m_size;
+#endif
+	return segment;
+}
+
+void MappedBuffer::finish(const Segment& segment) noexcept {
+#ifndef WINDOWS
+	const std::uint64_t committed = std::atomic_ref<std::uint64_t>(header_of(segment.map).committed).load(std::memory_order_acquire);
+	const auto used = static_cast<std::size_t>(std::min<std::uint64_t>(header_size + committed, segment.size));
+	::msync(segment.map, used, MS_SYNC);
+	::madvise(segment.map, segment.size, MADV_DONTNEED);
+	::munmap(segment.map, segment.size);
+	// Drop the preallocated tail; readers still go by the committed length.
+	[[maybe_unused]] const int truncated = ::ftruncate(segment.fd, static_cast<off_t>(used));
+#ifdef POSIX_FADV_DONTNEED
+	::posix_fadvise(segment.fd, 0, 0, POSIX_FADV_DONTNEED);
+#endif
+	::close(segment.fd);
+#endif
+}
+
+void MappedBuffer::destroy(const Segment& segment) noexcept {
+#ifndef WINDOWS
+	::munmap(segment.map, segment.size);
+	::close(segment.fd);
+	std::error_code error;
+	std::filesystem::remove(SegmentFiles::Path(m_path, segment.index), error);
+#endif
+}
+
+void MappedBuffer::run() noexcept {
+	std::vector<Segment> retired;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		retired.assign(m_retired.begin(), m_retired.end());
+		m_retired.clear();
+		const bool need_spare = !m_stop && !m_spare.map;
+		lock.unlock();
+
+		for (const Segment& segment : retired)
+			finish(segment);
+		const Segment created = need_spare ? create() : Segment();
+
+		lock.lock();
+		if (need_spare) {
+			if (!created.map) {
+				m_create_failed = true;
+			} else if (created.index < m_newest_index || m_stop) {
+				// The writer created a newer segment itself meanwhile; segments must stay in order.
+				lock.unlock();
+				destroy(created);
+				lock.lock();
+			} else {
+				m_spare = created;
+			}
+		}
+		if (m_stop && m_retired.empty())
+			break;
+
+		const bool retry = m_create_failed;
+		const auto pending = [this, retry] {
+			return m_stop || !m_retired.empty() || (!retry && !m_spare.map);
+		};
+		if (retry) {
+			m_wake.wait_for(lock, create_retry_delay, pending);
+			m_create_failed = false;
+		} else {
+			m_wake.wait(lock, pending);
+		}
+	}
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct SegmentHeader
+	 * @brief First 64 bytes of every MappedFileSink segment (private).
+	 *
+	 * @c committed is stored with release ordering after the bytes it covers, so a reader
+	 * (or a recovery after a crash) trusts exactly @c committed bytes following the header.
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE SegmentHeader {
+		static constexpr std::array<char, 8> Magic = { 'S', 'B', 'L', 'O', 'G', 'S', 'E', 'G' };	///< Expected magic
+		static constexpr std::uint32_t Version = 1;		///< Current layout version
+
+		std::array<char, 8> magic;						///< SegmentHeader::Magic
+		std::uint32_t version;							///< Layout version
+		std::uint32_t header_size;						///< sizeof(SegmentHeader): data starts here
+		std::uint64_t index;							///< Segment index (N in `<path>.N`)
+		std::uint64_t capacity;							///< Data bytes available after the header
+		std::uint64_t committed;						///< Data bytes holding complete output
+		std::uint64_t reserved[3];						///< Zero
+	};
+	static_assert(sizeof(SegmentHeader) == 64);
+
+	/**
+	 * @class MappedBuffer
+	 * @brief Stream buffer whose put area is a memory-mapped, preallocated file segment (private).
+	 *
+	 * Stream writes are plain copies into mapped memory; at each record boundary the
+	 * segment header's committed length is advanced with a single store. When a segment
+	 * fills, the unfinished record moves to the next segment, which a maintenance thread
+	 * has already created, preallocated and mapped. The same thread syncs, releases and
+	 * trims finished segments, so the writing thread makes no system call unless the
+	 * next segment is not ready yet.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE MappedBuffer final: public std::streambuf {
+		public:
+			/**
+			 * @brief Create the first segment and start the maintenance thread.
+			 * @param path Base path; segments are `<path>.N`.
+			 * @param segment_size Segment file size in bytes (clamped to 64 KiB - 1 GiB).
+			 */
+			MappedBuffer(const std::filesystem::path& path, std::size_t segment_size);
+
+			MappedBuffer(const MappedBuffer&) = delete;
+			MappedBuffer(MappedBuffer&&) noexcept = delete;
+			MappedBuffer& operator=(const MappedBuffer&) = delete;
+			MappedBuffer& operator=(MappedBuffer&&) noexcept = delete;
+
+			/**
+			 * @brief Commit everything written, finish every segment and remove the unused spare.
+			 */
+			~MappedBuffer() noexcept override;
+
+			/**
+			 * @brief Whether output currently reaches a segment.
+			 * @return false while output is being discarded.
+			 */
+			bool IsOpen() const noexcept {
+				return m_current.map != nullptr;
+			}
+
+			/**
+			 * @brief Commit every byte written so far, complete record or not.
+			 */
+			void Commit() noexcept;
+
+			/**
+			 * @brief Commit every complete record from a fatal signal handler (memory stores only).
+			 * @return true if the written bytes end with a complete record.
+			 */
+			bool CrashDrain() noexcept;
+
+			/**
+			 * @brief Append and commit @p size bytes from a fatal signal handler, if the segment has room.
+			 * @param data Bytes to append.
+			 * @param size Number of bytes.
+			 */
+			void CrashWrite(const char* data, std::size_t size) noexcept;
+
+			/**
+			 * @brief Number of segments written to.
+			 * @return Segment count.
+			 */
+			std::uint64_t Segments() const noexcept {
+				return m_segments.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Number of times the writer had to create a segment itself.
+			 * @return Stall count.
+			 */
+			std::uint64_t Stalls() const noexcept {
+				return m_stalls.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Bytes discarded because no segment could be created.
+			 * @return Dropped byte count.
+			 */
+			std::uint64_t DroppedBytes() const noexcept {
+				return m_dropped.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Committed content of a segment file.
+			 * @param path Segment file.
+			 * @return The committed bytes; empty if the file is not a valid segment.
+			 */
+			static std::string Read(const std::filesystem::path& path);
+
+		protected:
+			int_type overflow(int_type ch) override;
+			std::streamsize xsputn(const char* s, std::streamsize count) override;
+			int sync() override;
+
+		private:
+			/**
+			 * @struct Segment
+			 * @brief A mapped segment file.
+			 */
+			struct Segment {
+				int fd = -1;							///< Open descriptor (for the final truncate)
+				char* map = nullptr;					///< Mapping of the whole file
+				std::size_t size = 0;					///< File and mapping size
+				std::uint64_t index = 0;				///< N in `<path>.N`
+			};
+
+			const std::filesystem::path m_path;			///< Base path
+			const std::size_t m_size;					///< Segment file size
+			Segment m_current;							///< Segment being written (writer)
+			std::size_t m_committed;					///< Committed data bytes of m_current (writer)
+			std::array<char, 4096> m_discard;			///< Put area while no segment is available
+			std::atomic<std::uint64_t> m_segments;		///< Segments written to
+			std::atomic<std::uint64_t> m_stalls;		///< Segments created by the writer
+			std::atomic<std::uint64_t> m_dropped;		///< Bytes discarded
+			std::mutex m_mutex;							///< Guards the fields below
+			std::condition_variable m_wake;				///< Wakes the maintenance thread
+			std::uint64_t m_next_index;					///< Index of the next segment to create
+			std::uint64_t m_newest_index;				///< Index of the newest segment written to
+			Segment m_spare;							///< Pre-created next segment (map == nullptr if none)
+			std::vector<Segment> m_retired;				///< Finished segments to release
+			bool m_create_failed;						///< Last creation failed: retry later
+			bool m_stop;								///< Shutdown requested
+			std::thread m_thread;						///< Maintenance thread (started last)
+
+			/**
+			 * @brief Set the committed length of the current segment.
+			 * @param length Data bytes.
+			 */
+			void commit(std::size_t length) noexcept;
+
+			/**
+			 * @brief Continue in the next segment, moving the unfinished record along.
+			 *
+			 * Falls back to the discard area if no segment can be had.
+			 */
+			void advance() noexcept;
+
+			/**
+			 * @brief Create, preallocate and map the next segment and write its header.
+			 * @return The segment; map == nullptr on failure.
+			 */
+			Segment create() noexcept;
+
+			/**
+			 * @brief Sync, release, trim and close a finished segment.
+			 * @param segment Segment to finish.
+			 */
+			static void finish(const Segment& segment) noexcept;
+
+			/**
+			 * @brief Unmap, close and delete a segment that was never written to.
+			 * @param segment Segment to discard.
+			 */
+			void destroy(const Segment& segment) noexcept;
+
+			/**
+			 * @brief Maintenance thread body.
+			 */
+			void run() noexcept;
+	};
+}
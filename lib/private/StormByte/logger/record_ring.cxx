@@ -0,0 +1,74 @@
+#include <StormByte/logger/record_ring.hxx>
+
+using namespace StormByte::Logger;
+
+namespace {
+	std::size_t round_capacity(std::size_t requested) noexcept {
+		std::size_t capacity = 2;
+		while (capacity < requested)
+			capacity <<= 1;
+		return capacity;
+	}
+}
+
+RecordRing::RecordRing(std::size_t capacity):
+	m_cells(std::make_unique<Cell[]>(round_capacity(capacity))),
+	m_mask(round_capacity(capacity) - 1),
+	m_enqueue(0),
+	m_dequeue(0) {
+	for (std::size_t i = 0; i <= m_mask; ++i)
+		m_cells[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+bool RecordRing::TryPush(std::string& record, std::uint64_t stamp) noexcept {
+	return push(record, [stamp]() noexcept { return stamp; });
+}
+
+bool RecordRing::TryPush(std::string& record, std::uint64_t (*stamp)() noexcept) noexcept {
+	return push(record, stamp);
+}
+
+template<class Stamp>
+bool RecordRing::push(std::string& record, Stamp stamp) noexcept {
+	std::size_t pos = m_enqueue.load(std::memory_order_relaxed);
+	for (;;) {
+		Cell& cell = m_cells[pos & m_mask];
+		const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+		const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+		if (diff == 0) {
+			if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				cell.data.swap(record);
+				cell.stamp = stamp();
+				record.clear();
+				cell.sequence.store(pos + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			pos = m_enqueue.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+bool RecordRing::TryPop(std::string& record, std::uint64_t& stamp) noexcept {
+	std::size_t pos = m_dequeue.load(std::memory_order_relaxed);
+	for (;;) {
+		Cell& cell = m_cells[pos & m_mask];
+		const std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+		const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+		if (diff == 0) {
+			if (m_dequeue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+				record.clear();
+				record.swap(cell.data);
+				stamp = cell.stamp;
+				cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (diff < 0) {
+			return false;
+		} else {
+			pos = m_dequeue.load(std::memory_order_relaxed);
+		}
+	}
+}
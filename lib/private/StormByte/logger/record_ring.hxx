@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class RecordRing
+	 * @brief Bounded lock-free queue of finished log records (private).
+	 *
+	 * Sequence-numbered ring (Vyukov style): any number of producers and consumers may
+	 * push/pop concurrently without locks. Records are exchanged by swapping strings, so
+	 * once every cell has been used the steady state does not allocate.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE RecordRing final {
+		public:
+			/**
+			 * @brief Construct a ring.
+			 * @param capacity Requested number of records (rounded up to a power of two, minimum 2).
+			 */
+			explicit RecordRing(std::size_t capacity);
+
+			RecordRing(const RecordRing&) = delete;
+			RecordRing(RecordRing&&) noexcept = delete;
+			RecordRing& operator=(const RecordRing&) = delete;
+			RecordRing& operator=(RecordRing&&) noexcept = delete;
+			~RecordRing() noexcept = default;
+
+			/**
+			 * @brief Try to enqueue a record.
+			 * @param record Record to enqueue; on success it is swapped with a cleared buffer.
+			 * @param stamp Value handed back with the record by TryPop().
+			 * @return false if the ring is full (record untouched).
+			 */
+			bool TryPush(std::string& record, std::uint64_t stamp = 0) noexcept;
+
+			/**
+			 * @brief Try to enqueue a record, stamping it only once its slot is claimed.
+			 *
+			 * However long the caller waited for room, the stamp is taken just before the
+			 * record becomes visible to TryPop().
+			 * @param record Record to enqueue; on success it is swapped with a cleared buffer.
+			 * @param stamp Called once, on success only; its result is handed back by TryPop().
+			 * @return false if the ring is full (record untouched, @p stamp not called).
+			 */
+			bool TryPush(std::string& record, std::uint64_t (*stamp)() noexcept) noexcept;
+
+			/**
+			 * @brief Try to dequeue the oldest record.
+			 * @param record Receives the record (its previous contents are recycled).
+			 * @param stamp Receives the stamp the record was pushed with.
+			 * @return false if the ring is empty.
+			 */
+			bool TryPop(std::string& record, std::uint64_t& stamp) noexcept;
+
+			/**
+			 * @brief Try to dequeue the oldest record, ignoring its stamp.
+			 * @param record Receives the record (its previous contents are recycled).
+			 * @return false if the ring is empty.
+			 */
+			bool TryPop(std::string& record) noexcept {
+				std::uint64_t stamp;
+				return TryPop(record, stamp);
+			}
+
+			/**
+			 * @brief Whether the ring currently holds no record.
+			 * @return true if a TryPop() issued now would fail.
+			 */
+			bool Empty() const noexcept {
+				const std::size_t pos = m_dequeue.load(std::memory_order_acquire);
+				return m_cells[pos & m_mask].sequence.load(std::memory_order_acquire) != pos + 1;
+			}
+
+			/**
+			 * @brief Number of pushes so far, including those still storing their record.
+			 * @return Slots claimed since construction, modulo the range of std::size_t.
+			 */
+			std::size_t Enqueued() const noexcept {
+				return m_enqueue.load(std::memory_order_acquire);
+			}
+
+			/**
+			 * @brief Effective capacity.
+			 * @return Number of records the ring can hold.
+			 */
+			std::size_t Capacity() const noexcept {
+				return m_mask + 1;
+			}
+
+		private:
+			struct Cell {
+				std::atomic<std::size_t> sequence;
+				std::string data;
+				std::uint64_t stamp;
+			};
+
+			std::unique_ptr<Cell[]> m_cells;					///< Ring storage
+			std::size_t m_mask;									///< Capacity - 1
+			alignas(64) std::atomic<std::size_t> m_enqueue;		///< Next enqueue position
+			alignas(64) std::atomic<std::size_t> m_dequeue;		///< Next dequeue position
+
+			/**
+			 * @brief Claim a slot and store @p record in it, stamped by @p stamp.
+			 * @param record Record to enqueue.
+			 * @param stamp Callable giving the stamp, called after the slot is claimed.
+			 * @return false if the ring is full.
+			 */
+			template<class Stamp>
+			bool push(std::string& record, Stamp stamp) noexcept;
+	};
+}
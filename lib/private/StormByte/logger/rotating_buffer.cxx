@@ -0,0 +1,164 @@
+#include <StormByte/logger/rotating_buffer.hxx>
+#include <StormByte/logger/segment_files.hxx>
+
+#include <string>
+
+using namespace StormByte::Logger;
+
+namespace {
+	constexpr std::chrono::seconds spare_retry_delay{ 1 };
+
+	// Open the active file, first completing a rotation interrupted between the switch and the renames.
+	int open_active(const std::filesystem::path& path) noexcept {
+		try {
+			const auto next = SegmentFiles::WithSuffix(path, ".next");
+			std::error_code error;
+			const auto spare_size = std::filesystem::file_size(next, error);
+			if (!error && spare_size > 0) {
+				if (std::filesystem::exists(path, error))
+					std::filesystem::rename(path, SegmentFiles::Path(path, SegmentFiles::NextIndex(path)), error);
+				std::filesystem::rename(next, path, error);
+			}
+		} catch (...) {}
+		return FileBuffer::OpenAppend(path);
+	}
+}
+
+RotatingBuffer::RotatingBuffer(const std::filesystem::path& path, const RotationOptions& options,
+							   std::size_t buffer_size, std::size_t flush_threshold, const FlushPolicy& policy):
+	FileBuffer(open_active(path), true, buffer_size, flush_threshold, policy),
+	m_path(path),
+	m_next_path(SegmentFiles::WithSuffix(path, ".next")),
+	m_options(options),
+	m_next_index(SegmentFiles::NextIndex(path)),
+	m_spare(-1),
+	m_retired(-1),
+	m_time_due(false),
+	m_rotations(0),
+	m_stop(false),
+	m_thread(&RotatingBuffer::run, this) {}
+
+RotatingBuffer::~RotatingBuffer() noexcept {
+	Drain();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_wake.notify_one();
+	m_thread.join();
+
+	const int spare = m_spare.exchange(-1, std::memory_order_acquire);
+	if (spare >= 0) {
+		Close(spare);
+		std::error_code error;
+		std::filesystem::remove(m_next_path, error);
+	}
+}
+
+std::streamsize RotatingBuffer::xsputn(const char* s, std::streamsize count) {
+	if (AtRecordBoundary())
+		rotate_if_due();
+	return FileBuffer::xsputn(s, count);
+}
+
+int RotatingBuffer::sync() {
+	const int result = FileBuffer::sync();
+	if (AtRecordBoundary())
+		rotate_if_due();
+	return result;
+}
+
+void RotatingBuffer::rotate_if_due() noexcept {
+	const std::uint64_t size = OutputSize();
+	const bool full = m_options.max_size > 0 && size >= m_options.max_size;
+	if (!full && !m_time_due.load(std::memory_order_relaxed)) [[likely]]
+		return;
+	if (size == 0) {
+		// Nothing written since the last rotation: an empty segment is not worth keeping.
+		m_time_due.store(false, std::memory_order_relaxed);
+		return;
+	}
+
+	// Only swap descriptors here; everything touching the file system is left to run().
+	const int spare = m_spare.exchange(-1, std::memory_order_acquire);
+	if (spare < 0)
+		return;
+	m_time_due.store(false, std::memory_order_relaxed);
+	m_retired.store(Replace(spare), std::memory_order_release);
+	m_rotations.fetch_add(1, std::memory_order_relaxed);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+	}
+	m_wake.notify_one();
+}
+
+void RotatingBuffer::retire(int fd) noexcept {
+	Close(fd);
+	try {
+		const auto segment = SegmentFiles::Path(m_path, m_next_index++);
+		std::error_code error;
+		std::filesystem::rename(m_path, segment, error);
+		const bool renamed = !error;
+		std::filesystem::rename(m_next_path, m_path, error);
+		if (renamed && m_options.on_rotate)
+			m_options.on_rotate(segment);
+	} catch (...) {}
+	prune();
+}
+
+void RotatingBuffer::prune() noexcept {
+	if (m_options.max_files == 0)
+		return;
+	try {
+		const auto segments = SegmentFiles::List(m_path);
+		if (segments.size() <= m_options.max_files)
+			return;
+		std::error_code error;
+		for (std::size_t i = 0; i < segments.size() - m_options.max_files; ++i)
+			std::filesystem::remove(segments[i].second, error);
+	} catch (...) {}
+}
+
+void RotatingBuffer::run() noexcept {
+	using clock = std::chrono::steady_clock;
+	const bool timed = m_options.interval.count() > 0;
+	auto deadline = clock::now() + m_options.interval;
+	const auto pending = [this] {
+		return m_stop || m_retired.load(std::memory_order_acquire) >= 0;
+	};
+
+	// Whether a spare must be opened. A writer can take the spare at any time, so an empty
+	// m_spare alone does not mean the previous one is done with: only its retired descriptor does.
+	bool need_spare = true;
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		const bool stopping = m_stop;
+		lock.unlock();
+
+		const int retired = m_retired.exchange(-1, std::memory_order_acquire);
+		if (retired >= 0) {
+			retire(retired);
+			need_spare = true;
+		}
+		if (!stopping && need_spare) {
+			const int spare = OpenAppend(m_next_path, true);
+			need_spare = spare < 0;
+			if (spare >= 0)
+				m_spare.store(spare, std::memory_order_release);
+		}
+		if (timed && clock::now() >= deadline) {
+			m_time_due.store(true, std::memory_order_relaxed);
+			deadline = clock::now() + m_options.interval;
+		}
+
+		lock.lock();
+		if (m_stop && m_retired.load(std::memory_order_acquire) < 0)
+			break;
+		if (need_spare)
+			m_wake.wait_for(lock, spare_retry_delay, pending);
+		else if (timed)
+			m_wake.wait_until(lock, deadline, pending);
+		else
+			m_wake.wait(lock, pending);
+	}
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/file_buffer.hxx>
+#include <StormByte/logger/rotating_file_sink.hxx>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class RotatingBuffer
+	 * @brief FileBuffer that switches to a new file at record boundaries (private).
+	 *
+	 * A maintenance thread keeps the next file open as `<path>.next`. Rotating only swaps
+	 * descriptors on the writing thread; closing the old file, renaming both files into
+	 * place, opening the following spare, the rotation hook and pruning all run on the
+	 * maintenance thread. If the spare is not ready yet the writer keeps appending to the
+	 * current file and retries at the next record boundary.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE RotatingBuffer final: public FileBuffer {
+		public:
+			/**
+			 * @brief Open @p path (finishing an interrupted rotation) and start the maintenance thread.
+			 * @param path Active file.
+			 * @param options Rotation triggers and retention.
+			 * @param buffer_size Buffer capacity in bytes.
+			 * @param flush_threshold Buffered bytes that trigger a write at the next record boundary.
+			 * @param policy Effect of stream flushes.
+			 */
+			RotatingBuffer(const std::filesystem::path& path, const RotationOptions& options,
+						   std::size_t buffer_size, std::size_t flush_threshold, const FlushPolicy& policy);
+
+			RotatingBuffer(const RotatingBuffer&) = delete;
+			RotatingBuffer(RotatingBuffer&&) noexcept = delete;
+			RotatingBuffer& operator=(const RotatingBuffer&) = delete;
+			RotatingBuffer& operator=(RotatingBuffer&&) noexcept = delete;
+
+			/**
+			 * @brief Write out buffered data, finish pending maintenance and remove the spare.
+			 */
+			~RotatingBuffer() noexcept override;
+
+			/**
+			 * @brief Number of rotations performed.
+			 * @return Rotation count.
+			 */
+			std::uint64_t Rotations() const noexcept {
+				return m_rotations.load(std::memory_order_relaxed);
+			}
+
+		protected:
+			std::streamsize xsputn(const char* s, std::streamsize count) override;
+			int sync() override;
+
+		private:
+			const std::filesystem::path m_path;			///< Active file
+			const std::filesystem::path m_next_path;	///< Spare file
+			const RotationOptions m_options;			///< Triggers, retention and hook
+			std::uint64_t m_next_index;					///< Index of the next segment (maintenance thread)
+			std::atomic<int> m_spare;					///< Pre-opened next file, -1 while being prepared
+			std::atomic<int> m_retired;					///< Descriptor of the rotated-out file, -1 if none
+			std::atomic<bool> m_time_due;				///< Rotation interval elapsed
+			std::atomic<std::uint64_t> m_rotations;		///< Rotations performed
+			std::mutex m_mutex;							///< Guards m_stop and the wake-up
+			std::condition_variable m_wake;				///< Wakes the maintenance thread
+			bool m_stop;								///< Shutdown requested
+			std::thread m_thread;						///< Maintenance thread (started last)
+
+			/**
+			 * @brief Switch to the spare file if a trigger fired. Called at record boundaries.
+			 */
+			void rotate_if_due() noexcept;
+
+			/**
+			 * @brief Close and rename the rotated-out file, put the spare in place and prepare the next one.
+			 * @param fd Rotated-out descriptor.
+			 */
+			void retire(int fd) noexcept;
+
+			/**
+			 * @brief Remove the oldest segments beyond RotationOptions::max_files.
+			 */
+			void prune() noexcept;
+
+			/**
+			 * @brief Maintenance thread body.
+			 */
+			void run() noexcept;
+	};
+}
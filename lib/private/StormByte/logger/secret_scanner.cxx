@@ -0,0 +1,499 @@
+#include <StormByte/logger/secret_scanner.hxx>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+using namespace StormByte::Logger;
+
+namespace {
+	enum CharClass : std::uint8_t {
+		Digit = 1,
+		Upper = 2,
+		Lower = 4,
+		HexLetter = 8,
+		Symbol = 16
+	};
+
+	// Word characters: base64 / base64url alphabet plus '-'.
+	constexpr auto char_classes = [] {
+		std::array<std::uint8_t, 256> classes{};
+		for (int c = '0'; c <= '9'; ++c) classes[c] = Digit;
+		for (int c = 'A'; c <= 'Z'; ++c) classes[c] = Upper;
+		for (int c = 'a'; c <= 'z'; ++c) classes[c] = Lower;
+		for (int c = 'A'; c <= 'F'; ++c) classes[c] |= HexLetter;
+		for (int c = 'a'; c <= 'f'; ++c) classes[c] |= HexLetter;
+		for (const char c : { '+', '/', '_', '-' }) classes[static_cast<unsigned char>(c)] = Symbol;
+		return classes;
+	}();
+
+	constexpr std::size_t min_encoded_length = 32;		// Hex and base64 runs
+	constexpr std::size_t min_prefixed_length = 20;		// Tokens with a known prefix
+	constexpr std::size_t min_bearer_length = 16;		// Token after "Bearer "
+	constexpr std::size_t max_key_length = 48;			// Longest word checked as a key
+	constexpr std::size_t min_card_digits = 13;
+	constexpr std::size_t max_card_digits = 19;
+
+	constexpr std::string_view secret_keys[] = {
+		"password", "passwd", "pwd", "pass", "passphrase", "secret", "token",
+		"apikey", "api_key", "api-key", "private_key", "private-key", "access_key", "access-key"
+	};
+
+	constexpr std::string_view token_prefixes[] = {
+		"AKIA", "ASIA", "ghp_", "gho_", "ghu_", "ghs_", "ghr_", "github_pat_", "glpat-",
+		"xoxb-", "xoxp-", "xoxa-", "sk_live_", "sk_test_", "rk_live_", "sk-"
+	};
+
+	std::uint8_t char_class(char c) noexcept {
+		return char_classes[static_cast<unsigned char>(c)];
+	}
+
+	char fold(char c) noexcept {
+		return c >= 'A' && c <= 'Z' ? static_cast<char>(c + ('a' - 'A')) : c;
+	}
+
+	bool iequals(std::string_view a, std::string_view b) noexcept {
+		if (a.size() != b.size())
+			return false;
+		for (std::size_t i = 0; i < a.size(); ++i) {
+			if (fold(a[i]) != fold(b[i]))
+				return false;
+		}
+		return true;
+	}
+
+	// Characters that end a value after a key or "Bearer ".
+	bool value_end(char c) noexcept {
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '"' || c == '\'' || c == '&' || c == ',' || c == ';';
+	}
+
+	bool quote(char c) noexcept {
+		return c == '"' || c == '\'';
+	}
+
+	std::size_t first_bit(std::uint64_t mask) noexcept {
+#if defined(_MSC_VER)
+		unsigned long bit;
+		_BitScanForward64(&bit, mask);
+		return bit;
+#else
+		return static_cast<std::size_t>(__builtin_ctzll(mask));
+#endif
+	}
+
+	std::size_t last_bit(std::uint64_t mask) noexcept {
+#if defined(_MSC_VER)
+		unsigned long bit;
+		_BitScanReverse64(&bit, mask);
+		return bit;
+#else
+		return static_cast<std::size_t>(63 - __builtin_clzll(mask));
+#endif
+	}
+
+	// Bits below @p count (up to 64).
+	std::uint64_t low_bits(std::size_t count) noexcept {
+		return count >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1;
+	}
+
+	// Per-byte classes of a 64 byte window, bit i for byte i.
+	struct Window {
+		std::uint64_t word = 0;						///< Word characters
+		std::uint64_t digit = 0;
+		std::uint64_t separator = 0;				///< '=' ':' '"' '\''
+		std::uint64_t space = 0;
+		std::uint64_t b = 0;						///< 'b' or 'B' ("Bearer")
+	};
+
+#if defined(__AVX2__)
+	void classify_32(const char* data, Window& window, unsigned shift) noexcept {
+		const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data));
+		const __m256i lower = _mm256_or_si256(chunk, _mm256_set1_epi8(0x20));
+		// Unsigned c - lo <= n  <=>  max(c - lo, n) == n
+		const __m256i letters = _mm256_sub_epi8(lower, _mm256_set1_epi8('a'));
+		const __m256i digits = _mm256_sub_epi8(chunk, _mm256_set1_epi8('0'));
+		const __m256i alpha = _mm256_cmpeq_epi8(_mm256_max_epu8(letters, _mm256_set1_epi8(25)), _mm256_set1_epi8(25));
+		const __m256i digit = _mm256_cmpeq_epi8(_mm256_max_epu8(digits, _mm256_set1_epi8(9)), _mm256_set1_epi8(9));
+		const __m256i symbol = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('+')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('/'))),
+			_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('_')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('-'))));
+		const __m256i separator = _mm256_or_si256(
+			_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('=')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(':'))),
+			_mm256_or_si256(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8('\''))));
+		const auto bits = [](__m256i v) {
+			return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(v)));
+		};
+		window.word |= bits(_mm256_or_si256(_mm256_or_si256(alpha, digit), symbol)) << shift;
+		window.digit |= bits(digit) << shift;
+		window.separator |= bits(separator) << shift;
+		window.space |= bits(_mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(' '))) << shift;
+		window.b |= bits(_mm256_cmpeq_epi8(lower, _mm256_set1_epi8('b'))) << shift;
+	}
+#elif defined(__SSE2__) || defined(_M_X64)
+	void classify_16(const char* data, Window& window, unsigned shift) noexcept {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+		const __m128i lower = _mm_or_si128(chunk, _mm_set1_epi8(0x20));
+		const __m128i letters = _mm_sub_epi8(lower, _mm_set1_epi8('a'));
+		const __m128i digits = _mm_sub_epi8(chunk, _mm_set1_epi8('0'));
+		const __m128i alpha = _mm_cmpeq_epi8(_mm_max_epu8(letters, _mm_set1_epi8(25)), _mm_set1_epi8(25));
+		const __m128i digit = _mm_cmpeq_epi8(_mm_max_epu8(digits, _mm_set1_epi8(9)), _mm_set1_epi8(9));
+		const __m128i symbol = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('+')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('/'))),
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('_')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('-'))));
+		const __m128i separator = _mm_or_si128(
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('=')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(':'))),
+			_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')), _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\''))));
+		const auto bits = [](__m128i v) {
+			return static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm_movemask_epi8(v)));
+		};
+		window.word |= bits(_mm_or_si128(_mm_or_si128(alpha, digit), symbol)) << shift;
+		window.digit |= bits(digit) << shift;
+		window.separator |= bits(separator) << shift;
+		window.space |= bits(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(' '))) << shift;
+		window.b |= bits(_mm_cmpeq_epi8(lower, _mm_set1_epi8('b'))) << shift;
+	}
+#endif
+	void classify_scalar(const char* data, std::size_t width, Window& window) noexcept {
+		for (std::size_t i = 0; i < width; ++i) {
+			const char c = data[i];
+			const std::uint64_t bit = std::uint64_t{1} << i;
+			const std::uint8_t type = char_class(c);
+			if (type)
+				window.word |= bit;
+			if (type == Digit)
+				window.digit |= bit;
+			if (c == '=' || c == ':' || quote(c))
+				window.separator |= bit;
+			if (c == ' ')
+				window.space |= bit;
+			if (fold(c) == 'b')
+				window.b |= bit;
+		}
+	}
+
+	Window classify(const char* data, std::size_t width) noexcept {
+		Window window;
+#if defined(__AVX2__)
+		if (width == 64) {
+			classify_32(data, window, 0);
+			classify_32(data + 32, window, 32);
+			return window;
+		}
+#elif defined(__SSE2__) || defined(_M_X64)
+		if (width == 64) {
+			for (unsigned part = 0; part < 4; ++part)
+				classify_16(data + part * 16, window, part * 16);
+			return window;
+		}
+#endif
+		classify_scalar(data, width, window);
+		return window;
+	}
+
+	// Call on_word(start, end) for every word (maximal run of word characters) at or after @p from
+	// that can be, or be part of, a secret; the others can be skipped as they never match:
+	// - digit words of 13+ characters or next to another digit word (card groups);
+	// - words followed by a separator (keys);
+	// - six character words starting with 'b' ("Bearer");
+	// - words of 20+ characters (prefixed tokens, hex, base64);
+	// - words crossing a window edge.
+	template <typename F>
+	void for_each_candidate(std::string_view text, std::size_t from, F&& on_word) {
+		const char* const data = text.data();
+		const std::size_t size = text.size();
+		constexpr std::size_t none = static_cast<std::size_t>(-1);
+		std::size_t start = none;						// Word carried over from the previous window
+
+		for (std::size_t base = from; base < size; base += 64) {
+			const std::size_t width = size - base < 64 ? size - base : 64;
+			const Window window = classify(data + base, width);
+			const std::uint64_t word = window.word;
+
+			std::uint64_t done = 0;						// Bits of words already handled
+			if (start != none) {
+				if (~word & low_bits(width)) {
+					const std::size_t end = first_bit(~word);
+					on_word(start, base + end);
+					start = none;
+					done = low_bits(end);
+				} else {
+					continue;
+				}
+			}
+
+			// A word reaching the last bit of a full window continues in the next one.
+			std::size_t trailing = 64;
+			if (width == 64 && (word >> 63))
+				trailing = ~word ? last_bit(~word) + 1 : 0;
+
+			const std::uint64_t starts = word & ~(word << 1) & ~done;
+			const std::uint64_t ends = word & ~(word >> 1);
+			std::uint64_t run = word & (word >> 1);
+			run &= run >> 2;
+			run &= run >> 4;
+			const std::uint64_t run12 = run & (run >> 4);
+			const std::uint64_t digit_starts = starts & window.digit;
+			const std::uint64_t digit_ends = ends & window.digit;
+			// Digit word end, one space, digit word start: both words may be card groups.
+			const std::uint64_t pairs = digit_ends & (window.space >> 1) & (digit_starts >> 2);
+
+			std::uint64_t flags = ((window.separator & (word << 1)) >> 1)
+				| (starts & window.b & (ends >> 5))
+				| (digit_starts & ((run12 & (word >> 12)) | (pairs << 2) | 3))
+				| pairs
+				| (digit_ends & (std::uint64_t{1} << 62))
+				| (run12 & (run >> 12));
+			flags &= ~done & low_bits(trailing);
+
+			while (flags) {
+				const std::size_t bit = first_bit(flags);
+				const std::size_t word_start = last_bit(starts & low_bits(bit + 1));
+				const std::size_t word_end = first_bit(ends & ~low_bits(bit)) + 1;
+				on_word(base + word_start, base + word_end);
+				flags &= ~low_bits(word_end);
+			}
+			if (trailing < 64)
+				start = base + trailing;
+		}
+		if (start != none)
+			on_word(start, size);
+	}
+
+	// One Mask() call: finds the secrets of a token and masks them in a copy.
+	class Masker final {
+		public:
+			Masker(std::string_view text, std::string& buffer) noexcept:
+				m_text(text), m_buffer(buffer), m_copied(false), m_failed(false), m_pending(false),
+				m_skip_until(0), m_chain_start(0), m_chain_end(0), m_chain_digits(0), m_chain(false) {}
+
+			bool Pending() const noexcept {
+				return m_pending;
+			}
+
+			void Mask(std::size_t offset, std::size_t length) noexcept {
+				if (length == 0 || !copy())
+					return;
+				std::memset(m_buffer.data() + offset, '*', length);
+			}
+
+			// Mask the value starting at or after @p position; a missing value is pending.
+			std::size_t Value(std::size_t position, std::size_t min_length = 0) noexcept {
+				const std::size_t size = m_text.size();
+				while (position < size && m_text[position] == ' ')
+					++position;
+				if (position < size && quote(m_text[position]))
+					++position;
+				if (position == size) {
+					m_pending = true;
+					return size;
+				}
+				std::size_t end = position;
+				while (end < size && !value_end(m_text[end]))
+					++end;
+				if (end - position >= min_length)
+					Mask(position, end - position);
+				m_skip_until = end;
+				return end;
+			}
+
+			void Scan(std::size_t from) {
+				for_each_candidate(m_text, from, [this](std::size_t start, std::size_t end) { word(start, end); });
+				end_chain();
+			}
+
+			// Result view: the text itself, its masked copy, or a placeholder if copying failed.
+			bool Result(std::string_view& text) noexcept {
+				if (m_failed) {
+					text = "***";
+					return true;
+				}
+				if (!m_copied)
+					return false;
+				text = m_buffer;
+				return true;
+			}
+
+		private:
+			std::string_view m_text;
+			std::string& m_buffer;
+			bool m_copied;
+			bool m_failed;
+			bool m_pending;
+			std::size_t m_skip_until;					// Words before this offset are already masked
+			std::size_t m_chain_start;					// Digit groups of a card-like number
+			std::size_t m_chain_end;
+			std::size_t m_chain_digits;
+			bool m_chain;
+
+			bool copy() noexcept {
+				if (!m_copied && !m_failed) {
+					try {
+						m_buffer.assign(m_text);
+						m_copied = true;
+					} catch (...) {
+						m_failed = true;
+					}
+				}
+				return m_copied;
+			}
+
+			void word(std::size_t start, std::size_t end) noexcept {
+				if (start < m_skip_until)
+					return;
+				const std::string_view word = m_text.substr(start, end - start);
+
+				if (char_class(word.front()) == Digit) {
+					// Digit groups ("4111", "4111-1111-...") joined by single spaces form one candidate.
+					std::size_t digits = 0;
+					bool group = char_class(word.back()) == Digit;
+					for (const char c : word) {
+						if (char_class(c) == Digit)
+							++digits;
+						else if (c != '-')
+							group = false;
+					}
+					if (group && digits <= max_card_digits) {
+						if (m_chain && start == m_chain_end + 1 && m_text[m_chain_end] == ' '
+							&& m_chain_digits + digits <= max_card_digits) {
+							m_chain_end = end;
+							m_chain_digits += digits;
+						} else {
+							end_chain();
+							m_chain = true;
+							m_chain_start = start;
+							m_chain_end = end;
+							m_chain_digits = digits;
+						}
+						return;
+					}
+				}
+				end_chain();
+
+				const std::size_t size = m_text.size();
+				if (word.size() <= max_key_length && end < size) {
+					const char next = m_text[end];
+					if (word.size() == 6 && next == ' ' && iequals(word, "bearer")) {
+						Value(end, min_bearer_length);
+						return;
+					}
+					if ((next == '=' || next == ':' || quote(next)) && SecretScanner::IsSecretKey(word) && key_value(end))
+						return;
+				}
+
+				if (word.size() >= min_prefixed_length) {
+					for (const std::string_view prefix : token_prefixes) {
+						if (prefix.front() == word.front() && word.starts_with(prefix)) {
+							Mask(start, word.size());
+							return;
+						}
+					}
+				}
+
+				if (word.size() >= min_encoded_length && encoded(word)) {
+					std::size_t padded = end;
+					while (padded < size && padded - end < 2 && m_text[padded] == '=')
+						++padded;
+					Mask(start, padded - start);
+				}
+			}
+
+			// After a secret-like key: optional closing quote, spaces, '=' or ':', then the value.
+			bool key_value(std::size_t position) noexcept {
+				const std::size_t size = m_text.size();
+				if (quote(m_text[position]))
+					++position;
+				while (position < size && m_text[position] == ' ')
+					++position;
+				if (position == size || (m_text[position] != '=' && m_text[position] != ':'))
+					return false;
+				Value(position + 1);
+				return true;
+			}
+
+			// Random-looking hex or base64: the character classes change often, unlike in identifiers or paths.
+			static bool encoded(std::string_view word) noexcept {
+				std::uint8_t seen = 0;
+				bool hex = true;
+				std::size_t symbols = 0, changes = 0;
+				std::uint8_t previous = 0;
+				for (const char c : word) {
+					const std::uint8_t type = char_class(c);
+					seen |= type;
+					hex = hex && (type & (Digit | HexLetter));
+					symbols += type == Symbol;
+					const std::uint8_t kind = type & (Digit | Upper | Lower | Symbol);
+					changes += kind != previous;
+					previous = kind;
+				}
+				if (hex)
+					return (seen & Digit) && (seen & HexLetter);
+				return (seen & Digit) && (seen & Upper) && (seen & Lower)
+					&& symbols * 8 <= word.size() && changes * 2 >= word.size();
+			}
+
+			void end_chain() noexcept {
+				if (!m_chain)
+					return;
+				m_chain = false;
+				if (m_chain_digits < min_card_digits || m_text[m_chain_start] < '2' || m_text[m_chain_start] > '6')
+					return;
+
+				// Luhn: double every second digit from the right.
+				unsigned sum = 0;
+				bool twice = false;
+				for (std::size_t i = m_chain_end; i-- > m_chain_start;) {
+					if (char_class(m_text[i]) != Digit)
+						continue;
+					unsigned digit = static_cast<unsigned>(m_text[i] - '0');
+					if (twice && (digit *= 2) > 9)
+						digit -= 9;
+					sum += digit;
+					twice = !twice;
+				}
+				if (sum % 10 != 0 || !copy())
+					return;
+				for (std::size_t i = m_chain_start; i < m_chain_end; ++i) {
+					if (char_class(m_text[i]) == Digit)
+						m_buffer[i] = '*';
+				}
+			}
+	};
+}
+
+bool SecretScanner::Mask(std::string_view& text, std::string& buffer) noexcept {
+	Masker masker(text, buffer);
+	std::size_t from = 0;
+	const Pending pending = m_pending;
+	m_pending = Pending::None;
+	if (pending == Pending::Whole) {
+		masker.Mask(0, text.size());
+		return masker.Result(text);
+	}
+	if (pending == Pending::Value)
+		from = masker.Value(0);
+
+	try {
+		masker.Scan(from);
+	} catch (...) {}
+	if (masker.Pending())
+		m_pending = Pending::Value;
+	return masker.Result(text);
+}
+
+bool SecretScanner::IsSecretKey(std::string_view name) noexcept {
+	for (const std::string_view key : secret_keys) {
+		if (name.size() < key.size() || !iequals(name.substr(name.size() - key.size()), key))
+			continue;
+		// Whole name or its last component: "password", "db_password", "x-api-key".
+		if (name.size() == key.size())
+			return true;
+		const char separator = name[name.size() - key.size() - 1];
+		if (separator == '_' || separator == '-' || separator == '.')
+			return true;
+	}
+	return false;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class SecretScanner
+	 * @brief Detects and masks common secrets in text tokens (private).
+	 *
+	 * One pass splits the text into words (letters, digits, `+ / _ -`): 64 byte windows are
+	 * classified with AVX2 or SSE2 into bitmasks, from which only the words that can be a
+	 * secret are picked and looked at further:
+	 * - the value after a secret-like key (`password=`, `"api_key": `, `db_secret:`...);
+	 * - the token after `Bearer `;
+	 * - tokens with a well-known prefix (`AKIA`, `ghp_`, `xoxb-`, `sk_live_`...);
+	 * - hex runs of 32+ characters and base64 runs of 32+ characters mixing cases and digits;
+	 * - 13 to 19 digit groups, plain or separated by single spaces or dashes, that pass the
+	 *   Luhn check.
+	 *
+	 * Every masked character becomes '*', so lengths are preserved. A key at the end of one
+	 * token applies to the start of the next token of the same line.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE SecretScanner final {
+		public:
+			/**
+			 * @brief Construct a scanner with nothing pending.
+			 */
+			SecretScanner() noexcept: m_pending(Pending::None) {}
+
+			/**
+			 * @brief Mask the secrets of a text token.
+			 * @param text Token; replaced by a view of @p buffer when something was masked.
+			 * @param buffer Reusable storage for the masked copy.
+			 * @return true if @p text was replaced.
+			 */
+			bool Mask(std::string_view& text, std::string& buffer) noexcept;
+
+			/**
+			 * @brief The next text token is entirely a secret (value of a secret-like field key).
+			 */
+			void Expect() noexcept {
+				m_pending = Pending::Whole;
+			}
+
+			/**
+			 * @brief Forget a pending key: a non-text value was written or the line ended.
+			 */
+			void Clear() noexcept {
+				m_pending = Pending::None;
+			}
+
+			/**
+			 * @brief Whether @p name looks like the key of a secret (`password`, `db_password`, `x-api-key`...).
+			 * @param name Key, compared case-insensitively.
+			 * @return true if values under @p name should be masked.
+			 */
+			static bool IsSecretKey(std::string_view name) noexcept;
+
+		private:
+			/**
+			 * @enum Pending
+			 * @brief What the previous token left for the next one.
+			 */
+			enum class Pending : std::uint8_t {
+				None,									///< Nothing
+				Value,									///< A value run (key with separator ended the token)
+				Whole									///< The whole token (field key)
+			};
+
+			Pending m_pending;							///< Carried over to the next token
+	};
+}
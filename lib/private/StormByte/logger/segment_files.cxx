@@ -0,0 +1,42 @@
+#include <StormByte/logger/segment_files.hxx>
+
+#include <algorithm>
+#include <charconv>
+
+using namespace StormByte::Logger;
+
+std::filesystem::path SegmentFiles::WithSuffix(const std::filesystem::path& path, const std::string& suffix) {
+	std::filesystem::path result = path;
+	result += suffix;
+	return result;
+}
+
+std::filesystem::path SegmentFiles::Path(const std::filesystem::path& path, std::uint64_t index) {
+	return WithSuffix(path, "." + std::to_string(index));
+}
+
+std::vector<std::pair<std::uint64_t, std::filesystem::path>> SegmentFiles::List(const std::filesystem::path& path) {
+	std::vector<std::pair<std::uint64_t, std::filesystem::path>> segments;
+	const std::string prefix = path.filename().string() + ".";
+	const auto directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+	std::error_code error;
+	for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+		const std::string name = it->path().filename().string();
+		if (name.size() <= prefix.size() || name.compare(0, prefix.size(), prefix) != 0)
+			continue;
+		std::uint64_t index = 0;
+		const char* first = name.data() + prefix.size();
+		const char* last = name.data() + name.size();
+		const auto [end_of_number, ec] = std::from_chars(first, last, index);
+		if (ec != std::errc() || (end_of_number != last && *end_of_number != '.'))
+			continue;
+		segments.emplace_back(index, it->path());
+	}
+	std::sort(segments.begin(), segments.end());
+	return segments;
+}
+
+std::uint64_t SegmentFiles::NextIndex(const std::filesystem::path& path) {
+	const auto segments = List(path);
+	return segments.empty() ? 1 : segments.back().first + 1;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct SegmentFiles
+	 * @brief Naming of numbered log segments, `<path>.<N>` (private).
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE SegmentFiles {
+		/**
+		 * @brief @p path with @p suffix appended to its file name.
+		 * @param path Base path.
+		 * @param suffix Text to append, e.g. ".next".
+		 * @return The new path.
+		 */
+		static std::filesystem::path WithSuffix(const std::filesystem::path& path, const std::string& suffix);
+
+		/**
+		 * @brief Path of segment @p index of @p path.
+		 * @param path Base path.
+		 * @param index Segment index.
+		 * @return `<path>.<index>`.
+		 */
+		static std::filesystem::path Path(const std::filesystem::path& path, std::uint64_t index);
+
+		/**
+		 * @brief Existing segments of @p path, oldest first.
+		 *
+		 * Matches `<name>.N` as well as files derived from a segment such as `<name>.N.gz`.
+		 * @param path Base path.
+		 * @return Pairs of segment index and path, sorted by index.
+		 */
+		static std::vector<std::pair<std::uint64_t, std::filesystem::path>> List(const std::filesystem::path& path);
+
+		/**
+		 * @brief Index following the newest existing segment of @p path.
+		 * @param path Base path.
+		 * @return 1 if there is none.
+		 */
+		static std::uint64_t NextIndex(const std::filesystem::path& path);
+	};
+}
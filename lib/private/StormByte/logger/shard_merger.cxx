@@ -0,0 +1,214 @@
+#include <StormByte/logger/shard_merger.hxx>
+#include <StormByte/platform.h>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#if defined(LINUX)
+#include <sched.h>
+#endif
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Safety net only: producers wake the merger explicitly.
+	constexpr auto idle_timeout = std::chrono::milliseconds(50);
+
+	std::uint64_t steady_ns() noexcept {
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	// Strictly increasing per thread, so a thread's lines never tie or reorder.
+	std::uint64_t line_stamp() noexcept {
+		thread_local std::uint64_t t_last = 0;
+		std::uint64_t stamp = steady_ns();
+		if (stamp <= t_last)
+			stamp = t_last + 1;
+		t_last = stamp;
+		return stamp;
+	}
+
+	// Min-heap order for std::push_heap / std::pop_heap: oldest stamp first, then arrival.
+	template<class Pending>
+	bool later(const Pending& a, const Pending& b) noexcept {
+		return a.stamp != b.stamp ? a.stamp > b.stamp : a.arrival > b.arrival;
+	}
+}
+
+ShardMerger::ShardMerger(std::ostream& out, const ShardOptions& options):
+	m_out(out),
+	m_skew_ns(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(options.skew).count())),
+	m_shards(),
+	m_pending(),
+	m_spare(),
+	m_arrivals(0),
+	m_sleeping(false),
+	m_stop(false),
+	m_flushes(0),
+	m_flushed(0),
+	m_high_water(0),
+	m_writes() {
+	std::size_t shards = options.shards;
+	if (shards == 0)
+		shards = std::max(1u, std::thread::hardware_concurrency());
+	m_shards.reserve(shards);
+	for (std::size_t i = 0; i < shards; ++i)
+		m_shards.push_back(std::make_unique<RecordRing>(options.capacity));
+	m_thread = std::thread(&ShardMerger::run, this);
+}
+
+ShardMerger::~ShardMerger() noexcept {
+	m_stop.store(true, std::memory_order_release);
+	wake(true);
+	if (m_thread.joinable())
+		m_thread.join();
+}
+
+void ShardMerger::Push(std::string& line) noexcept {
+	// Stamped once the slot is claimed: time spent waiting on a full shard must not make the
+	// line older than lines other shards already released.
+	RecordRing& shard = *m_shards[shard_index()];
+	while (!shard.TryPush(line, line_stamp)) {
+		wake(true);
+		std::this_thread::yield();
+	}
+	wake();
+}
+
+void ShardMerger::Flush() noexcept {
+	const std::uint64_t request = m_flushes.fetch_add(1, std::memory_order_acq_rel) + 1;
+	wake(true);
+
+	std::uint64_t flushed = m_flushed.load(std::memory_order_acquire);
+	while (flushed < request) {
+		m_flushed.wait(flushed, std::memory_order_acquire);
+		flushed = m_flushed.load(std::memory_order_acquire);
+	}
+}
+
+void ShardMerger::Collect(LogStats& stats) const noexcept {
+	m_writes.Collect(stats);
+	stats.queue_high_water = std::max(stats.queue_high_water, m_high_water.load(std::memory_order_relaxed));
+}
+
+std::size_t ShardMerger::shard_index() const noexcept {
+#if defined(LINUX)
+	const int cpu = sched_getcpu();
+	if (cpu >= 0)
+		return static_cast<std::size_t>(cpu) % m_shards.size();
+#endif
+	// No CPU number: spread threads over the shards in the order they first log.
+	static std::atomic<std::size_t> s_next(0);
+	thread_local const std::size_t t_slot = s_next.fetch_add(1, std::memory_order_relaxed);
+	return t_slot % m_shards.size();
+}
+
+bool ShardMerger::empty() const noexcept {
+	return std::all_of(m_shards.begin(), m_shards.end(), [](const std::unique_ptr<RecordRing>& shard) {
+		return shard->Empty();
+	});
+}
+
+std::size_t ShardMerger::gather() noexcept {
+	std::size_t taken = 0;
+	for (const auto& shard : m_shards) {
+		// At most one ring's worth per pass, so a busy shard cannot starve the output.
+		for (std::size_t i = 0; i < shard->Capacity(); ++i) {
+			std::string text;
+			if (!m_spare.empty()) {
+				text.swap(m_spare.back());
+				m_spare.pop_back();
+			}
+			std::uint64_t stamp;
+			if (!shard->TryPop(text, stamp)) {
+				m_spare.push_back(std::move(text));
+				break;
+			}
+			m_pending.push_back({ stamp, m_arrivals++, std::move(text) });
+			std::push_heap(m_pending.begin(), m_pending.end(), later<Pending>);
+			++taken;
+		}
+	}
+	if (m_pending.size() > m_high_water.load(std::memory_order_relaxed))
+		m_high_water.store(m_pending.size(), std::memory_order_relaxed);
+	return taken;
+}
+
+std::size_t ShardMerger::release(std::uint64_t until) noexcept {
+	std::size_t written = 0;
+	while (!m_pending.empty() && m_pending.front().stamp <= until) {
+		std::pop_heap(m_pending.begin(), m_pending.end(), later<Pending>);
+		std::string& text = m_pending.back().text;
+		const std::uint64_t started = m_writes.Begin(text.size());
+		try {
+			m_out.write(text.data(), static_cast<std::streamsize>(text.size()));
+		} catch (...) {}
+		m_writes.End(started);
+		text.clear();
+		m_spare.push_back(std::move(text));
+		m_pending.pop_back();
+		++written;
+	}
+	return written;
+}
+
+void ShardMerger::wake(bool always) noexcept {
+	// Pairs with the fence in run(): either we see m_sleeping or the merger sees our line.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	if (always || m_sleeping.load(std::memory_order_relaxed)) {
+		std::lock_guard<std::mutex> lock(m_wake_mutex);
+		m_wake.notify_one();
+	}
+}
+
+void ShardMerger::run() noexcept {
+	std::uint64_t served = 0;
+	bool dirty = false;
+
+	for (;;) {
+		const std::uint64_t requested = m_flushes.load(std::memory_order_acquire);
+		const bool stopping = m_stop.load(std::memory_order_acquire);
+		// Lines committed before the request or the stop are visible to this gather.
+		const std::size_t taken = gather();
+
+		const bool everything = stopping || requested != served;
+		const std::uint64_t now = steady_ns();
+		const std::size_t written = release(everything ? std::numeric_limits<std::uint64_t>::max()
+													   : (now > m_skew_ns ? now - m_skew_ns : 0));
+		dirty = dirty || written > 0;
+		// Flush when asked to, or before going idle.
+		if (dirty && (everything || (taken == 0 && m_pending.empty()))) {
+			try {
+				m_out.flush();
+			} catch (...) {}
+			dirty = false;
+		}
+		if (requested != served) {
+			served = requested;
+			m_flushed.store(served, std::memory_order_release);
+			m_flushed.notify_all();
+		}
+		if (stopping && m_pending.empty() && empty())
+			break;
+		if (written > 0)
+			continue;
+
+		std::unique_lock<std::mutex> lock(m_wake_mutex);
+		if (m_stop.load(std::memory_order_acquire) || m_flushes.load(std::memory_order_acquire) != served)
+			continue;
+		if (!m_pending.empty()) {
+			// The oldest line's window closes first; new lines are gathered then.
+			const std::uint64_t due = m_pending.front().stamp + m_skew_ns;
+			m_wake.wait_until(lock, std::chrono::steady_clock::time_point(
+				std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(due))));
+			continue;
+		}
+		m_sleeping.store(true, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (empty())
+			m_wake.wait_for(lock, idle_timeout);
+		m_sleeping.store(false, std::memory_order_relaxed);
+	}
+}
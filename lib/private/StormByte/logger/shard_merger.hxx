@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/log_counters.hxx>
+#include <StormByte/logger/record_ring.hxx>
+#include <StormByte/logger/shard_options.hxx>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class ShardMerger
+	 * @brief Per-CPU line queues merged by time into one stream (private).
+	 *
+	 * Producers push each finished line into the RecordRing of the CPU they run on (of their
+	 * thread slot where the CPU is unknown): no lock and no cache line shared by every
+	 * producer. A line is stamped with a per-thread strictly increasing monotonic time once
+	 * its slot is claimed, so waiting on a full shard does not age it. A merger
+	 * thread moves queued lines into a min-heap and writes those older than the skew window
+	 * in stamp order. Flush() and destruction write everything queued regardless of age.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE ShardMerger final {
+		public:
+			/**
+			 * @brief Construct the shards and start the merger thread.
+			 * @param out Output stream written by the merger only.
+			 * @param options Shard count, capacity and skew window.
+			 */
+			ShardMerger(std::ostream& out, const ShardOptions& options);
+
+			ShardMerger(const ShardMerger&) = delete;
+			ShardMerger(ShardMerger&&) noexcept = delete;
+			ShardMerger& operator=(const ShardMerger&) = delete;
+			ShardMerger& operator=(ShardMerger&&) noexcept = delete;
+
+			/**
+			 * @brief Write every queued line and join the merger thread.
+			 */
+			~ShardMerger() noexcept;
+
+			/**
+			 * @brief Queue a finished line in the caller's shard, waiting while it is full, and stamp it once queued.
+			 * @param line Line text; swapped with a cleared buffer.
+			 */
+			void Push(std::string& line) noexcept;
+
+			/**
+			 * @brief Wait until every line queued so far is written, then flush the stream.
+			 */
+			void Flush() noexcept;
+
+			/**
+			 * @brief Add the write counters and the deepest merge backlog to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			void Collect(LogStats& stats) const noexcept;
+
+			/**
+			 * @brief Number of shards.
+			 * @return Shard count.
+			 */
+			std::size_t Shards() const noexcept {
+				return m_shards.size();
+			}
+
+		private:
+			/**
+			 * @struct Pending
+			 * @brief A line taken from a shard, waiting for its turn.
+			 */
+			struct Pending {
+				std::uint64_t stamp;					///< Monotonic nanoseconds of its queueing
+				std::uint64_t arrival;					///< Order it was taken in (ties)
+				std::string text;						///< Line text
+			};
+
+			std::ostream& m_out;						///< Output stream (merger thread only)
+			const std::uint64_t m_skew_ns;				///< Merge window
+			std::vector<std::unique_ptr<RecordRing>> m_shards;	///< Per-CPU queues
+			std::vector<Pending> m_pending;				///< Min-heap by stamp (merger thread only)
+			std::vector<std::string> m_spare;			///< Recycled line buffers (merger thread only)
+			std::uint64_t m_arrivals;					///< Lines taken so far (merger thread only)
+			std::mutex m_wake_mutex;					///< Guards m_wake
+			std::condition_variable m_wake;				///< Wakes the merger
+			std::atomic<bool> m_sleeping;				///< Merger is (about to be) idle with nothing pending
+			std::atomic<bool> m_stop;					///< Shutdown requested
+			std::atomic<std::uint64_t> m_flushes;		///< Flush() requests made
+			std::atomic<std::uint64_t> m_flushed;		///< Flush() requests served
+			std::atomic<std::uint64_t> m_high_water;	///< Most lines pending in the heap at once
+			WriteCounters m_writes;						///< Line writes (merger thread only)
+			std::thread m_thread;						///< Merger thread (started last)
+
+			/**
+			 * @brief Shard of the calling thread.
+			 * @return Index into m_shards.
+			 */
+			std::size_t shard_index() const noexcept;
+
+			/**
+			 * @brief Move every queued line into the heap.
+			 * @return Number of lines taken.
+			 */
+			std::size_t gather() noexcept;
+
+			/**
+			 * @brief Write pending lines stamped at or before @p until, oldest first.
+			 * @param until Newest stamp to write.
+			 * @return Number of lines written.
+			 */
+			std::size_t release(std::uint64_t until) noexcept;
+
+			/**
+			 * @brief Whether every shard is empty.
+			 * @return true if no line is queued.
+			 */
+			bool empty() const noexcept;
+
+			/**
+			 * @brief Wake the merger if it is idle; @p always wakes it regardless.
+			 * @param always Notify even if the merger is not idle.
+			 */
+			void wake(bool always = false) noexcept;
+
+			/**
+			 * @brief Merger thread body.
+			 */
+			void run() noexcept;
+	};
+}
@@ -0,0 +1,83 @@
+#include <StormByte/logger/staged_writer.hxx>
+
+using namespace StormByte::Logger;
+
+StagedWriter::StagedWriter(std::ostream& out, std::shared_ptr<ThreadLock> lock, std::shared_ptr<LockCounters> lock_counters,
+						   const Level& level, const HeaderFormat& format):
+	m_out(out),
+	m_lock(std::move(lock)),
+	m_lock_counters(std::move(lock_counters)),
+	m_writes(),
+	m_merger(),
+	m_recorder(),
+	m_stages(level, format, &m_recorder),
+	m_exited() {
+	// An exiting producer writes what it left unterminated, like the destructor does.
+	m_stages.OnRetire([this](Stage& stage) {
+		if (stage.Finish())
+			Emit(stage.buffer.Data());
+		m_exited.Absorb(stage.impl.Counters());
+	});
+}
+
+StagedWriter::StagedWriter(std::ostream& out, std::shared_ptr<ThreadLock> lock, std::shared_ptr<LockCounters> lock_counters,
+						   const Level& level, const HeaderFormat& format, const ShardOptions& shards):
+	StagedWriter(out, std::move(lock), std::move(lock_counters), level, format) {
+	m_merger = std::make_unique<ShardMerger>(out, shards);
+}
+
+StagedWriter::~StagedWriter() noexcept {
+	m_stages.Close();
+	try {
+		m_stages.ForEach([this](Stage& stage) {
+			if (stage.Finish())
+				Emit(stage.buffer.Data());
+		});
+	} catch (...) {}
+}
+
+void StagedWriter::Attach(const std::shared_ptr<FlightRecorder>& recorder) {
+	m_recorder = recorder;
+	m_stages.ForEach([&recorder](Stage& stage) {
+		stage.impl.SetRecorder(recorder);
+	});
+}
+
+void StagedWriter::Collect(LogStats& stats) {
+	m_stages.ForEach([&stats](Stage& stage) {
+		stage.impl.Counters().Collect(stats);
+	}, [this, &stats] {
+		m_exited.Collect(stats);
+	});
+	if (m_merger)
+		m_merger->Collect(stats);
+	else
+		m_writes.Collect(stats);
+}
+
+void StagedWriter::Emit(std::string& text) noexcept {
+	if (m_merger) {
+		m_merger->Push(text);
+		return;
+	}
+	const std::uint64_t acquired = m_lock_counters->Lock(*m_lock);
+	const std::uint64_t started = m_writes.Begin(text.size());
+	try {
+		m_out.write(text.data(), static_cast<std::streamsize>(text.size()));
+	} catch (...) {}
+	m_writes.End(started);
+	m_lock_counters->Unlock(*m_lock, acquired);
+	text.clear();
+}
+
+void StagedWriter::Flush() noexcept {
+	if (m_merger) {
+		m_merger->Flush();
+		return;
+	}
+	const std::uint64_t acquired = m_lock_counters->Lock(*m_lock);
+	try {
+		m_out.flush();
+	} catch (...) {}
+	m_lock_counters->Unlock(*m_lock, acquired);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/line_stage.hxx>
+#include <StormByte/logger/log_counters.hxx>
+#include <StormByte/logger/shard_merger.hxx>
+#include <StormByte/thread_lock.hxx>
+
+#include <memory>
+#include <ostream>
+#include <string>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class StagedWriter
+	 * @brief Shared state behind ThreadedLog in LineMode::Staged (private).
+	 *
+	 * Every thread formats into its own Stage; the line lock is only taken to hand a
+	 * finished line to the output stream with a single write. Unterminated lines are
+	 * written out when the last owner goes away.
+	 *
+	 * In LineMode::Sharded finished lines are handed to a ShardMerger instead, and the
+	 * line lock is never taken.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE StagedWriter final {
+		public:
+			/**
+			 * @brief Construct the writer.
+			 * @param out Output stream.
+			 * @param lock Line lock shared with the owning ThreadedLog.
+			 * @param lock_counters Counters of @p lock, shared with the owning ThreadedLog.
+			 * @param level Minimum Level for producer stages.
+			 * @param format Compiled header format for producer stages.
+			 */
+			StagedWriter(std::ostream& out, std::shared_ptr<ThreadLock> lock, std::shared_ptr<LockCounters> lock_counters,
+						 const Level& level, const HeaderFormat& format);
+
+			/**
+			 * @brief Construct the writer for LineMode::Sharded.
+			 * @param out Output stream, written by the merger thread only.
+			 * @param lock Line lock shared with the owning ThreadedLog (unused by lines).
+			 * @param lock_counters Counters of @p lock, shared with the owning ThreadedLog.
+			 * @param level Minimum Level for producer stages.
+			 * @param format Compiled header format for producer stages.
+			 * @param shards Shard count, capacity and merge window.
+			 */
+			StagedWriter(std::ostream& out, std::shared_ptr<ThreadLock> lock, std::shared_ptr<LockCounters> lock_counters,
+						 const Level& level, const HeaderFormat& format, const ShardOptions& shards);
+
+			StagedWriter(const StagedWriter&) = delete;
+			StagedWriter(StagedWriter&&) noexcept = delete;
+			StagedWriter& operator=(const StagedWriter&) = delete;
+			StagedWriter& operator=(StagedWriter&&) noexcept = delete;
+
+			/**
+			 * @brief Write out every unterminated staged line, ended with a newline.
+			 */
+			~StagedWriter() noexcept;
+
+			/**
+			 * @brief Id of the stage registry, for Log::StageFilter().
+			 * @return The id.
+			 */
+			std::uint64_t Registry() const noexcept {
+				return m_stages.Id();
+			}
+
+			/**
+			 * @brief Get the calling thread's stage.
+			 * @return Reference to the stage.
+			 */
+			Stage& Local() {
+				return m_stages.Local();
+			}
+
+			/**
+			 * @brief Capture filtered records of every stage, current and future, into @p recorder.
+			 * @param recorder Shared recorder.
+			 */
+			void Attach(const std::shared_ptr<FlightRecorder>& recorder);
+
+			/**
+			 * @brief Write the stage's text under the line lock (or queue it in its shard) if it ends a line.
+			 * @param stage Calling thread's stage.
+			 */
+			void Commit(Stage& stage) noexcept {
+				if (stage.Complete())
+					Emit(stage.buffer.Data());
+			}
+
+			/**
+			 * @brief Flush the output stream under the line lock, or once every queued line is merged.
+			 */
+			void Flush() noexcept;
+
+			/**
+			 * @brief Add the counters of every stage and of the line writes (or of the merger) to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			void Collect(LogStats& stats);
+
+		private:
+			std::ostream& m_out;						///< Output stream
+			std::shared_ptr<ThreadLock> m_lock;			///< Line lock
+			std::shared_ptr<LockCounters> m_lock_counters;	///< Counters of m_lock
+			WriteCounters m_writes;						///< Line writes, under m_lock
+			std::unique_ptr<ShardMerger> m_merger;		///< Set only in LineMode::Sharded
+			std::shared_ptr<FlightRecorder> m_recorder;	///< Given to new stages
+			StageRegistry<Stage> m_stages;				///< Producer stages
+			LevelCounters m_exited;						///< Counters of stages whose thread exited, under the registry mutex
+
+			/**
+			 * @brief Write @p text with one call under the line lock (or queue it), then clear it.
+			 * @param text Staged text.
+			 */
+			void Emit(std::string& text) noexcept;
+	};
+}
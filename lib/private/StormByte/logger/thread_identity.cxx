@@ -0,0 +1,77 @@
+#include <StormByte/logger/thread_identity.hxx>
+#include <StormByte/platform.h>
+
+#include <charconv>
+#include <sstream>
+#include <thread>
+
+#ifdef WINDOWS
+	#include <windows.h>
+#elifdef LINUX
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#else
+	#include <pthread.h>
+#endif
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Kernel thread id, as shown by ps, top and debuggers.
+	std::uint64_t kernel_thread_id() noexcept {
+#ifdef WINDOWS
+		return static_cast<std::uint64_t>(::GetCurrentThreadId());
+#elifdef LINUX
+		return static_cast<std::uint64_t>(::syscall(SYS_gettid));
+#elif defined(__APPLE__)
+		std::uint64_t id = 0;
+		::pthread_threadid_np(nullptr, &id);
+		return id;
+#else
+		return 0;
+#endif
+	}
+}
+
+ThreadIdentity& ThreadIdentity::Local() noexcept {
+	thread_local ThreadIdentity identity;
+	return identity;
+}
+
+ThreadIdentity::ThreadIdentity() noexcept:
+	m_id(), m_id_size(0), m_tid(), m_tid_size(0), m_name(), m_name_size(0), m_generation(0) {
+	// Rendered through a stream once, so %i keeps the exact text of std::thread::id.
+	try {
+		std::ostringstream text;
+		text << std::this_thread::get_id();
+		m_id_size = text.str().copy(m_id, sizeof(m_id));
+	} catch (...) {}
+	m_tid_size = static_cast<std::size_t>(std::to_chars(m_tid, m_tid + sizeof(m_tid), kernel_thread_id()).ptr - m_tid);
+}
+
+void ThreadIdentity::SetName(std::string_view name) noexcept {
+	m_name_size = name.copy(m_name, max_name);
+	++m_generation;
+}
+
+ThreadLabel::ThreadLabel(): m_id(), m_tid(), m_name(), m_generation() {
+	const ThreadIdentity& identity = ThreadIdentity::Local();
+	const ThreadText text = identity.Text();
+	m_id.assign(text.id);
+	m_tid.assign(text.tid);
+	m_name.assign(text.name);
+	m_generation = identity.Generation();
+}
+
+bool ThreadLabel::Refresh() noexcept {
+	const ThreadIdentity& identity = ThreadIdentity::Local();
+	if (m_generation == identity.Generation())
+		return false;
+	try {
+		m_name.assign(identity.Text().name);
+	} catch (...) {
+		m_name.clear();
+	}
+	m_generation = identity.Generation();
+	return true;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct ThreadText
+	 * @brief Rendered identity of a thread, as shown by the header (private).
+	 *
+	 * An empty id means "the calling thread": renderers then read ThreadIdentity::Local().
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE ThreadText {
+		std::string_view id;						///< std::thread::id text (%i)
+		std::string_view tid;						///< Kernel thread id (%t)
+		std::string_view name;						///< Name set with SetThreadName (%n); empty if unnamed
+	};
+
+	/**
+	 * @class ThreadIdentity
+	 * @brief Per-thread cache of the rendered thread identity (private).
+	 *
+	 * The id and kernel thread id are rendered once, when the thread first logs, and the
+	 * name when it is set; headers copy them from fixed buffers without allocating.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE ThreadIdentity final {
+		public:
+			static constexpr std::size_t max_name = 63;	///< Longer names are truncated
+
+			/**
+			 * @brief Get the calling thread's identity.
+			 * @return Reference to the thread_local instance.
+			 */
+			static ThreadIdentity& Local() noexcept;
+
+			/**
+			 * @brief Views over the cached text.
+			 * @return Text valid until the name changes or the thread exits.
+			 */
+			ThreadText Text() const noexcept {
+				return { { m_id, m_id_size }, { m_tid, m_tid_size }, { m_name, m_name_size } };
+			}
+
+			/**
+			 * @brief Replace the name.
+			 * @param name New name (empty to clear), truncated to max_name bytes.
+			 */
+			void SetName(std::string_view name) noexcept;
+
+			/**
+			 * @brief Counter bumped by every SetName(), so copies can tell they are stale.
+			 * @return Generation of the name.
+			 */
+			std::uint32_t Generation() const noexcept {
+				return m_generation;
+			}
+
+		private:
+			char m_id[32];							///< Rendered std::thread::id
+			std::size_t m_id_size;					///< Length of m_id
+			char m_tid[24];							///< Rendered kernel thread id
+			std::size_t m_tid_size;					///< Length of m_tid
+			char m_name[max_name];					///< Name
+			std::size_t m_name_size;				///< Length of m_name
+			std::uint32_t m_generation;				///< Bumped by SetName()
+
+			/**
+			 * @brief Render the calling thread's id and kernel thread id.
+			 */
+			ThreadIdentity() noexcept;
+	};
+
+	/**
+	 * @class ThreadLabel
+	 * @brief Owned copy of a thread's identity, for text rendered away from its thread (private).
+	 *
+	 * Staged and deferred writers keep one per producer thread; the owning thread calls
+	 * Refresh() before recording a header so a renamed thread is picked up.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE ThreadLabel final {
+		public:
+			/**
+			 * @brief Copy the calling thread's identity.
+			 */
+			ThreadLabel();
+
+			ThreadLabel(const ThreadLabel&) = default;
+			ThreadLabel(ThreadLabel&&) noexcept = default;
+			ThreadLabel& operator=(const ThreadLabel&) = default;
+			ThreadLabel& operator=(ThreadLabel&&) noexcept = default;
+			~ThreadLabel() noexcept = default;
+
+			/**
+			 * @brief Whether the calling (owning) thread was renamed since the copy.
+			 * @return true if Refresh() would change the name.
+			 */
+			bool Stale() const noexcept {
+				return m_generation != ThreadIdentity::Local().Generation();
+			}
+
+			/**
+			 * @brief Copy the calling (owning) thread's name again if it changed.
+			 * @return true if the name was copied.
+			 */
+			bool Refresh() noexcept;
+
+			/**
+			 * @brief Views over the copy.
+			 * @return Text valid until the next Refresh().
+			 */
+			ThreadText Text() const noexcept {
+				return { m_id, m_tid, m_name };
+			}
+
+		private:
+			std::string m_id;						///< std::thread::id text
+			std::string m_tid;						///< Kernel thread id text
+			std::string m_name;						///< Name (empty if unnamed)
+			std::uint32_t m_generation;				///< Generation m_name was copied at
+	};
+}
@@ -0,0 +1,267 @@
+#include <StormByte/logger/tick_clock.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cmath>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+#endif
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Stamps holding counter ticks; system-clock nanoseconds stay below it until 2262.
+	constexpr std::uint64_t tick_flag = std::uint64_t{1} << 63;
+	constexpr auto first_window = std::chrono::milliseconds(10);
+	constexpr auto recalibration = std::chrono::seconds(1);
+	// A rate this far from the previous one means the system clock was stepped, not drift.
+	constexpr double max_rate_change = 1e-3;
+
+	enum class Mode : std::uint8_t { System, Counter, Steady };
+
+	std::atomic<Mode> g_mode(Mode::System);
+
+	// Calibration: ns = anchor_ns + (ticks - anchor_ticks) * ns_per_tick, under a sequence lock.
+	std::atomic<std::uint32_t> g_sequence(0);
+	std::atomic<std::uint64_t> g_anchor_ticks(0);
+	std::atomic<std::int64_t> g_anchor_ns(0);
+	std::atomic<double> g_ns_per_tick(0);
+	std::atomic<std::uint64_t> g_calibrations(0);
+	std::atomic<std::int64_t> g_correction_ns(0);
+
+	std::int64_t system_ns() noexcept {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	std::uint64_t steady_ticks() noexcept {
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+#if defined(__x86_64__) || defined(_M_X64)
+	std::uint64_t counter_ticks() noexcept {
+		// Plain rdtsc: ordering against neighbouring instructions does not matter for a header.
+		return __rdtsc();
+	}
+
+	// CPUID 0x80000007 EDX bit 8: the TSC runs at a constant rate in every P-, C- and T-state.
+	bool counter_invariant() noexcept {
+#if defined(_MSC_VER)
+		int regs[4];
+		__cpuid(regs, static_cast<int>(0x80000000u));
+		if (static_cast<unsigned>(regs[0]) < 0x80000007u)
+			return false;
+		__cpuid(regs, static_cast<int>(0x80000007u));
+		return (regs[3] & (1 << 8)) != 0;
+#else
+		unsigned eax, ebx, ecx, edx;
+		if (!__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx))
+			return false;
+		return (edx & (1u << 8)) != 0;
+#endif
+	}
+#elif defined(__aarch64__)
+	std::uint64_t counter_ticks() noexcept {
+		std::uint64_t ticks;
+		asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+		return ticks;
+	}
+
+	// The generic timer runs at the fixed frequency of CNTFRQ_EL0.
+	bool counter_invariant() noexcept {
+		return true;
+	}
+#else
+	std::uint64_t counter_ticks() noexcept {
+		return steady_ticks();
+	}
+
+	bool counter_invariant() noexcept {
+		return false;
+	}
+#endif
+
+	bool invariant() noexcept {
+		static const bool value = counter_invariant();
+		return value;
+	}
+
+	std::uint64_t ticks(Mode mode) noexcept {
+		return (mode == Mode::Counter ? counter_ticks() : steady_ticks()) & ~tick_flag;
+	}
+
+	Instant to_instant(std::int64_t ns) noexcept {
+		std::int64_t seconds = ns / 1'000'000'000;
+		std::int64_t rest = ns % 1'000'000'000;
+		if (rest < 0) {
+			--seconds;
+			rest += 1'000'000'000;
+		}
+		return { static_cast<std::time_t>(seconds), static_cast<std::uint32_t>(rest) };
+	}
+
+	std::int64_t to_ns(std::uint64_t tick) noexcept {
+		std::uint32_t before, after;
+		std::uint64_t anchor_ticks;
+		std::int64_t anchor_ns;
+		double ns_per_tick;
+		do {
+			before = g_sequence.load(std::memory_order_acquire);
+			anchor_ticks = g_anchor_ticks.load(std::memory_order_relaxed);
+			anchor_ns = g_anchor_ns.load(std::memory_order_relaxed);
+			ns_per_tick = g_ns_per_tick.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			after = g_sequence.load(std::memory_order_relaxed);
+		} while (before != after || (before & 1) != 0);
+		// Both below 2^63: the wrapped difference is the signed distance.
+		const auto elapsed = static_cast<std::int64_t>(tick - anchor_ticks);
+		return anchor_ns + std::llround(static_cast<double>(elapsed) * ns_per_tick);
+	}
+
+	void publish(std::uint64_t anchor_ticks, std::int64_t anchor_ns, double ns_per_tick) noexcept {
+		const std::uint32_t sequence = g_sequence.load(std::memory_order_relaxed);
+		g_sequence.store(sequence + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		g_anchor_ticks.store(anchor_ticks, std::memory_order_relaxed);
+		g_anchor_ns.store(anchor_ns, std::memory_order_relaxed);
+		g_ns_per_tick.store(ns_per_tick, std::memory_order_relaxed);
+		g_sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	/**
+	 * Owns the calibration thread. Anchors are (ticks, system ns) pairs; the rate is measured
+	 * from a base pair that stays put while the system clock runs smoothly, so it gets more
+	 * precise with every calibration.
+	 */
+	class Calibrator final {
+		public:
+			explicit Calibrator(Mode mode): m_mode(mode), m_stop(false) {
+				m_base = sample();
+				double ns_per_tick = 1.0;
+				if (mode == Mode::Counter) {
+					std::this_thread::sleep_for(first_window);
+					const Pair now = sample();
+					ns_per_tick = rate(m_base, now);
+					m_base = now;
+				}
+				publish(m_base.ticks, m_base.ns, ns_per_tick);
+				g_calibrations.fetch_add(1, std::memory_order_relaxed);
+				m_thread = std::thread(&Calibrator::run, this);
+			}
+
+			~Calibrator() noexcept {
+				{
+					std::lock_guard<std::mutex> lock(m_mutex);
+					m_stop = true;
+				}
+				m_wake.notify_one();
+				if (m_thread.joinable())
+					m_thread.join();
+			}
+
+			Mode TickMode() const noexcept {
+				return m_mode;
+			}
+
+		private:
+			struct Pair {
+				std::uint64_t ticks;
+				std::int64_t ns;
+			};
+
+			const Mode m_mode;
+			Pair m_base;
+			std::mutex m_mutex;
+			std::condition_variable m_wake;
+			bool m_stop;
+			std::thread m_thread;
+
+			// Tick reading closest to the system clock read: the narrowest of a few brackets.
+			Pair sample() const noexcept {
+				Pair best{ 0, 0 };
+				std::uint64_t width = ~std::uint64_t{0};
+				for (int i = 0; i < 5; ++i) {
+					const std::uint64_t before = ticks(m_mode);
+					const std::int64_t ns = system_ns();
+					const std::uint64_t after = ticks(m_mode);
+					if (after >= before && after - before < width) {
+						width = after - before;
+						best = { before + width / 2, ns };
+					}
+				}
+				return best;
+			}
+
+			static double rate(const Pair& from, const Pair& to) noexcept {
+				if (to.ticks <= from.ticks)
+					return g_ns_per_tick.load(std::memory_order_relaxed);
+				return static_cast<double>(to.ns - from.ns) / static_cast<double>(to.ticks - from.ticks);
+			}
+
+			void run() noexcept {
+				std::unique_lock<std::mutex> lock(m_mutex);
+				while (!m_wake.wait_for(lock, recalibration, [this] { return m_stop; })) {
+					const Pair now = sample();
+					g_correction_ns.store(now.ns - to_ns(now.ticks), std::memory_order_relaxed);
+
+					double ns_per_tick = g_ns_per_tick.load(std::memory_order_relaxed);
+					if (m_mode == Mode::Counter) {
+						const double measured = rate(m_base, now);
+						if (std::abs(measured / ns_per_tick - 1.0) <= max_rate_change)
+							ns_per_tick = measured;
+						else
+							m_base = now;	// System clock stepped: measure again from here
+					}
+					publish(now.ticks, now.ns, ns_per_tick);
+					g_calibrations.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+	};
+
+	std::mutex g_use_mutex;
+}
+
+std::uint64_t TickClock::Capture() noexcept {
+	const Mode mode = g_mode.load(std::memory_order_relaxed);
+	if (mode == Mode::System) [[likely]]
+		return static_cast<std::uint64_t>(system_ns());
+	return ticks(mode) | tick_flag;
+}
+
+Instant TickClock::Convert(std::uint64_t stamp) noexcept {
+	if ((stamp & tick_flag) == 0)
+		return to_instant(static_cast<std::int64_t>(stamp));
+	return to_instant(to_ns(stamp & ~tick_flag));
+}
+
+void TickClock::Use(const ClockSource& source) {
+	std::lock_guard<std::mutex> lock(g_use_mutex);
+	if (source == ClockSource::System) {
+		g_mode.store(Mode::System, std::memory_order_relaxed);
+		return;
+	}
+	// Calibrated once, then kept running for the rest of the process.
+	static Calibrator calibrator(invariant() ? Mode::Counter : Mode::Steady);
+	g_mode.store(calibrator.TickMode(), std::memory_order_release);
+}
+
+ClockStatus TickClock::Status() noexcept {
+	ClockStatus status;
+	status.source = g_mode.load(std::memory_order_relaxed) == Mode::System ? ClockSource::System : ClockSource::Counter;
+	status.invariant = invariant();
+	const double ns_per_tick = g_ns_per_tick.load(std::memory_order_relaxed);
+	status.ticks_per_second = ns_per_tick > 0 ? 1e9 / ns_per_tick : 0;
+	status.calibrations = g_calibrations.load(std::memory_order_relaxed);
+	status.correction_ns = g_correction_ns.load(std::memory_order_relaxed);
+	return status;
+}
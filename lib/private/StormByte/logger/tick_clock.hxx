@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/clock_source.hxx>
+#include <StormByte/logger/timestamp.hxx>
+
+#include <cstdint>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class TickClock
+	 * @brief Header clock: system clock or calibrated CPU counter (private).
+	 *
+	 * A stamp is what the producer captures: system-clock nanoseconds since the epoch, or
+	 * raw counter ticks with the top bit set. Convert() turns either into an Instant with the
+	 * latest calibration, published by the calibration thread through a sequence lock, so
+	 * stamps are cheap to take and only converted where the time is rendered.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE TickClock final {
+		public:
+			/**
+			 * @brief Capture the current time with the selected source.
+			 * @return Stamp to pass to Convert().
+			 */
+			static std::uint64_t Capture() noexcept;
+
+			/**
+			 * @brief Wall-clock instant of a stamp.
+			 * @param stamp Value returned by Capture().
+			 * @return The instant.
+			 */
+			static Instant Convert(std::uint64_t stamp) noexcept;
+
+			/**
+			 * @brief Select the source, calibrating the counter and starting its thread on first use.
+			 * @param source Clock to use.
+			 */
+			static void Use(const ClockSource& source);
+
+			/**
+			 * @brief Current source and calibration.
+			 * @return Snapshot of the clock state.
+			 */
+			static ClockStatus Status() noexcept;
+	};
+}
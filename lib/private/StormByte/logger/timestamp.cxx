@@ -0,0 +1,153 @@
+#include <StormByte/logger/timestamp.hxx>
+#include <StormByte/logger/tick_clock.hxx>
+
+#include <chrono>
+
+using namespace StormByte::Logger;
+
+namespace {
+	bool to_local(std::time_t t, std::tm& tm) noexcept {
+#ifdef WINDOWS
+		return localtime_s(&tm, &t) == 0;
+#elifdef UNIX
+		return localtime_r(&t, &tm) != nullptr;
+#else
+		#error "Unsupported platform for TimestampCache"
+#endif
+	}
+
+	bool to_utc(std::time_t t, std::tm& tm) noexcept {
+#ifdef WINDOWS
+		return gmtime_s(&tm, &t) == 0;
+#elifdef UNIX
+		return gmtime_r(&t, &tm) != nullptr;
+#else
+		#error "Unsupported platform for TimestampCache"
+#endif
+	}
+
+	char* put_digits(char* p, unsigned value, int width) noexcept {
+		for (int i = width - 1; i >= 0; --i) {
+			p[i] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		}
+		return p + width;
+	}
+
+	// dd/mm/YYYY HH:MM:SS
+	std::size_t render_classic(const std::tm& tm, char* out) noexcept {
+		char* p = out;
+		p = put_digits(p, static_cast<unsigned>(tm.tm_mday), 2);
+		*p++ = '/';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_mon + 1), 2);
+		*p++ = '/';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_year + 1900), 4);
+		*p++ = ' ';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_hour), 2);
+		*p++ = ':';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_min), 2);
+		*p++ = ':';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_sec), 2);
+		return static_cast<std::size_t>(p - out);
+	}
+
+	// YYYY-MM-DDTHH:MM:SS
+	std::size_t render_iso(const std::tm& tm, char* out) noexcept {
+		char* p = out;
+		p = put_digits(p, static_cast<unsigned>(tm.tm_year + 1900), 4);
+		*p++ = '-';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_mon + 1), 2);
+		*p++ = '-';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_mday), 2);
+		*p++ = 'T';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_hour), 2);
+		*p++ = ':';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_min), 2);
+		*p++ = ':';
+		p = put_digits(p, static_cast<unsigned>(tm.tm_sec), 2);
+		return static_cast<std::size_t>(p - out);
+	}
+
+	// +hh:mm, derived from the local/UTC breakdowns (tm_gmtoff is not portable)
+	std::size_t render_offset(std::time_t t, char* out) noexcept {
+		std::tm local{}, utc{};
+		if (!to_local(t, local) || !to_utc(t, utc))
+			return 0;
+
+		int days = local.tm_yday - utc.tm_yday;
+		if (local.tm_year != utc.tm_year)
+			days = local.tm_year > utc.tm_year ? 1 : -1;
+		int minutes = days * 1440 + (local.tm_hour - utc.tm_hour) * 60 + (local.tm_min - utc.tm_min);
+
+		char* p = out;
+		*p++ = minutes < 0 ? '-' : '+';
+		if (minutes < 0)
+			minutes = -minutes;
+		p = put_digits(p, static_cast<unsigned>(minutes / 60), 2);
+		*p++ = ':';
+		p = put_digits(p, static_cast<unsigned>(minutes % 60), 2);
+		return static_cast<std::size_t>(p - out);
+	}
+
+	template <typename Render>
+	std::string_view refresh(std::time_t second, std::time_t& cached, std::size_t& size, char* text, Render&& render) noexcept {
+		if (cached != second) [[unlikely]] {
+			size = render(text);
+			cached = second;
+		}
+		return { text, size };
+	}
+}
+
+Instant Instant::Now() noexcept {
+	return TickClock::Convert(TickClock::Capture());
+}
+
+TimestampCache& TimestampCache::Local() noexcept {
+	thread_local TimestampCache cache;
+	return cache;
+}
+
+std::string_view TimestampCache::LocalTime(const Instant& now) noexcept {
+	Slot& s = m_local_time;
+	return refresh(now.seconds, s.second, s.size, s.text, [&now](char* out) -> std::size_t {
+		std::tm tm{};
+		return to_local(now.seconds, tm) ? render_classic(tm, out) : 0;
+	});
+}
+
+std::string_view TimestampCache::UtcTime(const Instant& now) noexcept {
+	Slot& s = m_utc_time;
+	return refresh(now.seconds, s.second, s.size, s.text, [&now](char* out) -> std::size_t {
+		std::tm tm{};
+		return to_utc(now.seconds, tm) ? render_classic(tm, out) : 0;
+	});
+}
+
+std::string_view TimestampCache::LocalIso(const Instant& now) noexcept {
+	Slot& s = m_local_iso;
+	return refresh(now.seconds, s.second, s.size, s.text, [&now](char* out) -> std::size_t {
+		std::tm tm{};
+		return to_local(now.seconds, tm) ? render_iso(tm, out) : 0;
+	});
+}
+
+std::string_view TimestampCache::UtcIso(const Instant& now) noexcept {
+	Slot& s = m_utc_iso;
+	return refresh(now.seconds, s.second, s.size, s.text, [&now](char* out) -> std::size_t {
+		std::tm tm{};
+		return to_utc(now.seconds, tm) ? render_iso(tm, out) : 0;
+	});
+}
+
+std::string_view TimestampCache::UtcOffset(const Instant& now) noexcept {
+	Slot& s = m_offset;
+	return refresh(now.seconds, s.second, s.size, s.text, [&now](char* out) -> std::size_t {
+		return render_offset(now.seconds, out);
+	});
+}
+
+std::string_view TimestampCache::Fraction(const Instant& now, std::size_t digits) noexcept {
+	put_digits(m_fraction, now.nanoseconds, 9);
+	return { m_fraction, digits < 9 ? digits : 9 };
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct Instant
+	 * @brief A wall-clock point split into whole seconds and nanoseconds (private).
+	 */
+	struct STORMBYTE_LOGGER_PRIVATE Instant {
+		std::time_t seconds;						///< Seconds since the epoch
+		std::uint32_t nanoseconds;					///< Sub-second part [0, 1e9)
+
+		/**
+		 * @brief Sample the header clock (see TickClock).
+		 * @return The current instant.
+		 */
+		static Instant Now() noexcept;
+	};
+
+	/**
+	 * @class TimestampCache
+	 * @brief Per-thread cache of rendered timestamp prefixes (private).
+	 *
+	 * Each layout is re-rendered only when the second changes, so the calendar
+	 * conversion (and the timezone lock glibc takes inside localtime_r) is paid at most
+	 * once per second per thread. Everything renders into fixed buffers: no allocation.
+	 */
+	class STORMBYTE_LOGGER_PRIVATE TimestampCache final {
+		public:
+			/**
+			 * @brief Get the calling thread's cache.
+			 * @return Reference to the thread_local instance.
+			 */
+			static TimestampCache& Local() noexcept;
+
+			/**
+			 * @brief Local time as `dd/mm/YYYY HH:MM:SS` (%T).
+			 * @param now Instant to render.
+			 * @return View valid until the next call on this thread.
+			 */
+			std::string_view LocalTime(const Instant& now) noexcept;
+
+			/**
+			 * @brief UTC time as `dd/mm/YYYY HH:MM:SS` (%U).
+			 * @param now Instant to render.
+			 * @return View valid until the next call on this thread.
+			 */
+			std::string_view UtcTime(const Instant& now) noexcept;
+
+			/**
+			 * @brief Local time as ISO-8601 `YYYY-MM-DDTHH:MM:SS` (%I).
+			 * @param now Instant to render.
+			 * @return View valid until the next call on this thread.
+			 */
+			std::string_view LocalIso(const Instant& now) noexcept;
+
+			/**
+			 * @brief UTC time as ISO-8601 `YYYY-MM-DDTHH:MM:SS` (%Z).
+			 * @param now Instant to render.
+			 * @return View valid until the next call on this thread.
+			 */
+			std::string_view UtcIso(const Instant& now) noexcept;
+
+			/**
+			 * @brief Local UTC offset as `+hh:mm` (%z).
+			 * @param now Instant to render.
+			 * @return View valid until the next call on this thread.
+			 */
+			std::string_view UtcOffset(const Instant& now) noexcept;
+
+			/**
+			 * @brief Leading @p digits digits of the sub-second part (%3, %6, %9).
+			 * @param now Instant to render.
+			 * @param digits 3 (ms), 6 (us) or 9 (ns).
+			 * @return View valid until the next call on this thread.
+			 */
+			std::string_view Fraction(const Instant& now, std::size_t digits) noexcept;
+
+		private:
+			struct Slot {
+				std::time_t second = -1;			///< Second currently rendered
+				std::size_t size = 0;				///< Rendered length
+				char text[32] = {};					///< Rendered text
+			};
+
+			Slot m_local_time;						///< %T
+			Slot m_utc_time;						///< %U
+			Slot m_local_iso;						///< %I
+			Slot m_utc_iso;							///< %Z
+			Slot m_offset;							///< %z
+			char m_fraction[9] = {};				///< %3 / %6 / %9
+	};
+}
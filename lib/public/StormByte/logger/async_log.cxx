@@ -0,0 +1,85 @@
+#include <StormByte/logger/async_log.hxx>
+#include <StormByte/logger/async_writer.hxx>
+
+using namespace StormByte::Logger;
+
+AsyncLog::AsyncLog(std::ostream& out, const Level& level, const HeaderFormat& format,
+				   std::size_t capacity, const OverflowPolicy& policy):
+	Log(out, level, format),
+	m_writer(std::make_shared<AsyncWriter>(out, level, format, capacity, policy)) {
+	StageFilter(m_writer->Registry());
+}
+
+void AsyncLog::Flush() noexcept {
+	m_writer->Flush();
+}
+
+std::uint64_t AsyncLog::Dropped() const noexcept {
+	return m_writer->Dropped();
+}
+
+Implementation& AsyncLog::Active() noexcept {
+	return m_writer->Local().impl;
+}
+
+void AsyncLog::Collect(LogStats& stats) const {
+	m_writer->Collect(stats);
+}
+
+void AsyncLog::Attach(const std::shared_ptr<FlightRecorder>& recorder) {
+	m_writer->Attach(recorder);
+}
+
+void AsyncLog::Write(bool v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(char v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(signed char v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(unsigned char v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(short v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(unsigned short v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(int v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(unsigned int v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(long v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(unsigned long v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(long long v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(unsigned long long v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(float v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(double v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(long double v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(const std::string& v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(const char* v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(const std::wstring& v) { m_writer->Local().impl << v; }
+void AsyncLog::Write(const wchar_t* v) { m_writer->Local().impl << v; }
+
+void AsyncLog::Write(const Level& level) {
+	// Switching level mid-line terminates the line, which then becomes a record.
+	Stage& stage = m_writer->Local();
+	stage.impl << level;
+	m_writer->Commit(stage);
+}
+
+void AsyncLog::Write(std::ostream& (*manip)(std::ostream&)) {
+	Stage& stage = m_writer->Local();
+	stage.impl << manip;
+	m_writer->Commit(stage);
+}
+
+void AsyncLog::Write(Log& (*manip)(Log&) noexcept) {
+	Log::Write(manip);
+	m_writer->Commit(m_writer->Local());
+}
+
+void AsyncLog::Write(RedactManip m) {
+	m_writer->Local().impl.SetRedact(true, m.count, m.keep_first);
+}
+
+void AsyncLog::Write(PrecisionManip m) {
+	m_writer->Local().impl.SetPrecision(m.digits);
+}
+
+void AsyncLog::Write(std::ios_base& (*manip)(std::ios_base&)) {
+	m_writer->Local().impl << manip;
+}
+
+void AsyncLog::Write(KeyManip m) {
+	m_writer->Local().impl.SetKey(m.key);
+}
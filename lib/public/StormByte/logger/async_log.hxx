@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/log.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	class AsyncWriter;
+
+	/**
+	 * @class AsyncLog
+	 * @brief Logging facade that moves sink I/O to a background writer thread.
+	 *
+	 * Each producer thread formats its lines into its own staging buffer (no shared lock);
+	 * a finished line (newline manipulator or level switch) is pushed into a bounded
+	 * lock-free queue that a dedicated thread drains into the output stream.
+	 *
+	 * Level, human-readable and redaction state are tracked per producer thread.
+	 * Copies share the same queue and writer. The writer is stopped when the last copy
+	 * is destroyed, after committing unterminated lines and draining the queue.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC AsyncLog : public Log {
+		public:
+			/**
+			 * @brief Construct an AsyncLog writing to @p out.
+			 * @param out Output stream; it must outlive every copy of this logger.
+			 * @param level Minimum Level that will be emitted.
+			 * @param format Header format (see Log).
+			 * @param capacity Maximum number of queued lines (rounded up to a power of two).
+			 * @param policy What to do when the queue is full.
+			 */
+			AsyncLog(std::ostream& out, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T",
+					 std::size_t capacity = 8192, const OverflowPolicy& policy = OverflowPolicy::Block);
+
+			/**
+			 * @brief Construct an AsyncLog writing to a Sink from its writer thread.
+			 * @param sink Output sink (FileSink, MappedFileSink, ...); it must outlive every copy of this logger.
+			 * @param level Minimum Level that will be emitted.
+			 * @param format Header format (see Log).
+			 * @param capacity Maximum number of queued lines (rounded up to a power of two).
+			 * @param policy What to do when the queue is full.
+			 */
+			AsyncLog(Sink& sink, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T",
+					 std::size_t capacity = 8192, const OverflowPolicy& policy = OverflowPolicy::Block):
+				AsyncLog(sink.Stream(), level, format, capacity, policy) {}
+
+			AsyncLog(const AsyncLog&) = default;
+			AsyncLog(AsyncLog&&) noexcept = default;
+			~AsyncLog() noexcept = default;
+			AsyncLog& operator=(const AsyncLog&) = default;
+			AsyncLog& operator=(AsyncLog&&) noexcept = default;
+
+			/**
+			 * @brief Block until every line queued before the call is written, then flush @p out.
+			 *
+			 * Lines still being assembled (no newline yet) are not part of the flush.
+			 */
+			void Flush() noexcept;
+
+			/**
+			 * @brief Number of lines discarded by OverflowPolicy::DropNewest / DropOldest.
+			 * @return Dropped line count.
+			 */
+			std::uint64_t Dropped() const noexcept;
+
+			/**
+			 * @name Streaming Operators
+			 * Same contract as Log; data overloads early-out when filtered.
+			 */
+			//@{
+			inline Log& operator<<(bool v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(signed char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(short v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned short v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(int v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned int v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned long long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(float v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(double v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long double v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const std::string& v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const char* v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const std::wstring& v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const wchar_t* v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const Level& level) {
+				if (m_report) [[unlikely]] Report();
+				Write(level);
+				return *this;
+			}
+			inline Log& operator<<(std::ostream& (*manip)(std::ostream&)) {
+				Write(manip);
+				return *this;
+			}
+			inline Log& operator<<(Log& (*manip)(Log&) noexcept) {
+				Write(manip);
+				return *this;
+			}
+			inline Log& operator<<(RedactManip m) {
+				Write(m);
+				return *this;
+			}
+			inline Log& operator<<(PrecisionManip m) {
+				Write(m);
+				return *this;
+			}
+			inline Log& operator<<(std::ios_base& (*manip)(std::ios_base&)) {
+				Write(manip);
+				return *this;
+			}
+			template <typename T>
+			inline Log& operator<<(const KeyValue<T>& field) {
+				return Log::operator<<(field);
+			}
+			inline Log& operator<<(SuppressedManip m) {
+				return Log::operator<<(m);
+			}
+			inline Log& operator<<(CategoryManip m) {
+				return Log::operator<<(m);
+			}
+			template <typename F>
+				requires std::invocable<F&> && (!std::is_void_v<std::invoke_result_t<F&>>)
+			inline Log& operator<<(F&& fn) {
+				return Log::operator<<(std::forward<F>(fn));
+			}
+			//@}
+
+		private:
+			std::shared_ptr<AsyncWriter> m_writer;
+
+			Implementation& Active() noexcept override;
+			void Attach(const std::shared_ptr<FlightRecorder>& recorder) override;
+			void Collect(LogStats& stats) const override;
+
+			void Write(bool v) override;
+			void Write(char v) override;
+			void Write(signed char v) override;
+			void Write(unsigned char v) override;
+			void Write(short v) override;
+			void Write(unsigned short v) override;
+			void Write(int v) override;
+			void Write(unsigned int v) override;
+			void Write(long v) override;
+			void Write(unsigned long v) override;
+			void Write(long long v) override;
+			void Write(unsigned long long v) override;
+			void Write(float v) override;
+			void Write(double v) override;
+			void Write(long double v) override;
+			void Write(const std::string& v) override;
+			void Write(const char* v) override;
+			void Write(const std::wstring& v) override;
+			void Write(const wchar_t* v) override;
+			void Write(const Level& level) override;
+			void Write(std::ostream& (*manip)(std::ostream&)) override;
+			void Write(Log& (*manip)(Log&) noexcept) override;
+			void Write(RedactManip m) override;
+			void Write(PrecisionManip m) override;
+			void Write(std::ios_base& (*manip)(std::ios_base&)) override;
+			void Write(KeyManip m) override;
+	};
+}
@@ -0,0 +1,109 @@
+#include <StormByte/logger/binary_log.hxx>
+#include <StormByte/logger/binary_decoder.hxx>
+#include <StormByte/logger/binary_writer.hxx>
+
+using namespace StormByte::Logger;
+
+BinaryLog::BinaryLog(std::ostream& out, const Level& level, const HeaderFormat& format):
+	Log(out, level, format),
+	m_writer(std::make_shared<BinaryWriter>(out, level, format)) {
+	StageFilter(m_writer->Registry());
+}
+
+void BinaryLog::Flush() noexcept {
+	m_writer->Flush();
+}
+
+bool BinaryLog::Decode(std::istream& in, std::ostream& out) noexcept {
+	return BinaryDecoder::Decode(in, out, std::nullopt);
+}
+
+bool BinaryLog::Decode(std::istream& in, std::ostream& out, const HeaderFormat& format) noexcept {
+	return BinaryDecoder::Decode(in, out, format);
+}
+
+Implementation& BinaryLog::Active() noexcept {
+	return m_writer->Local().shadow;
+}
+
+void BinaryLog::Collect(LogStats& stats) const {
+	m_writer->Collect(stats);
+}
+
+void BinaryLog::Write(bool v) { m_writer->Local().Value(BinaryTag::Bool, static_cast<std::uint8_t>(v)); }
+void BinaryLog::Write(char v) { m_writer->Local().Value(BinaryTag::Char, v); }
+void BinaryLog::Write(signed char v) { m_writer->Local().Value(BinaryTag::SignedChar, v); }
+void BinaryLog::Write(unsigned char v) { m_writer->Local().Value(BinaryTag::UnsignedChar, v); }
+void BinaryLog::Write(short v) { m_writer->Local().Value(BinaryTag::Short, v); }
+void BinaryLog::Write(unsigned short v) { m_writer->Local().Value(BinaryTag::UnsignedShort, v); }
+void BinaryLog::Write(int v) { m_writer->Local().Value(BinaryTag::Int, v); }
+void BinaryLog::Write(unsigned int v) { m_writer->Local().Value(BinaryTag::UnsignedInt, v); }
+void BinaryLog::Write(long v) { m_writer->Local().Value(BinaryTag::Long, v); }
+void BinaryLog::Write(unsigned long v) { m_writer->Local().Value(BinaryTag::UnsignedLong, v); }
+void BinaryLog::Write(long long v) { m_writer->Local().Value(BinaryTag::LongLong, v); }
+void BinaryLog::Write(unsigned long long v) { m_writer->Local().Value(BinaryTag::UnsignedLongLong, v); }
+void BinaryLog::Write(float v) { m_writer->Local().Value(BinaryTag::Float, v); }
+void BinaryLog::Write(double v) { m_writer->Local().Value(BinaryTag::Double, v); }
+void BinaryLog::Write(long double v) { m_writer->Local().Value(BinaryTag::LongDouble, v); }
+void BinaryLog::Write(const std::string& v) { m_writer->Local().Text(v); }
+void BinaryLog::Write(const char* v) { m_writer->Local().Literal(v); }
+
+void BinaryLog::Write(const std::wstring& v) {
+	BinaryStage& stage = m_writer->Local();
+	if (stage.Enabled())
+		stage.Text(String::UTF8Encode(v));
+}
+
+void BinaryLog::Write(const wchar_t* v) {
+	BinaryStage& stage = m_writer->Local();
+	if (stage.Enabled())
+		stage.Text(v ? String::UTF8Encode(std::wstring(v)) : std::string{});
+}
+
+void BinaryLog::Write(const Level& level) {
+	BinaryStage& stage = m_writer->Local();
+	m_writer->Commit(stage, stage.SetLevel(level));
+}
+
+void BinaryLog::Write(std::ostream& (*manip)(std::ostream&)) {
+	BinaryStage& stage = m_writer->Local();
+	bool flush;
+	m_writer->Commit(stage, stage.Manipulator(manip, flush));
+	if (flush)
+		m_writer->Flush();
+}
+
+void BinaryLog::Write(Log& (*manip)(Log&) noexcept) {
+	// Known manipulators are recorded; anything else acts on the shadow state only.
+	using LogManipulator = Log& (*)(Log&) noexcept;
+	BinaryStage& stage = m_writer->Local();
+	if (manip == static_cast<LogManipulator>(endr))
+		m_writer->Commit(stage, stage.EndRecord());
+	else if (manip == static_cast<LogManipulator>(humanreadable_number))
+		stage.State(BinaryTag::HumanReadable, static_cast<std::uint8_t>(1));
+	else if (manip == static_cast<LogManipulator>(humanreadable_bytes))
+		stage.State(BinaryTag::HumanReadable, static_cast<std::uint8_t>(2));
+	else if (manip == static_cast<LogManipulator>(nohumanreadable))
+		stage.State(BinaryTag::HumanReadable, static_cast<std::uint8_t>(0));
+	else if (manip == static_cast<LogManipulator>(no_redact))
+		stage.State(BinaryTag::Redact, static_cast<std::uint8_t>(0), std::uint64_t{ 0 }, static_cast<std::uint8_t>(0));
+	else
+		Log::Write(manip);
+}
+
+void BinaryLog::Write(RedactManip m) {
+	m_writer->Local().State(BinaryTag::Redact, static_cast<std::uint8_t>(1), static_cast<std::uint64_t>(m.count),
+							static_cast<std::uint8_t>(m.keep_first));
+}
+
+void BinaryLog::Write(PrecisionManip m) {
+	m_writer->Local().State(BinaryTag::Precision, static_cast<std::int32_t>(m.digits));
+}
+
+void BinaryLog::Write(std::ios_base& (*manip)(std::ios_base&)) {
+	m_writer->Local().Base(manip);
+}
+
+void BinaryLog::Write(KeyManip m) {
+	m_writer->Local().Key(m.key);
+}
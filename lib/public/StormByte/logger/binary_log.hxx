@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/log.hxx>
+
+#include <istream>
+#include <memory>
+#include <ostream>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	class BinaryWriter;
+
+	/**
+	 * @class BinaryLog
+	 * @brief Logging facade that defers all formatting to an offline decoder.
+	 *
+	 * Producers append compact tagged records to a per-thread buffer: the header instant,
+	 * the level, and the raw bytes of every value (literals passed as `const char*` are
+	 * interned per thread, so repeated ones cost a few bytes). No number, time or header is
+	 * rendered on the producer thread; a finished line is written as one chunk under a short
+	 * lock. @ref Decode (or the `StormByte-LogDecoder` tool) renders the file back to the exact
+	 * text a Log with the same level and format would have written, human-readable and
+	 * redaction rules included.
+	 *
+	 * Level, human-readable, precision, base and redaction state are tracked per producer
+	 * thread. Copies share the same writer; unterminated lines are written when the last
+	 * copy is destroyed. The output must be a plain byte stream (std::ofstream, FileSink):
+	 * sinks that cut files at newlines would split binary chunks. Files are decoded on the
+	 * platform that wrote them (native byte order and type sizes).
+	 */
+	class STORMBYTE_LOGGER_PUBLIC BinaryLog : public Log {
+		public:
+			/**
+			 * @brief Construct a BinaryLog writing to @p out; the file header is written immediately.
+			 * @param out Output stream (opened in binary mode); it must outlive every copy of this logger.
+			 * @param level Minimum Level that will be recorded.
+			 * @param format Header format (see Log), stored in the file for the decoder.
+			 */
+			BinaryLog(std::ostream& out, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T");
+
+			/**
+			 * @brief Construct a BinaryLog writing to a Sink.
+			 * @param sink Output sink (FileSink); it must outlive every copy of this logger.
+			 * @param level Minimum Level that will be recorded.
+			 * @param format Header format (see Log), stored in the file for the decoder.
+			 */
+			BinaryLog(Sink& sink, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T"):
+				BinaryLog(sink.Stream(), level, format) {}
+
+			BinaryLog(const BinaryLog&) = default;
+			BinaryLog(BinaryLog&&) noexcept = default;
+			~BinaryLog() noexcept = default;
+			BinaryLog& operator=(const BinaryLog&) = default;
+			BinaryLog& operator=(BinaryLog&&) noexcept = default;
+
+			/**
+			 * @brief Flush the output stream. Lines still being assembled are not written.
+			 */
+			void Flush() noexcept;
+
+			/**
+			 * @brief Render a binary log as text.
+			 * @param in Binary log (opened in binary mode).
+			 * @param out Text output.
+			 * @return false if @p in is not a binary log, or is truncated or corrupt; everything
+			 *         decoded before that point has been written.
+			 */
+			static bool Decode(std::istream& in, std::ostream& out) noexcept;
+
+			/**
+			 * @brief Render a binary log as text with a different header format.
+			 * @param in Binary log (opened in binary mode).
+			 * @param out Text output.
+			 * @param format Header format used instead of the recorded one.
+			 * @return false if @p in is not a binary log, or is truncated or corrupt.
+			 */
+			static bool Decode(std::istream& in, std::ostream& out, const HeaderFormat& format) noexcept;
+
+			/**
+			 * @name Streaming Operators
+			 * Same contract as Log; data overloads early-out when filtered.
+			 */
+			//@{
+			inline Log& operator<<(bool v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(signed char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(short v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned short v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(int v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned int v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned long long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(float v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(double v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long double v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const std::string& v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const char* v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const std::wstring& v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const wchar_t* v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const Level& level) {
+				if (m_report) [[unlikely]] Report();
+				Write(level);
+				return *this;
+			}
+			inline Log& operator<<(std::ostream& (*manip)(std::ostream&)) {
+				Write(manip);
+				return *this;
+			}
+			inline Log& operator<<(Log& (*manip)(Log&) noexcept) {
+				Write(manip);
+				return *this;
+			}
+			inline Log& operator<<(RedactManip m) {
+				Write(m);
+				return *this;
+			}
+			inline Log& operator<<(PrecisionManip m) {
+				Write(m);
+				return *this;
+			}
+			inline Log& operator<<(std::ios_base& (*manip)(std::ios_base&)) {
+				Write(manip);
+				return *this;
+			}
+			template <typename T>
+			inline Log& operator<<(const KeyValue<T>& field) {
+				return Log::operator<<(field);
+			}
+			inline Log& operator<<(SuppressedManip m) {
+				return Log::operator<<(m);
+			}
+			inline Log& operator<<(CategoryManip m) {
+				return Log::operator<<(m);
+			}
+			template <typename F>
+				requires std::invocable<F&> && (!std::is_void_v<std::invoke_result_t<F&>>)
+			inline Log& operator<<(F&& fn) {
+				return Log::operator<<(std::forward<F>(fn));
+			}
+			//@}
+
+		private:
+			std::shared_ptr<BinaryWriter> m_writer;
+
+			Implementation& Active() noexcept override;
+			void Collect(LogStats& stats) const override;
+
+			void Write(bool v) override;
+			void Write(char v) override;
+			void Write(signed char v) override;
+			void Write(unsigned char v) override;
+			void Write(short v) override;
+			void Write(unsigned short v) override;
+			void Write(int v) override;
+			void Write(unsigned int v) override;
+			void Write(long v) override;
+			void Write(unsigned long v) override;
+			void Write(long long v) override;
+			void Write(unsigned long long v) override;
+			void Write(float v) override;
+			void Write(double v) override;
+			void Write(long double v) override;
+			void Write(const std::string& v) override;
+			void Write(const char* v) override;
+			void Write(const std::wstring& v) override;
+			void Write(const wchar_t* v) override;
+			void Write(const Level& level) override;
+			void Write(std::ostream& (*manip)(std::ostream&)) override;
+			void Write(Log& (*manip)(Log&) noexcept) override;
+			void Write(RedactManip m) override;
+			void Write(PrecisionManip m) override;
+			void Write(std::ios_base& (*manip)(std::ios_base&)) override;
+			void Write(KeyManip m) override;
+	};
+}
@@ -0,0 +1,65 @@
+#include <StormByte/logger/category.hxx>
+
+using namespace StormByte::Logger;
+
+Categories::Categories(const Level& level) {
+	Category::Node& root = m_nodes.emplace_back(std::string{}, nullptr, level);
+	root.level = level;
+}
+
+Category Categories::Get(std::string_view name) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return Category(node(name));
+}
+
+void Categories::SetLevel(std::string_view name, const Level& level) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Category::Node& target = node(name);
+	target.level = level;
+	publish(target);
+}
+
+void Categories::ResetLevel(std::string_view name) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	Category::Node& target = node(name);
+	if (!target.parent)
+		return;
+	target.level.reset();
+	publish(target);
+}
+
+Category::Node& Categories::node(std::string_view name) {
+	Category::Node* current = &m_nodes.front();
+	std::size_t start = 0;
+	while (start < name.size()) {
+		std::size_t end = name.find('.', start);
+		if (end == std::string_view::npos)
+			end = name.size();
+		const std::string_view path = name.substr(0, end);
+
+		Category::Node* child = nullptr;
+		for (Category::Node* candidate : current->children) {
+			if (candidate->name == path) {
+				child = candidate;
+				break;
+			}
+		}
+		if (!child) {
+			child = &m_nodes.emplace_back(std::string{ path }, current,
+										  current->effective.load(std::memory_order_relaxed));
+			current->children.push_back(child);
+		}
+		current = child;
+		start = end + 1;
+	}
+	return *current;
+}
+
+void Categories::publish(Category::Node& node) noexcept {
+	const Level effective = node.level ? *node.level : node.parent->effective.load(std::memory_order_relaxed);
+	node.effective.store(effective, std::memory_order_relaxed);
+	for (Category::Node* child : node.children) {
+		if (!child->level)
+			publish(*child);
+	}
+}
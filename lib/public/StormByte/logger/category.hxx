@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/macros.h>
+#include <StormByte/logger/manipulators.hxx>
+#include <StormByte/logger/typedefs.hxx>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	class Categories;
+
+	/**
+	 * @class Category
+	 * @brief Handle to a named category of a Categories registry.
+	 *
+	 * Cheap to copy and meant to be kept (e.g. as a member or a static) by the subsystem it
+	 * names. The category's effective level is resolved by the registry whenever a level
+	 * changes and published in the category itself, so Enabled() is a single relaxed load.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC Category final {
+		friend class Categories;
+
+		public:
+			Category(const Category&) noexcept = default;
+			Category(Category&&) noexcept = default;
+			~Category() noexcept = default;
+			Category& operator=(const Category&) noexcept = default;
+			Category& operator=(Category&&) noexcept = default;
+
+			/**
+			 * @brief Whether statements at @p level pass this category's filter.
+			 * @param level Level of the statement.
+			 * @return true if @p level is at or above the effective level.
+			 */
+			bool Enabled(const Level& level) const noexcept {
+				return level >= m_node->effective.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Current effective level: the category's own, or the closest ancestor's.
+			 * @return Effective level.
+			 */
+			Level EffectiveLevel() const noexcept {
+				return m_node->effective.load(std::memory_order_relaxed);
+			}
+
+			/**
+			 * @brief Full dotted name.
+			 * @return Name (empty for the root category).
+			 */
+			std::string_view Name() const noexcept {
+				return m_node->name;
+			}
+
+			/**
+			 * @brief Manipulator tagging a line with this category.
+			 * @return Manipulator writing `category=name`.
+			 */
+			CategoryManip Tag() const noexcept {
+				return CategoryManip{ m_node->name.c_str() };
+			}
+
+		private:
+			/**
+			 * @brief A category in the registry tree (private).
+			 */
+			struct Node {
+				std::string name;							///< Full dotted name
+				Node* parent;								///< Enclosing category; null for the root
+				std::vector<Node*> children;				///< Direct subcategories
+				std::optional<Level> level;					///< Level set on this category, if any
+				std::atomic<Level> effective;				///< Resolved level, read lock-free by handles
+
+				Node(std::string node_name, Node* parent_node, const Level& initial):
+					name(std::move(node_name)), parent(parent_node), children(), level(std::nullopt), effective(initial) {}
+			};
+
+			const Node* m_node;								///< Category; owned by the registry
+
+			Category(const Node& node) noexcept: m_node(&node) {}
+	};
+
+	/**
+	 * @class Categories
+	 * @brief Registry of hierarchical, dotted categories (`"net"`, `"net.http"`, ...).
+	 *
+	 * A category without its own level inherits the one of its closest ancestor, up to the
+	 * root (the empty name). Levels can be changed at run time from any thread: the registry
+	 * resolves the new effective levels of the affected subtree under its own mutex and
+	 * publishes each with one atomic store, so handles see the change on their next check
+	 * without taking any lock.
+	 *
+	 * Categories only filter; the lines go to whatever logger the statement names, so any
+	 * number of categories share the same sinks. The registry must outlive its handles.
+	 *
+	 * @code
+	 * Categories categories(Level::Info);
+	 * static const Category http = categories.Get("net.http");
+	 *
+	 * STORMBYTE_LOG_CATEGORY(log, http, Level::Debug) << "GET " << path << endr;	// filtered
+	 * categories.SetLevel("net", Level::Debug);									// from any thread
+	 * STORMBYTE_LOG_CATEGORY(log, http, Level::Debug) << "GET " << path << endr;
+	 * // [Debug] 16/10/2026 12:00:01 category=net.http GET /index.html
+	 * @endcode
+	 */
+	class STORMBYTE_LOGGER_PUBLIC Categories final {
+		public:
+			/**
+			 * @brief Construct a registry.
+			 * @param level Level of the root category, inherited by every category without its own.
+			 */
+			Categories(const Level& level = Level::Info);
+
+			Categories(const Categories&) = delete;
+			Categories(Categories&&) = delete;
+			~Categories() noexcept = default;
+			Categories& operator=(const Categories&) = delete;
+			Categories& operator=(Categories&&) = delete;
+
+			/**
+			 * @brief Handle of the category @p name, creating it and its ancestors as needed.
+			 * @param name Dotted name; empty for the root.
+			 * @return Handle valid for the lifetime of the registry.
+			 */
+			Category Get(std::string_view name);
+
+			/**
+			 * @brief Set the level of @p name and of every subcategory that inherits it.
+			 * @param name Dotted name; empty for the root.
+			 * @param level New level.
+			 */
+			void SetLevel(std::string_view name, const Level& level);
+
+			/**
+			 * @brief Make @p name inherit its parent's level again.
+			 *
+			 * The root always keeps a level of its own; resetting it does nothing.
+			 * @param name Dotted name.
+			 */
+			void ResetLevel(std::string_view name);
+
+		private:
+			std::mutex m_mutex;								///< Serializes Get() and level changes
+			std::deque<Category::Node> m_nodes;				///< Front is the root; never relocated
+
+			/**
+			 * @brief Find or create the node of @p name (m_mutex held).
+			 * @param name Dotted name.
+			 * @return Node of @p name.
+			 */
+			Category::Node& node(std::string_view name);
+
+			/**
+			 * @brief Resolve and publish the effective level of @p node and of the subtree inheriting it (m_mutex held).
+			 * @param node Node whose level or parent's level changed.
+			 */
+			static void publish(Category::Node& node) noexcept;
+	};
+}
+
+/**
+ * @brief Start a log statement that is skipped unless @p category enables @p level.
+ * @param logger Log, ThreadedLog, AsyncLog or a smart pointer to one.
+ * @param category Category handle; evaluated once.
+ * @param level Constant Level of the statement (also stripped as in @ref STORMBYTE_LOG).
+ *
+ * A filtered statement takes no lock and evaluates none of its operands. An emitted line
+ * starts with the category's name as the `category` field; the logger's own level still
+ * applies after the category's.
+ */
+#define STORMBYTE_LOG_CATEGORY(logger, category, level) \
+	if constexpr (!STORMBYTE_LOGGER_COMPILED_IN(level)) {} \
+	else if (const ::StormByte::Logger::Category& stormbyte_category_ = (category); !stormbyte_category_.Enabled(level)) {} \
+	else (logger) << (level) << stormbyte_category_.Tag()
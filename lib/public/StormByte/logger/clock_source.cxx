@@ -0,0 +1,12 @@
+#include <StormByte/logger/clock_source.hxx>
+#include <StormByte/logger/tick_clock.hxx>
+
+namespace StormByte::Logger {
+	STORMBYTE_LOGGER_PUBLIC void SetClockSource(const ClockSource& source) {
+		TickClock::Use(source);
+	}
+
+	STORMBYTE_LOGGER_PUBLIC ClockStatus GetClockStatus() noexcept {
+		return TickClock::Status();
+	}
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <cstdint>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @enum ClockSource
+	 * @brief Where header timestamps come from.
+	 */
+	enum class STORMBYTE_LOGGER_PUBLIC ClockSource : unsigned short {
+		System = 0,								///< std::chrono::system_clock read per header
+		Counter									///< CPU counter (rdtsc on x86-64, cntvct_el0 on ARM64) calibrated to wall time in the background
+	};
+
+	/**
+	 * @struct ClockStatus
+	 * @brief State of the header clock.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC ClockStatus {
+		ClockSource source = ClockSource::System;	///< Source in use
+		bool invariant = false;					///< The counter ticks at a constant rate; if not, steady_clock stands in for it
+		double ticks_per_second = 0;			///< Calibrated tick rate (0 until ClockSource::Counter is first selected)
+		std::uint64_t calibrations = 0;			///< Calibrations done so far
+		std::int64_t correction_ns = 0;			///< Wall-clock error the latest calibration corrected (drift since the previous one)
+	};
+
+	/**
+	 * @brief Select the clock of every logger's header timestamps.
+	 *
+	 * ClockSource::Counter replaces the system clock call behind each header (and each
+	 * flight recorder capture) with a read of the CPU counter; records keep the raw ticks and
+	 * convert them to wall time only when the time is rendered. The first selection measures
+	 * the counter against the system clock for 10 ms and starts a background thread that
+	 * re-anchors it every second, so header times track the system clock (including its
+	 * adjustments) to within the drift of one second. Where the counter is missing or not
+	 * invariant, std::chrono::steady_clock is read instead and anchored the same way.
+	 *
+	 * @code
+	 * SetClockSource(ClockSource::Counter);
+	 * log << Level::Info << "started" << std::endl;	// [Info] 16/10/2026 12:00:00 started
+	 * @endcode
+	 * @param source Clock to use from now on.
+	 */
+	STORMBYTE_LOGGER_PUBLIC void SetClockSource(const ClockSource& source);
+
+	/**
+	 * @brief Current header clock and its calibration.
+	 * @return Snapshot of the clock state.
+	 */
+	STORMBYTE_LOGGER_PUBLIC ClockStatus GetClockStatus() noexcept;
+}
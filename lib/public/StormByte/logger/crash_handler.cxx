@@ -0,0 +1,194 @@
+#include <StormByte/logger/crash_handler.hxx>
+#include <StormByte/logger/crash_registry.hxx>
+#include <StormByte/platform.h>
+
+#include <atomic>
+#include <csignal>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <string_view>
+
+using namespace StormByte::Logger;
+
+namespace {
+	struct FatalSignal {
+		int number;
+		const char* name;
+	};
+
+	constexpr FatalSignal fatal_signals[] = {
+		{ SIGSEGV, "SIGSEGV" },
+		{ SIGABRT, "SIGABRT" },
+#ifndef WINDOWS
+		{ SIGBUS, "SIGBUS" },
+#endif
+		{ SIGILL, "SIGILL" },
+		{ SIGFPE, "SIGFPE" },
+	};
+	constexpr std::size_t fatal_count = std::size(fatal_signals);
+
+#ifdef WINDOWS
+	using Disposition = void (*)(int);
+#else
+	using Disposition = struct sigaction;
+	constexpr std::size_t alternate_stack_size = 64 * 1024;
+
+	// A thread's alternate signal stack, taken down again before its memory is freed.
+	class AlternateStack {
+		public:
+			~AlternateStack() {
+				stack_t current{};
+				if (!m_memory || ::sigaltstack(nullptr, &current) != 0 || current.ss_sp != m_memory.get())
+					return;
+				stack_t disable{};
+				disable.ss_flags = SS_DISABLE;
+				::sigaltstack(&disable, nullptr);
+			}
+
+			bool Prepare() noexcept {
+				if (m_memory)
+					return true;
+				stack_t current{};
+				if (::sigaltstack(nullptr, &current) != 0)
+					return false;
+				if ((current.ss_flags & SS_DISABLE) == 0)
+					return true;	// The thread has one already
+				m_memory.reset(new (std::nothrow) char[alternate_stack_size]);
+				if (!m_memory)
+					return false;
+				stack_t stack{};
+				stack.ss_sp = m_memory.get();
+				stack.ss_size = alternate_stack_size;
+				if (::sigaltstack(&stack, nullptr) != 0) {
+					m_memory.reset();
+					return false;
+				}
+				return true;
+			}
+
+		private:
+			std::unique_ptr<char[]> m_memory;
+	};
+
+	thread_local AlternateStack t_alternate_stack;
+#endif
+
+	Disposition previous[fatal_count];
+	std::atomic<bool> installed{ false };
+	std::atomic<bool> crashing{ false };
+	std::atomic<bool> drained{ false };
+	// Set by the thread that drains; a plain flag, as thread ids are not async-signal-safe to read.
+	thread_local volatile std::sig_atomic_t t_draining = 0;
+
+	// "fatal signal N (NAME)\n" without formatting facilities that are not signal-safe.
+	std::size_t fatal_record(char* out, int number) noexcept {
+		std::size_t length = 0;
+		for (const char* p = "fatal signal "; *p; ++p)
+			out[length++] = *p;
+		char digits[12];
+		std::size_t count = 0;
+		unsigned value = number < 0 ? 0u : static_cast<unsigned>(number);
+		do {
+			digits[count++] = static_cast<char>('0' + value % 10);
+			value /= 10;
+		} while (value > 0);
+		while (count > 0)
+			out[length++] = digits[--count];
+		for (const auto& signal : fatal_signals) {
+			if (signal.number != number)
+				continue;
+			out[length++] = ' ';
+			out[length++] = '(';
+			for (const char* p = signal.name; *p; ++p)
+				out[length++] = *p;
+			out[length++] = ')';
+		}
+		out[length++] = '\n';
+		return length;
+	}
+
+	void restore(std::size_t index) noexcept {
+#ifdef WINDOWS
+		std::signal(fatal_signals[index].number, previous[index]);
+#else
+		::sigaction(fatal_signals[index].number, &previous[index], nullptr);
+#endif
+	}
+
+	void on_fatal_signal(int number) {
+		if (!crashing.exchange(true, std::memory_order_acq_rel)) {
+			t_draining = 1;
+			char record[64];
+			CrashRegistry::Drain(std::string_view{ record, fatal_record(record, number) });
+			drained.store(true, std::memory_order_release);
+		} else if (t_draining != 0) {
+			// Saving the output crashed this very thread: waiting would never end, give up on it.
+		} else {
+			// Another thread is already saving the output: let it finish first.
+			while (!drained.load(std::memory_order_acquire)) {}
+		}
+
+		for (std::size_t i = 0; i < fatal_count; ++i) {
+			if (fatal_signals[i].number == number)
+				restore(i);
+		}
+		std::raise(number);
+	}
+}
+
+bool CrashHandler::Install() noexcept {
+	if (installed.exchange(true, std::memory_order_acq_rel))
+		return true;
+
+#ifdef WINDOWS
+	for (std::size_t i = 0; i < fatal_count; ++i) {
+		previous[i] = std::signal(fatal_signals[i].number, on_fatal_signal);
+		if (previous[i] == SIG_ERR) {
+			while (i-- > 0)
+				restore(i);
+			installed.store(false, std::memory_order_release);
+			return false;
+		}
+	}
+#else
+	PrepareThread();
+
+	struct sigaction action{};
+	action.sa_handler = on_fatal_signal;
+	action.sa_flags = SA_ONSTACK;
+	// A second fatal signal waits until the handler is done instead of interrupting the drain.
+	sigemptyset(&action.sa_mask);
+	for (const auto& signal : fatal_signals)
+		sigaddset(&action.sa_mask, signal.number);
+	for (std::size_t i = 0; i < fatal_count; ++i) {
+		if (::sigaction(fatal_signals[i].number, &action, &previous[i]) != 0) {
+			while (i-- > 0)
+				restore(i);
+			installed.store(false, std::memory_order_release);
+			return false;
+		}
+	}
+#endif
+	return true;
+}
+
+void CrashHandler::Uninstall() noexcept {
+	if (!installed.exchange(false, std::memory_order_acq_rel))
+		return;
+	for (std::size_t i = 0; i < fatal_count; ++i)
+		restore(i);
+}
+
+bool CrashHandler::Installed() noexcept {
+	return installed.load(std::memory_order_acquire);
+}
+
+bool CrashHandler::PrepareThread() noexcept {
+#ifdef WINDOWS
+	return true;
+#else
+	return t_alternate_stack.Prepare();
+#endif
+}
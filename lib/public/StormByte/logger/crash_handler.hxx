@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class CrashHandler
+	 * @brief Opt-in handler that saves buffered log output when the process dies on a fatal signal.
+	 *
+	 * Once installed, SIGSEGV, SIGABRT, SIGBUS, SIGILL and SIGFPE write out, with
+	 * async-signal-safe operations only, what every live sink still holds:
+	 * - the sink's own buffer (FileSink, RotatingFileSink) through write(2), or the last
+	 *   complete record committed (MappedFileSink);
+	 * - the records still queued by an AsyncLog writing to that sink;
+	 * - a final `fatal signal N (NAME)` line.
+	 *
+	 * The previous disposition of the signal is then restored and the signal raised again,
+	 * so core dumps and other handlers keep working. Lines that were still being built, and
+	 * loggers writing to plain streams, are not covered. Other threads are not stopped: a
+	 * record they write at the same time may appear twice or be cut.
+	 *
+	 * A stack overflow runs the handler on the thread's alternate signal stack, and POSIX
+	 * gives each thread its own. Install() sets one up for the calling thread; other threads
+	 * that should report an overflow call PrepareThread() when they start.
+	 *
+	 * @code
+	 * FileSink sink("/var/log/app.log", 256 * 1024);
+	 * AsyncLog log(sink, Level::Info, "[%L] %T");
+	 * CrashHandler::Install();
+	 * @endcode
+	 */
+	class STORMBYTE_LOGGER_PUBLIC CrashHandler final {
+		public:
+			CrashHandler() = delete;
+
+			/**
+			 * @brief Install the handler (idempotent).
+			 *
+			 * Also gives the calling thread an alternate signal stack, if it has none, so a
+			 * stack overflow on it can still be reported.
+			 * @return false if a handler could not be installed.
+			 */
+			static bool Install() noexcept;
+
+			/**
+			 * @brief Restore the dispositions that were replaced by Install().
+			 */
+			static void Uninstall() noexcept;
+
+			/**
+			 * @brief Whether the handler is installed.
+			 * @return true between Install() and Uninstall().
+			 */
+			static bool Installed() noexcept;
+
+			/**
+			 * @brief Give the calling thread an alternate signal stack, if it has none.
+			 *
+			 * Without one, a stack overflow on the thread kills the process before the handler
+			 * can run. The stack is released when the thread exits. Does nothing on Windows.
+			 * @return false if the stack could not be set up.
+			 */
+			static bool PrepareThread() noexcept;
+	};
+}
@@ -0,0 +1,84 @@
+#include <StormByte/logger/fanout_log.hxx>
+#include <StormByte/logger/fanout_writer.hxx>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// The base Log needs a stream; every line goes through the writer instead.
+	std::ostream& unused_stream() {
+		static std::ostream stream(nullptr);
+		return stream;
+	}
+}
+
+FanoutLog::FanoutLog(const std::vector<Route>& routes, const HeaderFormat& format):
+	Log(unused_stream(), FanoutWriter::LowestLevel(routes), format),
+	m_writer(std::make_shared<FanoutWriter>(routes, format)) {
+	StageFilter(m_writer->Registry());
+}
+
+void FanoutLog::Flush() noexcept {
+	m_writer->Flush();
+}
+
+Implementation& FanoutLog::Active() noexcept {
+	return m_writer->Local().impl;
+}
+
+void FanoutLog::Collect(LogStats& stats) const {
+	m_writer->Collect(stats);
+}
+
+void FanoutLog::Write(bool v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(char v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(signed char v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(unsigned char v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(short v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(unsigned short v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(int v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(unsigned int v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(long v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(unsigned long v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(long long v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(unsigned long long v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(float v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(double v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(long double v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(const std::string& v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(const char* v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(const std::wstring& v) { m_writer->Local().impl << v; }
+void FanoutLog::Write(const wchar_t* v) { m_writer->Local().impl << v; }
+
+void FanoutLog::Write(const Level& level) {
+	// Switching level mid-line terminates the line, which is then delivered.
+	FanoutStage& stage = m_writer->Local();
+	stage.impl << level;
+	m_writer->Commit(stage);
+}
+
+void FanoutLog::Write(std::ostream& (*manip)(std::ostream&)) {
+	FanoutStage& stage = m_writer->Local();
+	stage.impl << manip;
+	m_writer->Commit(stage);
+}
+
+void FanoutLog::Write(Log& (*manip)(Log&) noexcept) {
+	Log::Write(manip);
+	m_writer->Commit(m_writer->Local());
+}
+
+void FanoutLog::Write(RedactManip m) {
+	m_writer->Local().impl.SetRedact(true, m.count, m.keep_first);
+}
+
+void FanoutLog::Write(PrecisionManip m) {
+	m_writer->Local().impl.SetPrecision(m.digits);
+}
+
+void FanoutLog::Write(std::ios_base& (*manip)(std::ios_base&)) {
+	m_writer->Local().impl << manip;
+}
+
+void FanoutLog::Write(KeyManip m) {
+	m_writer->Local().impl.SetKey(m.key);
+}
@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/log.hxx>
+
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <vector>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	class FanoutWriter;
+
+	/**
+	 * @struct Route
+	 * @brief One destination of a FanoutLog: a stream or sink, its minimum level and header format.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC Route {
+		std::ostream* out;								///< Destination stream
+		Level level;									///< Minimum Level written to it
+		std::optional<HeaderFormat> format;				///< Header format; the logger's when empty
+
+		/**
+		 * @brief Route to a stream.
+		 * @param out Output stream; it must outlive the logger.
+		 * @param level Minimum Level written to @p out.
+		 * @param format Header format for @p out; the logger's when empty.
+		 */
+		Route(std::ostream& out, const Level& level = Level::Info, std::optional<HeaderFormat> format = std::nullopt):
+			out(&out), level(level), format(std::move(format)) {}
+
+		/**
+		 * @brief Route to a Sink.
+		 * @param sink Output sink; it must outlive the logger.
+		 * @param level Minimum Level written to @p sink.
+		 * @param format Header format for @p sink; the logger's when empty.
+		 */
+		Route(Sink& sink, const Level& level = Level::Info, std::optional<HeaderFormat> format = std::nullopt):
+			Route(sink.Stream(), level, std::move(format)) {}
+	};
+
+	/**
+	 * @class FanoutLog
+	 * @brief Logging facade writing every line to several destinations, each with its own level and header.
+	 *
+	 * @code
+	 * FanoutLog log({ Route(errors, Level::Error), Route(debug, Level::Debug, "[%L] %I.%6 %i") }, "[%L] %T");
+	 * log << Level::Warning << "disk " << pct << "% full" << std::endl;   // formatted once, written to debug only
+	 * @endcode
+	 *
+	 * The message is formatted once per line into a per-thread buffer, filtered at the lowest
+	 * level of any route, so a line no route accepts costs no formatting. When the line ends
+	 * its header is rendered once per distinct format among the routes accepting its level,
+	 * and each of them receives the whole line with one write.
+	 *
+	 * Level, human-readable and redaction state are tracked per thread and, as with
+	 * LineMode::Staged, `std::endl` ends the line without flushing (see Flush()). Copies share
+	 * the routes; unterminated lines are written when the last copy is destroyed.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC FanoutLog : public Log {
+		public:
+			/**
+			 * @brief Construct a FanoutLog.
+			 * @param routes Destinations.
+			 * @param format Header format (see Log) of routes without their own; its line encoding
+			 * applies to every route.
+			 */
+			FanoutLog(const std::vector<Route>& routes, const HeaderFormat& format = "[%L] %T");
+
+			FanoutLog(const FanoutLog&) = default;
+			FanoutLog(FanoutLog&&) noexcept = default;
+			~FanoutLog() noexcept = default;
+			FanoutLog& operator=(const FanoutLog&) = default;
+			FanoutLog& operator=(FanoutLog&&) noexcept = default;
+
+			/**
+			 * @brief Flush every destination. Lines still being assembled are not written.
+			 */
+			void Flush() noexcept;
+
+			/**
+			 * @name Streaming Operators
+			 * Same contract as Log; data overloads early-out when filtered.
+			 */
+			//@{
+			inline Log& operator<<(bool v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(signed char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned char v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(short v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned short v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(int v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned int v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(unsigned long long v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(float v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(double v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(long double v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const std::string& v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const char* v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const std::wstring& v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const wchar_t* v) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(v);
+				return *this;
+			}
+			inline Log& operator<<(const Level& level) {
+				if (m_report) [[unlikely]] Report();
+				Write(level);
+				return *this;
+			}
+			inline Log& operator<<(std::ostream& (*manip)(std::ostream&)) {
+				Write(manip);
+				return *this;
+			}
+			inline Log& operator<<(Log& (*manip)(Log&) noexcept) {
+				Write(manip);
+				return *this;
+			}
+			inline Log& operator<<(RedactManip m) {
+				Write(m);
+				return *this;
+			}
+			inline Log& operator<<(PrecisionManip m) {
+				Write(m);
+				return *this;
+			}
+			inline Log& operator<<(std::ios_base& (*manip)(std::ios_base&)) {
+				Write(manip);
+				return *this;
+			}
+			template <typename T>
+			inline Log& operator<<(const KeyValue<T>& field) {
+				return Log::operator<<(field);
+			}
+			inline Log& operator<<(SuppressedManip m) {
+				return Log::operator<<(m);
+			}
+			inline Log& operator<<(CategoryManip m) {
+				return Log::operator<<(m);
+			}
+			template <typename F>
+				requires std::invocable<F&> && (!std::is_void_v<std::invoke_result_t<F&>>)
+			inline Log& operator<<(F&& fn) {
+				return Log::operator<<(std::forward<F>(fn));
+			}
+			//@}
+
+		private:
+			std::shared_ptr<FanoutWriter> m_writer;
+
+			Implementation& Active() noexcept override;
+			void Collect(LogStats& stats) const override;
+
+			void Write(bool v) override;
+			void Write(char v) override;
+			void Write(signed char v) override;
+			void Write(unsigned char v) override;
+			void Write(short v) override;
+			void Write(unsigned short v) override;
+			void Write(int v) override;
+			void Write(unsigned int v) override;
+			void Write(long v) override;
+			void Write(unsigned long v) override;
+			void Write(long long v) override;
+			void Write(unsigned long long v) override;
+			void Write(float v) override;
+			void Write(double v) override;
+			void Write(long double v) override;
+			void Write(const std::string& v) override;
+			void Write(const char* v) override;
+			void Write(const std::wstring& v) override;
+			void Write(const wchar_t* v) override;
+			void Write(const Level& level) override;
+			void Write(std::ostream& (*manip)(std::ostream&)) override;
+			void Write(Log& (*manip)(Log&) noexcept) override;
+			void Write(RedactManip m) override;
+			void Write(PrecisionManip m) override;
+			void Write(std::ios_base& (*manip)(std::ios_base&)) override;
+			void Write(KeyManip m) override;
+	};
+}
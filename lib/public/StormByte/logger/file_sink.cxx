@@ -0,0 +1,41 @@
+#include <StormByte/logger/file_sink.hxx>
+#include <StormByte/logger/crash_registry.hxx>
+#include <StormByte/logger/file_buffer.hxx>
+
+using namespace StormByte::Logger;
+
+FileSink::FileSink(const std::filesystem::path& path, std::size_t buffer_size, std::size_t flush_threshold, const FlushPolicy& policy):
+	FileSink(FileBuffer::OpenAppend(path), true, buffer_size, flush_threshold, policy) {}
+
+FileSink::FileSink(int fd, bool owns_fd, std::size_t buffer_size, std::size_t flush_threshold, const FlushPolicy& policy):
+	FileSink(std::make_unique<FileBuffer>(fd, owns_fd, buffer_size, flush_threshold, policy)) {}
+
+FileSink::FileSink(std::unique_ptr<FileBuffer> buffer):
+	m_buffer(std::move(buffer)) {
+	Attach(m_buffer.get());
+	CrashRegistry::Add(*this);
+}
+
+FileSink::~FileSink() noexcept {
+	CrashRegistry::Remove(*this);
+}
+
+bool FileSink::IsOpen() const noexcept {
+	return m_buffer->Descriptor() >= 0;
+}
+
+void FileSink::Flush() noexcept {
+	m_buffer->Drain();
+}
+
+std::uint64_t FileSink::DroppedBytes() const noexcept {
+	return m_buffer->DroppedBytes();
+}
+
+bool FileSink::CrashDrain() noexcept {
+	return m_buffer->CrashDrain();
+}
+
+void FileSink::CrashWrite(const char* data, std::size_t size) noexcept {
+	m_buffer->CrashWrite(data, size);
+}
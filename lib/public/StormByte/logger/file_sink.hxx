@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/sink.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	class FileBuffer;
+
+	/**
+	 * @class FileSink
+	 * @brief Buffered file output for loggers, written with write()/writev() on a descriptor.
+	 *
+	 * Records accumulate in one large aligned buffer and reach the file in batches, without
+	 * std::ofstream's per-character conversion layer. Pass the sink to a logger constructor;
+	 * the sink must outlive every logger writing to it.
+	 *
+	 * @code
+	 * FileSink sink("/var/log/app.log", 256 * 1024, 64 * 1024, FlushPolicy::Batched);
+	 * ThreadedLog log(sink, Level::Info, "[%L] %T");
+	 * log << Level::Info << "started" << endr;
+	 * @endcode
+	 *
+	 * With FlushPolicy::Immediate (default) std::endl / std::flush write the buffer out as
+	 * they would on a file stream, while @ref endr keeps batching. With FlushPolicy::Batched
+	 * stream flushes only count as record boundaries. Either way the buffer is written when
+	 * full, on Flush() and on destruction.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC FileSink: public Sink {
+		public:
+			/**
+			 * @brief Open @p path for appending (created with mode 0644 if missing).
+			 * @param path File to append to.
+			 * @param buffer_size Buffer capacity in bytes (minimum 4 KiB).
+			 * @param flush_threshold Buffered bytes that trigger a write at the next record boundary; 0 = only when full.
+			 * @param policy Effect of std::endl / std::flush.
+			 * @see IsOpen()
+			 */
+			explicit FileSink(const std::filesystem::path& path, std::size_t buffer_size = 64 * 1024,
+							  std::size_t flush_threshold = 0, const FlushPolicy& policy = FlushPolicy::Immediate);
+
+			/**
+			 * @brief Write to an already open descriptor.
+			 * @param fd Descriptor (e.g. STDERR_FILENO or a socket).
+			 * @param owns_fd Close @p fd when the sink is destroyed.
+			 * @param buffer_size Buffer capacity in bytes (minimum 4 KiB).
+			 * @param flush_threshold Buffered bytes that trigger a write at the next record boundary; 0 = only when full.
+			 * @param policy Effect of std::endl / std::flush.
+			 */
+			FileSink(int fd, bool owns_fd, std::size_t buffer_size = 64 * 1024,
+					 std::size_t flush_threshold = 0, const FlushPolicy& policy = FlushPolicy::Immediate);
+
+			FileSink(const FileSink&) = delete;
+			FileSink(FileSink&&) noexcept = delete;
+			FileSink& operator=(const FileSink&) = delete;
+			FileSink& operator=(FileSink&&) noexcept = delete;
+
+			/**
+			 * @brief Write out buffered records and close the descriptor if owned.
+			 */
+			~FileSink() noexcept override;
+
+			/**
+			 * @brief Whether the sink has a descriptor to write to.
+			 * @return false if opening the path failed (output is then discarded).
+			 */
+			bool IsOpen() const noexcept;
+
+			/**
+			 * @brief Write out every buffered byte (see Sink::Flush()).
+			 */
+			void Flush() noexcept override;
+
+			/**
+			 * @brief Write the buffered bytes with write() from a fatal signal handler (see Sink::CrashDrain()).
+			 */
+			bool CrashDrain() noexcept override;
+
+			/**
+			 * @brief Write bytes straight to the descriptor from a fatal signal handler (see Sink::CrashWrite()).
+			 */
+			void CrashWrite(const char* data, std::size_t size) noexcept override;
+
+			/**
+			 * @brief Bytes discarded because the descriptor was not open or a write failed.
+			 * @return Dropped byte count.
+			 */
+			std::uint64_t DroppedBytes() const noexcept;
+
+		protected:
+			/**
+			 * @brief Take over a prepared buffer (for derived sinks).
+			 * @param buffer Stream buffer the sink writes through.
+			 */
+			explicit FileSink(std::unique_ptr<FileBuffer> buffer);
+
+		private:
+			std::unique_ptr<FileBuffer> m_buffer;		///< Descriptor and batch buffer
+	};
+}
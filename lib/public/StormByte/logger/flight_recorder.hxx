@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/typedefs.hxx>
+
+#include <cstddef>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @enum FlightScope
+	 * @brief Whose captured records a flight recorder dump renders.
+	 */
+	enum class STORMBYTE_LOGGER_PRIVATE FlightScope : unsigned short {
+		Thread = 0,                              	///< Only the records of the thread writing the trigger line
+		All                                      	///< The records of every thread, merged by time
+	};
+
+	/**
+	 * @struct FlightRecorderOptions
+	 * @brief What a flight recorder captures and when it dumps it (see Log::EnableFlightRecorder()).
+	 *
+	 * Filtered records at or above @ref capture are kept per thread, as their raw values, in a
+	 * ring of @ref budget bytes that evicts the oldest records. When a line at or above
+	 * @ref trigger is written, up to @ref records of the most recent captured records are
+	 * rendered ahead of it, with their own level and time, and forgotten.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC FlightRecorderOptions {
+		Level capture = Level::LowLevel;						///< Lowest filtered level that is captured
+		Level trigger = Level::Error;							///< Lowest level whose lines dump the captured records
+		std::size_t records = 64;								///< Most recent records rendered by one dump
+		std::size_t budget = 64 * 1024;							///< Bytes of captured records kept per thread
+		FlightScope scope = FlightScope::Thread;				///< Records rendered by a dump
+	};
+}
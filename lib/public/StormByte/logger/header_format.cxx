@@ -0,0 +1,46 @@
+#include <StormByte/logger/header_format.hxx>
+
+using namespace StormByte::Logger;
+
+HeaderFormat::HeaderFormat(const char* format, const Encoding& encoding):
+	HeaderFormat(std::string(format ? format : ""), encoding) {}
+
+HeaderFormat::HeaderFormat(const std::string& format, const Encoding& encoding):
+	m_tokens(), m_literals(), m_encoding(encoding) {
+	std::size_t token_count = 0, literal_count = 0;
+	Compile(format, false, nullptr, token_count, nullptr, literal_count);
+	m_tokens.resize(token_count);
+	m_literals.resize(literal_count);
+	Compile(format, false, m_tokens.data(), token_count, m_literals.data(), literal_count);
+}
+
+std::string HeaderFormat::Pattern() const {
+	std::string pattern;
+	for (const auto& token : m_tokens) {
+		switch (token.field) {
+			case Field::Literal:
+				for (const char c : std::string_view(m_literals).substr(token.offset, token.length)) {
+					if (c == '%')
+						pattern += '%';
+					pattern += c;
+				}
+				break;
+			case Field::Level:			pattern += "%L"; break;
+			case Field::LocalTime:		pattern += "%T"; break;
+			case Field::UtcTime:		pattern += "%U"; break;
+			case Field::LocalIso:		pattern += "%I"; break;
+			case Field::UtcIso:			pattern += "%Z"; break;
+			case Field::UtcOffset:		pattern += "%z"; break;
+			case Field::Milliseconds:	pattern += "%3"; break;
+			case Field::Microseconds:	pattern += "%6"; break;
+			case Field::Nanoseconds:	pattern += "%9"; break;
+			case Field::ThreadId:		pattern += "%i"; break;
+			case Field::ThreadName:		pattern += "%n"; break;
+			case Field::ThreadTid:		pattern += "%t"; break;
+		}
+	}
+	// Compile() always appends the space separating header and message.
+	if (!pattern.empty())
+		pattern.pop_back();
+	return pattern;
+}
@@ -0,0 +1,310 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/typedefs.hxx>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @brief Compile-time string usable as a template argument.
+	 * @tparam N Size including the terminating null.
+	 */
+	template <std::size_t N>
+	struct FixedString {
+		char value[N] = {};							///< Characters (null terminated)
+
+		/**
+		 * @brief Capture a string literal.
+		 * @param s Literal to copy.
+		 */
+		consteval FixedString(const char (&s)[N]) {
+			for (std::size_t i = 0; i < N; ++i)
+				value[i] = s[i];
+		}
+
+		/**
+		 * @brief View without the terminating null.
+		 * @return String view.
+		 */
+		constexpr std::string_view View() const noexcept {
+			return { value, N - 1 };
+		}
+	};
+
+	template <FixedString Pattern>
+	struct StaticHeaderFormat;
+
+	/**
+	 * @class HeaderFormat
+	 * @brief Header format string compiled into a flat token program.
+	 *
+	 * The format is parsed once into literal spans and field operations, so rendering a
+	 * header is a walk over a few tokens instead of a character-by-character re-parse.
+	 * It converts implicitly from `const char*` and `std::string` (parsed at construction)
+	 * and from @ref header_format (parsed and validated at compile time).
+	 *
+	 * Specifiers: %L level, %T / %U local / UTC time, %I / %Z local / UTC ISO-8601 time,
+	 * %z UTC offset, %3 / %6 / %9 sub-second digits, %i thread id, %n thread name (the
+	 * kernel thread id when unnamed), %t kernel thread id, %% literal %.
+	 * At runtime an unknown specifier is kept as literal text; at compile time it is an error.
+	 *
+	 * With Encoding::Json or Encoding::Logfmt the header becomes fields instead: `level`
+	 * (always present), `time` (the time specifiers with the literal text between them),
+	 * `thread` (%i), `thread_name` (%n) and `tid` (%t); other literal text is dropped.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC HeaderFormat {
+		public:
+			/**
+			 * @enum Field
+			 * @brief Operation performed by a token.
+			 */
+			enum class Field : std::uint8_t {
+				Literal = 0,						///< Copy a span of literal text
+				Level,								///< %L
+				LocalTime,							///< %T
+				UtcTime,							///< %U
+				LocalIso,							///< %I
+				UtcIso,								///< %Z
+				UtcOffset,							///< %z
+				Milliseconds,						///< %3
+				Microseconds,						///< %6
+				Nanoseconds,						///< %9
+				ThreadId,							///< %i
+				ThreadName,							///< %n
+				ThreadTid							///< %t
+			};
+
+			/**
+			 * @struct Token
+			 * @brief One step of the program; literal tokens reference a span of Literals().
+			 */
+			struct Token {
+				Field field;						///< Operation
+				std::uint32_t offset;				///< Literal span start (Literal only)
+				std::uint32_t length;				///< Literal span length (Literal only)
+
+				constexpr bool operator==(const Token&) const noexcept = default;
+			};
+
+			/**
+			 * @brief Compile a runtime format string.
+			 * @param format Format string.
+			 * @param encoding Line encoding.
+			 */
+			HeaderFormat(const char* format, const Encoding& encoding = Encoding::Text);
+
+			/**
+			 * @brief Compile a runtime format string.
+			 * @param format Format string.
+			 * @param encoding Line encoding.
+			 */
+			HeaderFormat(const std::string& format, const Encoding& encoding = Encoding::Text);
+
+			/**
+			 * @brief Adopt a program compiled at compile time (no parsing).
+			 * @tparam Pattern Format string.
+			 * @param encoding Line encoding.
+			 */
+			template <FixedString Pattern>
+			HeaderFormat(const StaticHeaderFormat<Pattern>&, const Encoding& encoding = Encoding::Text):
+				m_tokens(StaticHeaderFormat<Pattern>::tokens.begin(), StaticHeaderFormat<Pattern>::tokens.end()),
+				m_literals(StaticHeaderFormat<Pattern>::literals.data(), StaticHeaderFormat<Pattern>::literals.size()),
+				m_encoding(encoding) {}
+
+			HeaderFormat(const HeaderFormat&) = default;
+			HeaderFormat(HeaderFormat&&) noexcept = default;
+			~HeaderFormat() noexcept = default;
+			HeaderFormat& operator=(const HeaderFormat&) = default;
+			HeaderFormat& operator=(HeaderFormat&&) noexcept = default;
+
+			/**
+			 * @brief The compiled program.
+			 * @return Tokens in rendering order.
+			 */
+			const std::vector<Token>& Tokens() const noexcept {
+				return m_tokens;
+			}
+
+			/**
+			 * @brief Literal text referenced by Literal tokens.
+			 * @return View over the literal storage.
+			 */
+			std::string_view Literals() const noexcept {
+				return m_literals;
+			}
+
+			/**
+			 * @brief How lines using this header are laid out.
+			 * @return Line encoding.
+			 */
+			const Encoding& LineEncoding() const noexcept {
+				return m_encoding;
+			}
+
+			/**
+			 * @brief Format string equivalent to the compiled program.
+			 *
+			 * Compiling the result yields the same program; unknown specifiers come back as
+			 * `%%` escapes. Used to store the format alongside deferred (binary) output.
+			 * @return Format string.
+			 */
+			std::string Pattern() const;
+
+			/**
+			 * @brief Parse @p format, emitting into optional outputs.
+			 *
+			 * Called once with null outputs to size them and once to fill them. The header is
+			 * always followed by a single space separating it from the message.
+			 *
+			 * @param format Format string.
+			 * @param strict true to reject unknown specifiers (only meaningful at compile time).
+			 * @param tokens Token output or nullptr.
+			 * @param token_count Receives the number of tokens.
+			 * @param literals Literal output or nullptr.
+			 * @param literal_count Receives the number of literal characters.
+			 */
+			static constexpr void Compile(std::string_view format, bool strict,
+										  Token* tokens, std::size_t& token_count,
+										  char* literals, std::size_t& literal_count) {
+				token_count = 0;
+				literal_count = 0;
+				bool in_literal = false;
+
+				auto literal = [&](char c) {
+					if (!in_literal) {
+						if (tokens)
+							tokens[token_count] = Token{ Field::Literal, static_cast<std::uint32_t>(literal_count), 0 };
+						++token_count;
+						in_literal = true;
+					}
+					if (tokens)
+						++tokens[token_count - 1].length;
+					if (literals)
+						literals[literal_count] = c;
+					++literal_count;
+				};
+				auto field = [&](Field f) {
+					if (tokens)
+						tokens[token_count] = Token{ f, 0, 0 };
+					++token_count;
+					in_literal = false;
+				};
+
+				for (std::size_t i = 0; i < format.size(); ++i) {
+					if (format[i] != '%' || (i + 1) >= format.size()) {
+						literal(format[i]);
+						continue;
+					}
+					switch (format[i + 1]) {
+						case '%': literal('%'); break;
+						case 'L': field(Field::Level); break;
+						case 'T': field(Field::LocalTime); break;
+						case 'U': field(Field::UtcTime); break;
+						case 'I': field(Field::LocalIso); break;
+						case 'Z': field(Field::UtcIso); break;
+						case 'z': field(Field::UtcOffset); break;
+						case '3': field(Field::Milliseconds); break;
+						case '6': field(Field::Microseconds); break;
+						case '9': field(Field::Nanoseconds); break;
+						case 'i': field(Field::ThreadId); break;
+						case 'n': field(Field::ThreadName); break;
+						case 't': field(Field::ThreadTid); break;
+						default:
+							if (strict)
+								UnknownSpecifier();
+							literal('%');
+							continue;
+					}
+					++i;
+				}
+				literal(' ');
+			}
+
+		private:
+			std::vector<Token> m_tokens;			///< Program
+			std::string m_literals;					///< Literal text storage
+			Encoding m_encoding;					///< Line encoding
+
+			/**
+			 * @brief Not constexpr on purpose: reaching it during constant evaluation is a compile error.
+			 */
+			static void UnknownSpecifier() noexcept {}
+	};
+
+	/**
+	 * @brief Header format compiled at compile time.
+	 *
+	 * Use through @ref header_format. Unknown specifiers fail to compile.
+	 * @tparam Pattern Format string.
+	 */
+	template <FixedString Pattern>
+	struct StaticHeaderFormat {
+		private:
+			struct Sizes {
+				std::size_t tokens;
+				std::size_t literals;
+			};
+
+			static constexpr Sizes sizes = [] {
+				Sizes s{};
+				HeaderFormat::Compile(Pattern.View(), true, nullptr, s.tokens, nullptr, s.literals);
+				return s;
+			}();
+
+		public:
+			/// Compiled program
+			static constexpr std::array<HeaderFormat::Token, sizes.tokens> tokens = [] {
+				std::array<HeaderFormat::Token, sizes.tokens> out{};
+				std::size_t token_count = 0, literal_count = 0;
+				HeaderFormat::Compile(Pattern.View(), true, out.data(), token_count, nullptr, literal_count);
+				return out;
+			}();
+
+			/// Literal text referenced by the program
+			static constexpr std::array<char, sizes.literals> literals = [] {
+				std::array<char, sizes.literals> out{};
+				std::size_t token_count = 0, literal_count = 0;
+				HeaderFormat::Compile(Pattern.View(), true, nullptr, token_count, out.data(), literal_count);
+				return out;
+			}();
+	};
+
+	/**
+	 * @brief Compile-time header format.
+	 *
+	 * @code
+	 * Log log(std::cout, Level::Info, header_format<"[%L] %T">);
+	 * @endcode
+	 * @tparam Pattern Format string.
+	 */
+	template <FixedString Pattern>
+	inline constexpr StaticHeaderFormat<Pattern> header_format{};
+}
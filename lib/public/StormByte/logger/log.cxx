@@ -1,31 +1,52 @@
 #include <StormByte/logger/log.hxx>
+#include <StormByte/logger/flight_ring.hxx>
 #include <StormByte/logger/implementation.hxx>
+#include <StormByte/logger/log_counters.hxx>
 
 using namespace StormByte::Logger;
 
-Log::Log(std::ostream& out, const Level& level, const std::string& format) {
-	m_impl = std::make_shared<Implementation>(out, level, format);
-}
-
-void Log::Write(bool v) { m_impl << v; }
-void Log::Write(char v) { m_impl << v; }
-void Log::Write(signed char v) { m_impl << v; }
-void Log::Write(unsigned char v) { m_impl << v; }
-void Log::Write(short v) { m_impl << v; }
-void Log::Write(unsigned short v) { m_impl << v; }
-void Log::Write(int v) { m_impl << v; }
-void Log::Write(unsigned int v) { m_impl << v; }
-void Log::Write(long v) { m_impl << v; }
-void Log::Write(unsigned long v) { m_impl << v; }
-void Log::Write(long long v) { m_impl << v; }
-void Log::Write(unsigned long long v) { m_impl << v; }
-void Log::Write(float v) { m_impl << v; }
-void Log::Write(double v) { m_impl << v; }
-void Log::Write(long double v) { m_impl << v; }
-void Log::Write(const std::string& v) { m_impl << v; }
-void Log::Write(const char* v) { m_impl << v; }
-void Log::Write(const std::wstring& v) { m_impl << v; }
-void Log::Write(const wchar_t* v) { m_impl << v; }
+namespace {
+	// The report line switches levels itself; it must not report again.
+	thread_local bool t_reporting = false;
+}
+
+#ifndef WINDOWS
+constinit thread_local Detail::StageFlag Detail::t_stage_flag{ 0, nullptr };
+#endif
+
+Log::Log(std::ostream& out, const Level& level, const HeaderFormat& format):
+	m_impl(std::make_shared<Implementation>(out, level, format)),
+	m_enabled(&m_impl->EnabledFlag()),
+	m_staging(0) {}
+
+bool Log::StageWillWrite() const noexcept {
+	// Active() is not const only because it may create the calling thread's stage.
+	const std::atomic<bool>& flag = const_cast<Log*>(this)->Active().EnabledFlag();
+#ifndef WINDOWS
+	Detail::t_stage_flag = { m_staging, &flag };
+#endif
+	return flag.load(std::memory_order_acquire);
+}
+
+void Log::Write(bool v) { m_impl->Append(v); }
+void Log::Write(char v) { m_impl->Append(v); }
+void Log::Write(signed char v) { m_impl->Append(v); }
+void Log::Write(unsigned char v) { m_impl->Append(v); }
+void Log::Write(short v) { m_impl->Append(v); }
+void Log::Write(unsigned short v) { m_impl->Append(v); }
+void Log::Write(int v) { m_impl->Append(v); }
+void Log::Write(unsigned int v) { m_impl->Append(v); }
+void Log::Write(long v) { m_impl->Append(v); }
+void Log::Write(unsigned long v) { m_impl->Append(v); }
+void Log::Write(long long v) { m_impl->Append(v); }
+void Log::Write(unsigned long long v) { m_impl->Append(v); }
+void Log::Write(float v) { m_impl->Append(v); }
+void Log::Write(double v) { m_impl->Append(v); }
+void Log::Write(long double v) { m_impl->Append(v); }
+void Log::Write(const std::string& v) { m_impl->Append(v); }
+void Log::Write(const char* v) { m_impl->Append(v); }
+void Log::Write(const std::wstring& v) { m_impl->Append(v); }
+void Log::Write(const wchar_t* v) { m_impl->Append(v); }
 void Log::Write(const Level& level) { m_impl << level; }
 void Log::Write(std::ostream& (*manip)(std::ostream&)) { m_impl << manip; }
 void Log::Write(Log& (*manip)(Log&) noexcept) { manip(*this); }
@@ -34,6 +55,71 @@ void Log::Write(RedactManip m) {
     m_impl->SetRedact(true, m.count, m.keep_first);
 }
 
-bool Log::WillWrite() const noexcept {
-	return m_impl->Enabled();
+void Log::Write(PrecisionManip m) {
+	m_impl->SetPrecision(m.digits);
+}
+
+void Log::Write(std::ios_base& (*manip)(std::ios_base&)) {
+	*m_impl << manip;
+}
+
+void Log::Write(KeyManip m) {
+	m_impl->SetKey(m.key);
+}
+
+LogRecord Log::Record(const Level& level) {
+	return LogRecord(*this, level);
+}
+
+bool Log::Enabled() noexcept {
+	return Active().Enabled();
+}
+
+void Log::EnableFlightRecorder(const FlightRecorderOptions& options) {
+	Attach(std::make_shared<FlightRecorder>(options));
+}
+
+LogStats Log::Stats() const {
+	LogStats stats;
+	Collect(stats);
+	return stats;
+}
+
+void Log::ReportStats(std::chrono::seconds interval, const Level& level) {
+	m_report = std::make_shared<StatsReport>(interval, level);
+}
+
+Implementation& Log::Active() noexcept {
+	return *m_impl;
+}
+
+void Log::Attach(const std::shared_ptr<FlightRecorder>& recorder) {
+	m_impl->SetRecorder(recorder);
+}
+
+void Log::Collect(LogStats& stats) const {
+	m_impl->Counters().Collect(stats);
+}
+
+void Log::Report() {
+	if (t_reporting || !m_report->Due())
+		return;
+	t_reporting = true;
+	const LogStats stats = Stats();
+	*this << m_report->ReportLevel() << "logger stats"
+		<< kv("emitted", stats.Emitted())
+		<< kv("filtered", stats.Filtered())
+		<< kv("bytes", stats.bytes)
+		<< kv("dropped", stats.dropped)
+		<< kv("queue_high_water", stats.queue_high_water)
+		<< kv("lock_wait_us", stats.lock_wait_ns / 1000)
+		<< kv("lock_hold_us", stats.lock_hold_ns / 1000)
+		<< kv("write_p99_ns", stats.write_latency.Percentile(99))
+		<< endr;
+	t_reporting = false;
+}
+
+void Log::SeparateField() {
+	if (Active().LineEncoding() == Encoding::Text)
+		*this << " ";
 }
\ No newline at end of file
@@ -19,19 +19,55 @@
 
 #pragma once
 
+#include <StormByte/logger/sink.hxx>
+#include <StormByte/logger/flight_recorder.hxx>
+#include <StormByte/logger/header_format.hxx>
+#include <StormByte/logger/macros.h>
 #include <StormByte/logger/manipulators.hxx>
+#include <StormByte/logger/stats.hxx>
+#include <StormByte/logger/thread_name.hxx>
 #include <StormByte/logger/typedefs.hxx>
+#include <StormByte/platform.h>
 
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <functional>
 #include <memory>
 #include <ostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 /**
  * @namespace StormByte::Logger
  * @brief Logging module for StormByte library.
  */
 namespace StormByte::Logger {
+	class FlightRecorder;
 	class Implementation;
+	class LogRecord;
+	class StatsReport;
+
+	namespace Detail {
+		/**
+		 * @struct StageFlag
+		 * @brief Enabled flag of the calling thread's stage in the staged logger it last tested.
+		 *
+		 * Lets facades with per-thread staging filter inline, like Log does with its shared
+		 * Implementation. Written and reset by the library only.
+		 */
+		struct StageFlag {
+			std::uint64_t registry;						///< Stage registry of the logger (0: none)
+			const std::atomic<bool>* flag;				///< The thread's flag there
+		};
+
+#ifndef WINDOWS
+		/// The calling thread's StageFlag (data with thread storage cannot be exported from a DLL).
+		extern STORMBYTE_LOGGER_PUBLIC constinit thread_local StageFlag t_stage_flag;
+#endif
+	}
 
 	/**
 	 * @class Log
@@ -45,19 +81,35 @@ namespace StormByte::Logger {
 		friend STORMBYTE_LOGGER_PUBLIC Log& humanreadable_bytes(Log& log) noexcept;
 		friend STORMBYTE_LOGGER_PUBLIC Log& nohumanreadable(Log& log) noexcept;
 		friend STORMBYTE_LOGGER_PUBLIC Log& no_redact(Log& log) noexcept;
+		friend STORMBYTE_LOGGER_PUBLIC Log& mask_secrets(Log& log) noexcept;
+		friend STORMBYTE_LOGGER_PUBLIC Log& no_mask_secrets(Log& log) noexcept;
+		friend STORMBYTE_LOGGER_PUBLIC Log& endr(Log& log) noexcept;
 
 		public:
 			/**
 			 * @brief Construct a Log writing to @p out.
 			 * @param out Output stream (e.g. std::cout).
 			 * @param level Minimum Level that will be emitted.
-			 * @param format Header format: %L level, %T timestamp, %i thread id, %% literal %.
+			 * @param format Header format: %L level, %T local time (dd/mm/YYYY HH:MM:SS), %U same in UTC,
+			 *               %I local ISO-8601 (YYYY-MM-DDTHH:MM:SS), %Z same in UTC, %z UTC offset (+hh:mm),
+			 *               %3 / %6 / %9 milli/micro/nanosecond digits, %i thread id, %n thread name
+			 *               (see SetThreadName; the kernel thread id when unnamed), %t kernel thread id, %% literal %.
+			 *               Accepts a string (compiled once here) or @ref header_format (compiled at build time).
+			 */
+			Log(std::ostream& out, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T");
+
+			/**
+			 * @brief Construct a Log writing to a Sink.
+			 * @param sink Output sink (FileSink, MappedFileSink, ...); it must outlive the logger.
+			 * @param level Minimum Level that will be emitted.
+			 * @param format Header format (see above).
 			 */
-			Log(std::ostream& out, const Level& level = Level::Info, const std::string& format = "[%L] %T");
+			Log(Sink& sink, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T"):
+				Log(sink.Stream(), level, format) {}
 
 			Log(const Log&) = default;
 			Log(Log&&) noexcept = default;
-			~Log() noexcept = default;
+			virtual ~Log() noexcept = default;
 			Log& operator=(const Log&) = default;
 			Log& operator=(Log&&) noexcept = default;
 
@@ -164,6 +216,7 @@ namespace StormByte::Logger {
 				return *this;
 			}
 			inline Log& operator<<(const Level& level) {
+				if (m_report) [[unlikely]] Report();
 				Write(level);
 				return *this;
 			}
@@ -182,15 +235,214 @@ namespace StormByte::Logger {
 				Write(m);
 				return *this;
 			}
+			/**
+			 * @brief Apply floating-point precision (fixed N decimals or shortest). State remains until changed.
+			 */
+			inline Log& operator<<(PrecisionManip m) {
+				Write(m);
+				return *this;
+			}
+			/**
+			 * @brief Select the integer base: std::dec, std::hex or std::oct. Other ios_base manipulators are ignored.
+			 */
+			inline Log& operator<<(std::ios_base& (*manip)(std::ios_base&)) {
+				Write(manip);
+				return *this;
+			}
+			/**
+			 * @brief Write a structured field built with @ref kv.
+			 */
+			template <typename T>
+			inline Log& operator<<(const KeyValue<T>& field) {
+				if (!WillWrite()) [[likely]] return *this;
+				Write(KeyManip{ field.key });
+				*this << field.value;
+				return *this;
+			}
+			/**
+			 * @brief Report the lines a Throttle suppressed (see Throttle::Suppressed()).
+			 */
+			inline Log& operator<<(SuppressedManip m) {
+				if (!WillWrite() || m.count == 0) [[likely]] return *this;
+				*this << kv("suppressed", m.count);
+				SeparateField();
+				return *this;
+			}
+			/**
+			 * @brief Tag the line with its Category (see Category::Tag()).
+			 */
+			inline Log& operator<<(CategoryManip m) {
+				if (!WillWrite() || *m.name == '\0') return *this;
+				*this << kv("category", m.name);
+				SeparateField();
+				return *this;
+			}
+			/**
+			 * @brief Stream the result of a nullary invocable, invoking it only if the current level is enabled.
+			 *
+			 * Lets expensive diagnostics stay in hot paths: `log << Level::Debug << [&]{ return dump(req); }`
+			 * costs one level check when Debug is filtered. The result goes through the normal
+			 * formatting and redaction path; an exception thrown by the invocable discards the value.
+			 */
+			template <typename F>
+				requires std::invocable<F&> && (!std::is_void_v<std::invoke_result_t<F&>>)
+			inline Log& operator<<(F&& fn) {
+				if (!Enabled()) [[likely]] return *this;
+				try {
+					*this << std::invoke(fn);
+				} catch (...) {}
+				return *this;
+			}
 			//@}
 
+			/**
+			 * @brief Start a record at @p level that ends (see @ref endr) when the handle is destroyed.
+			 *
+			 * @code
+			 * {
+			 *     auto record = log.Record(Level::Info);
+			 *     record << "user=" << id;
+			 *     if (admin) record << " (admin)";
+			 * } // newline written, line released / committed
+			 * @endcode
+			 * @param level Level of the record.
+			 * @return Handle streaming into this logger.
+			 */
+			LogRecord Record(const Level& level);
+
+			/**
+			 * @brief Whether a value streamed now by the calling thread would be written.
+			 * @return true if the current message level passes the filter.
+			 */
+			bool Enabled() noexcept;
+
+			/**
+			 * @brief Keep recent filtered records in memory and write them ahead of the next error.
+			 *
+			 * Filtered statements at or above FlightRecorderOptions::capture stop early-outing:
+			 * their values are kept raw (numbers unformatted, text copied) in a per-thread ring
+			 * with no header, formatting or I/O. The first line written at or above
+			 * FlightRecorderOptions::trigger is preceded by the most recent captured records,
+			 * rendered with their own level, time and thread. Lazy values (see operator<<(F&&))
+			 * are not invoked for captured records.
+			 *
+			 * Call it before the logger is shared between threads; copies share the recorder.
+			 * Log, ThreadedLog and AsyncLog capture (ThreadedLog in LineMode::Locked holds the
+			 * line lock while capturing, LineMode::Staged and LineMode::Sharded do not); FanoutLog and BinaryLog
+			 * ignore it.
+			 *
+			 * @code
+			 * Log log(std::cout, Level::Info);
+			 * log.EnableFlightRecorder({ .capture = Level::Debug, .records = 32 });
+			 * log << Level::Debug << "retry " << attempt << endr;	// captured, not written
+			 * log << Level::Error << "request failed" << endr;
+			 * // [Debug] 16/10/2026 12:00:00 retry 3
+			 * // [Error] 16/10/2026 12:00:01 request failed
+			 * @endcode
+			 * @param options What is captured and when it is dumped.
+			 */
+			void EnableFlightRecorder(const FlightRecorderOptions& options = {});
+
+			/**
+			 * @brief Snapshot of the logger's counters.
+			 *
+			 * Always on; every counter is updated by whoever already serializes the state it
+			 * describes, with relaxed atomics and no extra lock:
+			 * - emitted / filtered: every logger, per level.
+			 * - bytes, writes and write latency: loggers that write finished lines with one call
+			 *   (ThreadedLog in LineMode::Staged or LineMode::Sharded, AsyncLog, FanoutLog, BinaryLog); Log and
+			 *   ThreadedLog in LineMode::Locked stream tokens straight to the output and count none.
+			 * - lock acquisitions, wait and hold times: ThreadedLog's line lock.
+			 * - queue high-water mark: AsyncLog, and the merge backlog of LineMode::Sharded.
+			 * - drops: AsyncLog.
+			 *
+			 * Durations are timed for one write in 64 per logger and one lock acquisition in 64
+			 * per thread; the lock totals are scaled to every acquisition.
+			 * @return Counters summed over every thread that logged through this logger (or a copy of it).
+			 */
+			LogStats Stats() const;
+
+			/**
+			 * @brief Write a `logger stats` line every @p interval.
+			 *
+			 * The first level switch after each interval writes the report (emitted, filtered,
+			 * bytes, dropped, queue_high_water, lock_wait_us, lock_hold_us and write_p99_ns
+			 * fields) at @p level before the statement proceeds. While enabled, level switches
+			 * read the monotonic clock. Call it before the logger is shared between threads;
+			 * copies share the schedule.
+			 * @param interval Time between reports.
+			 * @param level Level the report is written at.
+			 */
+			void ReportStats(std::chrono::seconds interval, const Level& level = Level::Info);
+
 		protected:
 			std::shared_ptr<Implementation> m_impl;
+			const std::atomic<bool>* m_enabled;			///< m_impl's enabled flag, tested inline; null when staged
+			std::uint64_t m_staging;					///< Stage registry of a staged facade (see StageFilter())
+			std::shared_ptr<StatsReport> m_report;		///< Periodic stats report schedule, if enabled
 
 			/**
 			 * @brief Whether messages at the current level will be written.
+			 *
+			 * A single load of the implementation's flag: data overloads test it once and
+			 * the value is then appended without further checks. Staged facades load the
+			 * calling thread's own flag, found through Detail::t_stage_flag.
+			 */
+			bool WillWrite() const noexcept {
+				if (m_enabled)
+					return m_enabled->load(std::memory_order_acquire);
+#ifndef WINDOWS
+				const Detail::StageFlag& cached = Detail::t_stage_flag;
+				if (cached.registry == m_staging) [[likely]]
+					return cached.flag->load(std::memory_order_acquire);
+#endif
+				return StageWillWrite();
+			}
+
+			/**
+			 * @brief Filter on the calling thread's Implementation (see Active()) instead of m_impl.
+			 *
+			 * For facades giving each thread its own Implementation; call it from the constructor.
+			 * @param registry Process-unique id of the facade's stage registry, shared by its copies.
+			 */
+			void StageFilter(std::uint64_t registry) noexcept {
+				m_enabled = nullptr;
+				m_staging = registry;
+			}
+
+			/**
+			 * @brief WillWrite() of a staged facade whose thread flag is not cached: look it up and cache it.
+			 * @return Whether the calling thread's stage accepts values.
+			 */
+			bool StageWillWrite() const noexcept;
+
+			/**
+			 * @brief Implementation that receives state changes (manipulators) for the calling thread.
+			 * @return The shared implementation; facades with per-thread staging return the thread's own.
+			 */
+			virtual Implementation& Active() noexcept;
+
+			/**
+			 * @brief Hand the flight recorder to every Implementation that receives levels.
+			 * @param recorder Shared recorder.
 			 */
-			bool WillWrite() const noexcept;
+			virtual void Attach(const std::shared_ptr<FlightRecorder>& recorder);
+
+			/**
+			 * @brief Add the counters of every Implementation and writer to @p stats.
+			 * @param stats Snapshot being built.
+			 */
+			virtual void Collect(LogStats& stats) const;
+
+			/**
+			 * @brief Write the periodic stats report if it is due (see ReportStats()).
+			 */
+			void Report();
+
+			/**
+			 * @brief Separate a field written before the message from it, in plain text lines.
+			 */
+			void SeparateField();
 
 			virtual void Write(bool v);
 			virtual void Write(char v);
@@ -218,6 +470,83 @@ namespace StormByte::Logger {
 			 * @brief Forward redaction state to the implementation.
 			 */
 			virtual void Write(RedactManip m);
+			/**
+			 * @brief Forward precision state to the implementation.
+			 */
+			virtual void Write(PrecisionManip m);
+			/**
+			 * @brief Forward a numeric base manipulator to the implementation.
+			 */
+			virtual void Write(std::ios_base& (*manip)(std::ios_base&));
+			/**
+			 * @brief Name the next value written on the line.
+			 */
+			virtual void Write(KeyManip m);
+	};
+
+	/**
+	 * @class LogRecord
+	 * @brief Scoped handle for one record of a Log, created by Log::Record().
+	 *
+	 * Streams into the logger like the logger itself and ends the record with @ref endr
+	 * when destroyed, so the record boundary does not depend on a trailing std::endl.
+	 * On a ThreadedLog the line is held for the lifetime of the handle; keep it short.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC LogRecord final {
+		public:
+			/**
+			 * @brief Start a record by switching @p log to @p level.
+			 * @param log Logger to write to; must outlive the handle.
+			 * @param level Level of the record.
+			 */
+			LogRecord(Log& log, const Level& level): m_log(&log) {
+				log << level;
+			}
+
+			LogRecord(const LogRecord&) = delete;
+			LogRecord(LogRecord&& other) noexcept: m_log(other.m_log) {
+				other.m_log = nullptr;
+			}
+			LogRecord& operator=(const LogRecord&) = delete;
+			LogRecord& operator=(LogRecord&&) noexcept = delete;
+
+			/**
+			 * @brief End the record.
+			 */
+			~LogRecord() noexcept {
+				if (m_log) {
+					try {
+						*m_log << endr;
+					} catch (...) {}
+				}
+			}
+
+			/**
+			 * @name Streaming Operators
+			 * Forwarded to the logger.
+			 */
+			//@{
+			template <typename T>
+			inline LogRecord& operator<<(T&& value) {
+				*m_log << std::forward<T>(value);
+				return *this;
+			}
+			inline LogRecord& operator<<(std::ostream& (*manip)(std::ostream&)) {
+				*m_log << manip;
+				return *this;
+			}
+			inline LogRecord& operator<<(std::ios_base& (*manip)(std::ios_base&)) {
+				*m_log << manip;
+				return *this;
+			}
+			inline LogRecord& operator<<(Log& (*manip)(Log&) noexcept) {
+				*m_log << manip;
+				return *this;
+			}
+			//@}
+
+		private:
+			Log* m_log;									///< Logger; null once moved from
 	};
 
 	template <typename Ptr, typename T>
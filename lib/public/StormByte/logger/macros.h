@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/typedefs.hxx>
+
+/**
+ * @file macros.h
+ * @brief Compile-time level stripping.
+ *
+ * Define STORMBYTE_LOGGER_MIN_LEVEL (or configure the CMake cache variable of the same name)
+ * to the numeric value of the lowest Level to keep. STORMBYTE_LOG statements below it are
+ * discarded at compile time: neither the logger call nor any of the streamed operands are
+ * evaluated.
+ *
+ * @code
+ * // Built with -DSTORMBYTE_LOGGER_MIN_LEVEL=STORMBYTE_LOGGER_LEVEL_WARNING
+ * STORMBYTE_LOG(log, Level::Debug) << expensive_dump() << std::endl;  // compiled out
+ * STORMBYTE_LOG(log, Level::Error) << "failed: " << code << std::endl; // runtime filtering as usual
+ * @endcode
+ *
+ * Plain `log << Level::Debug << ...` statements are unaffected and keep filtering at run time.
+ */
+
+#define STORMBYTE_LOGGER_LEVEL_LOWLEVEL		0		///< Level::LowLevel
+#define STORMBYTE_LOGGER_LEVEL_DEBUG		1		///< Level::Debug
+#define STORMBYTE_LOGGER_LEVEL_WARNING		2		///< Level::Warning
+#define STORMBYTE_LOGGER_LEVEL_NOTICE		3		///< Level::Notice
+#define STORMBYTE_LOGGER_LEVEL_INFO			4		///< Level::Info
+#define STORMBYTE_LOGGER_LEVEL_ERROR		5		///< Level::Error
+#define STORMBYTE_LOGGER_LEVEL_FATAL		6		///< Level::Fatal
+
+#ifndef STORMBYTE_LOGGER_MIN_LEVEL
+	#define STORMBYTE_LOGGER_MIN_LEVEL		STORMBYTE_LOGGER_LEVEL_LOWLEVEL
+#endif
+
+/**
+ * @brief Whether statements at @p level survive compile-time stripping.
+ *
+ * Expands STORMBYTE_LOGGER_MIN_LEVEL where it is used, so each translation unit honours
+ * its own setting. The comparison goes through int parameters: comparing a Level directly
+ * against a minimum of 0 warns under -Wtype-limits in user code.
+ */
+#define STORMBYTE_LOGGER_COMPILED_IN(level) \
+	(::StormByte::Logger::Detail::CompiledIn(static_cast<int>(level), static_cast<int>(STORMBYTE_LOGGER_MIN_LEVEL)))
+
+namespace StormByte::Logger::Detail {
+	/**
+	 * @brief Implementation of STORMBYTE_LOGGER_COMPILED_IN.
+	 * @param level Level of the statement.
+	 * @param minimum Lowest level kept.
+	 * @return true if the statement is kept.
+	 */
+	constexpr bool CompiledIn(int level, int minimum) noexcept {
+		return level >= minimum;
+	}
+}
+
+/**
+ * @brief Start a log statement that is removed entirely when @p level is stripped.
+ * @param logger Log, ThreadedLog, AsyncLog or a smart pointer to one.
+ * @param level Constant Level of the statement.
+ *
+ * Expands to an `if constexpr` whose discarded branch holds the statement, so operands are
+ * still type-checked but never evaluated. Safe to use as the body of an unbraced if/else.
+ */
+#define STORMBYTE_LOG(logger, level) \
+	if constexpr (!STORMBYTE_LOGGER_COMPILED_IN(level)) {} else (logger) << (level)
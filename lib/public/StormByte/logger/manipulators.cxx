@@ -4,22 +4,37 @@
 
 namespace StormByte::Logger {
 	STORMBYTE_LOGGER_PUBLIC Log& humanreadable_number(Log& log) noexcept {
-		humanreadable_number(*log.m_impl);
+		humanreadable_number(log.Active());
 		return log;
 	}
 
 	STORMBYTE_LOGGER_PUBLIC Log& humanreadable_bytes(Log& log) noexcept {
-		humanreadable_bytes(*log.m_impl);
+		humanreadable_bytes(log.Active());
 		return log;
 	}
 
 	STORMBYTE_LOGGER_PUBLIC Log& nohumanreadable(Log& log) noexcept {
-		nohumanreadable(*log.m_impl);
+		nohumanreadable(log.Active());
 		return log;
 	}
 
 	STORMBYTE_LOGGER_PUBLIC Log& no_redact(Log& log) noexcept {
-		log.m_impl->SetRedact(false, 0, false);
+		log.Active().SetRedact(false, 0, false);
+		return log;
+	}
+
+	STORMBYTE_LOGGER_PUBLIC Log& mask_secrets(Log& log) noexcept {
+		log.Active().SetMaskSecrets(true);
+		return log;
+	}
+
+	STORMBYTE_LOGGER_PUBLIC Log& no_mask_secrets(Log& log) noexcept {
+		log.Active().SetMaskSecrets(false);
+		return log;
+	}
+
+	STORMBYTE_LOGGER_PUBLIC Log& endr(Log& log) noexcept {
+		log.Active().EndRecord();
 		return log;
 	}
 }
@@ -22,6 +22,8 @@
 #include <StormByte/logger/visibility.h>
 
 #include <cstddef>
+#include <cstdint>
+#include <string_view>
 
 /**
  * @namespace StormByte::Logger
@@ -77,6 +79,101 @@ namespace StormByte::Logger {
 		return RedactManip{ n, true };
 	}
 
+	/**
+	 * @brief Stateful floating-point precision manipulator.
+	 *
+	 * - digits < 0 (default, see @ref shortest): shortest representation that round-trips.
+	 * - digits >= 0: fixed notation with exactly `digits` decimals.
+	 *
+	 * Remains active until changed. Integer bases are selected with std::dec / std::hex /
+	 * std::oct; std::hex also prints floating-point values in hexadecimal notation.
+	 *
+	 * Usage:
+	 * @code
+	 * log << precision(3) << 3.14159 << std::endl;       // 3.142
+	 * log << shortest << 0.1 << std::endl;               // 0.1
+	 * log << std::hex << 255 << std::dec << std::endl;   // ff
+	 * @endcode
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC PrecisionManip {
+		int digits = -1;			///< < 0 = shortest round-trip; N = fixed with N decimals
+	};
+
+	/**
+	 * @brief Shortest round-trip formatting for floating-point values (the default).
+	 * @see PrecisionManip
+	 */
+	inline constexpr PrecisionManip shortest{};
+
+	/**
+	 * @brief Fixed notation with @p n decimals for floating-point values.
+	 * @param n Number of decimals.
+	 * @return A PrecisionManip configured for fixed notation.
+	 */
+	constexpr PrecisionManip precision(int n) noexcept {
+		return PrecisionManip{ n < 0 ? -1 : n };
+	}
+
+	/**
+	 * @brief Name the next value of the line as a structured field (see @ref kv).
+	 *
+	 * The key must stay valid until the value is written.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC KeyManip {
+		std::string_view key;		///< Field name
+	};
+
+	/**
+	 * @brief A named value produced by @ref kv.
+	 * @tparam T Value type; anything the logger accepts.
+	 */
+	template <typename T>
+	struct KeyValue {
+		std::string_view key;		///< Field name
+		const T& value;				///< Field value
+	};
+
+	/**
+	 * @brief Log @p value as the structured field @p key.
+	 *
+	 * With a JSON header format the field becomes a member of the line's object, with
+	 * logfmt a key=value pair; plain text lines get key=value. Text values are escaped and
+	 * quoted as the encoding requires, numbers are written bare and redaction applies to
+	 * the value only. Free text on the same line is collected into the "msg" field.
+	 *
+	 * Usage:
+	 * @code
+	 * log << Level::Info << "login" << kv("user", name) << kv("attempts", 3) << endr;
+	 * @endcode
+	 * @param key Field name; must outlive the expression.
+	 * @param value Field value.
+	 * @return A KeyValue referencing both.
+	 */
+	template <typename T>
+	constexpr KeyValue<T> kv(std::string_view key, const T& value) noexcept {
+		return KeyValue<T>{ key, value };
+	}
+
+	/**
+	 * @brief Count of lines a Throttle suppressed before the current one (see Throttle::Suppressed()).
+	 *
+	 * Written as the field `suppressed=N` (followed by a space in plain text lines); a zero
+	 * count writes nothing.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC SuppressedManip {
+		std::uint64_t count = 0;	///< Lines suppressed
+	};
+
+	/**
+	 * @brief Name of the Category a line belongs to (see Category::Tag()).
+	 *
+	 * Written as the field `category=name` (followed by a space in plain text lines); the
+	 * unnamed root category writes nothing.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC CategoryManip {
+		const char* name = "";		///< Category name; must outlive the statement
+	};
+
 	/**
 	 * @brief Enable human-readable formatting for numeric values.
 	 * @param log The Log instance to modify.
@@ -104,4 +201,36 @@ namespace StormByte::Logger {
 	 * @return Reference to the same Log.
 	 */
 	STORMBYTE_LOGGER_PUBLIC Log& no_redact(Log& log) noexcept;
+
+	/**
+	 * @brief Mask secrets detected in subsequent text values until @ref no_mask_secrets.
+	 *
+	 * Strings are scanned in one vectorized pass, without regular expressions, for the value
+	 * of secret-like keys (`password=`, `"api_key": `...), `Bearer` tokens, well-known token
+	 * prefixes, long hex and base64 runs, and card numbers passing the Luhn check. Detected
+	 * characters become '*'. A key ending one token masks the start of the next one, and
+	 * @ref kv values under a secret-like key are masked whole. Numbers are not scanned; use
+	 * @ref redact for numeric secrets.
+	 * @param log The Log instance to modify.
+	 * @return Reference to the same Log.
+	 */
+	STORMBYTE_LOGGER_PUBLIC Log& mask_secrets(Log& log) noexcept;
+
+	/**
+	 * @brief Stop masking detected secrets.
+	 * @param log The Log instance to modify.
+	 * @return Reference to the same Log.
+	 */
+	STORMBYTE_LOGGER_PUBLIC Log& no_mask_secrets(Log& log) noexcept;
+
+	/**
+	 * @brief End the current record: write a newline if the record printed anything and
+	 * release the line (ThreadedLog) or commit it (staged and asynchronous loggers).
+	 *
+	 * Unlike std::endl it never flushes the stream and is recognised without being
+	 * executed. A record with no visible output produces nothing.
+	 * @param log The Log instance to modify.
+	 * @return Reference to the same Log.
+	 */
+	STORMBYTE_LOGGER_PUBLIC Log& endr(Log& log) noexcept;
 }
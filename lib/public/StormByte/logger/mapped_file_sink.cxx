@@ -0,0 +1,55 @@
+#include <StormByte/logger/mapped_file_sink.hxx>
+#include <StormByte/logger/crash_registry.hxx>
+#include <StormByte/logger/mapped_buffer.hxx>
+#include <StormByte/logger/segment_files.hxx>
+
+using namespace StormByte::Logger;
+
+MappedFileSink::MappedFileSink(const std::filesystem::path& path, std::size_t segment_size):
+	m_buffer(std::make_unique<MappedBuffer>(path, segment_size)) {
+	Attach(m_buffer.get());
+	CrashRegistry::Add(*this);
+}
+
+MappedFileSink::~MappedFileSink() noexcept {
+	CrashRegistry::Remove(*this);
+}
+
+bool MappedFileSink::IsOpen() const noexcept {
+	return m_buffer->IsOpen();
+}
+
+void MappedFileSink::Flush() noexcept {
+	m_buffer->Commit();
+}
+
+bool MappedFileSink::CrashDrain() noexcept {
+	return m_buffer->CrashDrain();
+}
+
+void MappedFileSink::CrashWrite(const char* data, std::size_t size) noexcept {
+	m_buffer->CrashWrite(data, size);
+}
+
+std::uint64_t MappedFileSink::Segments() const noexcept {
+	return m_buffer->Segments();
+}
+
+std::uint64_t MappedFileSink::Stalls() const noexcept {
+	return m_buffer->Stalls();
+}
+
+std::uint64_t MappedFileSink::DroppedBytes() const noexcept {
+	return m_buffer->DroppedBytes();
+}
+
+std::string MappedFileSink::ReadSegment(const std::filesystem::path& segment) {
+	return MappedBuffer::Read(segment);
+}
+
+std::string MappedFileSink::ReadAll(const std::filesystem::path& path) {
+	std::string text;
+	for (const auto& [index, segment] : SegmentFiles::List(path))
+		text += MappedBuffer::Read(segment);
+	return text;
+}
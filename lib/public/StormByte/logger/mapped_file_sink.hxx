@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/sink.hxx>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	class MappedBuffer;
+
+	/**
+	 * @class MappedFileSink
+	 * @brief Sink copying records straight into memory-mapped, preallocated segment files.
+	 *
+	 * Output goes to `<path>.1`, `<path>.2`, ... (continuing after existing segments), each
+	 * a fixed-size file that a background thread creates, preallocates and maps before it
+	 * is needed. Logging is a memory copy with no system call; a full segment is synced,
+	 * released from the page cache and trimmed to its used length in the background.
+	 *
+	 * @code
+	 * MappedFileSink sink("/var/log/app.log", 64 * 1024 * 1024);
+	 * ThreadedLog log(sink, Level::Info, "[%L] %T");
+	 * log << Level::Info << "started" << endr;
+	 * @endcode
+	 *
+	 * Every segment starts with a 64-byte header whose @c committed field (offset 32,
+	 * native-endian 64-bit) counts the data bytes after the header that hold complete
+	 * records. It advances when the next record starts, on std::endl / std::flush, on
+	 * Flush() and on destruction, so after a crash a reader (ReadSegment()) recovers every
+	 * record up to the last one without trailing garbage. Records never straddle segments
+	 * unless a single record is larger than a segment.
+	 *
+	 * POSIX only; elsewhere IsOpen() is false and output is discarded.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC MappedFileSink final: public Sink {
+		public:
+			/**
+			 * @brief Create the first segment and start the background thread.
+			 * @param path Base path of the segment files.
+			 * @param segment_size Segment file size in bytes (clamped to 64 KiB - 1 GiB).
+			 */
+			explicit MappedFileSink(const std::filesystem::path& path, std::size_t segment_size = 64 * 1024 * 1024);
+
+			MappedFileSink(const MappedFileSink&) = delete;
+			MappedFileSink(MappedFileSink&&) noexcept = delete;
+			MappedFileSink& operator=(const MappedFileSink&) = delete;
+			MappedFileSink& operator=(MappedFileSink&&) noexcept = delete;
+
+			/**
+			 * @brief Commit everything written and finish every segment.
+			 */
+			~MappedFileSink() noexcept override;
+
+			/**
+			 * @brief Whether output currently reaches a segment.
+			 * @return false if no segment could be created (output is then discarded).
+			 */
+			bool IsOpen() const noexcept;
+
+			/**
+			 * @brief Commit every byte written so far, including an unfinished record (see Sink::Flush()).
+			 */
+			void Flush() noexcept override;
+
+			/**
+			 * @brief Commit every complete record from a fatal signal handler (see Sink::CrashDrain()).
+			 */
+			bool CrashDrain() noexcept override;
+
+			/**
+			 * @brief Append and commit bytes if the segment has room (see Sink::CrashWrite()).
+			 */
+			void CrashWrite(const char* data, std::size_t size) noexcept override;
+
+			/**
+			 * @brief Number of segments written to so far.
+			 * @return Segment count.
+			 */
+			std::uint64_t Segments() const noexcept;
+
+			/**
+			 * @brief Number of times a logger had to create a segment itself because the
+			 * background thread had not prepared it yet.
+			 * @return Stall count.
+			 */
+			std::uint64_t Stalls() const noexcept;
+
+			/**
+			 * @brief Bytes discarded because no segment could be created.
+			 * @return Dropped byte count.
+			 */
+			std::uint64_t DroppedBytes() const noexcept;
+
+			/**
+			 * @brief Committed content of one segment file.
+			 * @param segment Segment file, e.g. `app.log.3`.
+			 * @return The committed bytes; empty if the file is not a valid segment.
+			 */
+			static std::string ReadSegment(const std::filesystem::path& segment);
+
+			/**
+			 * @brief Committed content of every segment of @p path, oldest first.
+			 * @param path Base path given to the sink.
+			 * @return The concatenated committed bytes.
+			 */
+			static std::string ReadAll(const std::filesystem::path& path);
+
+		private:
+			std::unique_ptr<MappedBuffer> m_buffer;		///< Segments and maintenance thread
+	};
+}
@@ -0,0 +1,15 @@
+#include <StormByte/logger/rotating_file_sink.hxx>
+#include <StormByte/logger/rotating_buffer.hxx>
+
+using namespace StormByte::Logger;
+
+RotatingFileSink::RotatingFileSink(const std::filesystem::path& path, const RotationOptions& options,
+								   std::size_t buffer_size, std::size_t flush_threshold, const FlushPolicy& policy):
+	FileSink(std::make_unique<RotatingBuffer>(path, options, buffer_size, flush_threshold, policy)),
+	m_rotating(static_cast<RotatingBuffer*>(Stream().rdbuf())) {}
+
+RotatingFileSink::~RotatingFileSink() noexcept = default;
+
+std::uint64_t RotatingFileSink::Rotations() const noexcept {
+	return m_rotating->Rotations();
+}
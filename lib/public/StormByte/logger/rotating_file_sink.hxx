@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/file_sink.hxx>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	class RotatingBuffer;
+
+	/**
+	 * @struct RotationOptions
+	 * @brief When a RotatingFileSink starts a new file and which old files it keeps.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC RotationOptions {
+		std::uint64_t max_size = 0;								///< Rotate once the file holds this many bytes; 0 = no size limit
+		std::chrono::milliseconds interval{ 0 };				///< Rotate once this much time has passed; 0 = no time limit
+		std::size_t max_files = 0;								///< Rotated segments to keep; 0 = keep all
+		std::function<void(const std::filesystem::path&)> on_rotate;	///< Called with each new segment (e.g. to compress it)
+	};
+
+	/**
+	 * @class RotatingFileSink
+	 * @brief FileSink that rotates its file by size and/or time without stalling loggers.
+	 *
+	 * Loggers always write to @c path. When a trigger fires, the sink switches to a file
+	 * opened in advance at the next record boundary; the previous file then becomes
+	 * @c path.N, where N grows with every rotation. Renaming, @ref RotationOptions::on_rotate
+	 * and pruning of old segments run on a background thread, never inside a logger's
+	 * critical section.
+	 *
+	 * @code
+	 * RotationOptions rotation;
+	 * rotation.max_size = 64 * 1024 * 1024;
+	 * rotation.interval = std::chrono::hours(24);
+	 * rotation.max_files = 7;
+	 * RotatingFileSink sink("/var/log/app.log", rotation);
+	 * ThreadedLog log(sink, Level::Info, "[%L] %T");
+	 * @endcode
+	 *
+	 * Records never straddle two files. A size-triggered file may exceed @c max_size by the
+	 * record that crossed it, or by more while the background thread is still preparing
+	 * the next file.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC RotatingFileSink final: public FileSink {
+		public:
+			/**
+			 * @brief Open @p path for appending and start the background thread.
+			 * @param path Active file.
+			 * @param options Rotation triggers and retention.
+			 * @param buffer_size Buffer capacity in bytes (minimum 4 KiB).
+			 * @param flush_threshold Buffered bytes that trigger a write at the next record boundary; 0 = only when full.
+			 * @param policy Effect of std::endl / std::flush.
+			 */
+			RotatingFileSink(const std::filesystem::path& path, const RotationOptions& options,
+							 std::size_t buffer_size = 64 * 1024, std::size_t flush_threshold = 0,
+							 const FlushPolicy& policy = FlushPolicy::Immediate);
+
+			RotatingFileSink(const RotatingFileSink&) = delete;
+			RotatingFileSink(RotatingFileSink&&) noexcept = delete;
+			RotatingFileSink& operator=(const RotatingFileSink&) = delete;
+			RotatingFileSink& operator=(RotatingFileSink&&) noexcept = delete;
+
+			/**
+			 * @brief Write out buffered records and finish pending renames.
+			 */
+			~RotatingFileSink() noexcept override;
+
+			/**
+			 * @brief Number of rotations performed so far.
+			 * @return Rotation count.
+			 */
+			std::uint64_t Rotations() const noexcept;
+
+		private:
+			RotatingBuffer* m_rotating;							///< The base's buffer
+	};
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/typedefs.hxx>
+
+#include <chrono>
+#include <cstddef>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct ShardOptions
+	 * @brief Shards and merge window of a ThreadedLog in LineMode::Sharded.
+	 *
+	 * Finished lines are queued in the shard of the CPU the producer runs on and stamped with
+	 * a monotonic clock once their slot is claimed; a merger thread writes them ordered by
+	 * stamp once they are @ref skew old. Waiting on a full shard happens before the stamp, so
+	 * lines from different shards come out in order even while shards back up.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC ShardOptions {
+		std::size_t shards = 0;									///< Number of shards; 0 for one per hardware thread
+		std::size_t capacity = 1024;							///< Lines queued per shard (rounded up to a power of two); producers wait when full
+		std::chrono::microseconds skew = std::chrono::microseconds(1000);	///< How long a line waits for older lines of other shards
+	};
+}
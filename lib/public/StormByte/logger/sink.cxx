@@ -0,0 +1,8 @@
+#include <StormByte/logger/sink.hxx>
+
+using namespace StormByte::Logger;
+
+Sink::Sink(std::streambuf* buffer):
+	m_stream(buffer) {}
+
+Sink::~Sink() noexcept = default;
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/typedefs.hxx>
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging utilities for StormByte.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @class Sink
+	 * @brief Base of the library's output targets (FileSink, MappedFileSink, ...).
+	 *
+	 * A sink owns a stream buffer and exposes it as a std::ostream, so any logger accepts
+	 * a sink in place of a stream. The sink must outlive every logger writing to it.
+	 */
+	class STORMBYTE_LOGGER_PUBLIC Sink {
+		public:
+			Sink(const Sink&) = delete;
+			Sink(Sink&&) noexcept = delete;
+			Sink& operator=(const Sink&) = delete;
+			Sink& operator=(Sink&&) noexcept = delete;
+			virtual ~Sink() noexcept;
+
+			/**
+			 * @brief Make everything written so far durable in the sink's terms.
+			 *
+			 * Not synchronized with loggers: call it from the writing thread, or when no logger
+			 * is writing (AsyncLog::Flush() first for asynchronous loggers).
+			 */
+			virtual void Flush() noexcept = 0;
+
+			/**
+			 * @brief Write out buffered bytes from a fatal signal handler (see CrashHandler).
+			 *
+			 * Must only use async-signal-safe operations and must not wait for the writing
+			 * thread, which may be the one that crashed. The default has nothing buffered.
+			 * @return true if the output now ends with a complete record.
+			 */
+			virtual bool CrashDrain() noexcept {
+				return true;
+			}
+
+			/**
+			 * @brief Append already formatted bytes after CrashDrain(), under the same rules.
+			 * @param data Bytes to append.
+			 * @param size Number of bytes.
+			 */
+			virtual void CrashWrite([[maybe_unused]] const char* data, [[maybe_unused]] std::size_t size) noexcept {}
+
+			/**
+			 * @brief Stream loggers write to.
+			 * @return Stream backed by the sink's buffer.
+			 */
+			std::ostream& Stream() noexcept {
+				return m_stream;
+			}
+
+		protected:
+			/**
+			 * @brief Construct a sink over @p buffer.
+			 * @param buffer Stream buffer owned by the derived sink (may be set later with Attach()).
+			 */
+			explicit Sink(std::streambuf* buffer = nullptr);
+
+			/**
+			 * @brief Point the stream at the derived sink's buffer once it exists.
+			 * @param buffer Stream buffer.
+			 */
+			void Attach(std::streambuf* buffer) noexcept {
+				m_stream.rdbuf(buffer);
+			}
+
+		private:
+			std::ostream m_stream;						///< Stream over the derived sink's buffer
+	};
+}
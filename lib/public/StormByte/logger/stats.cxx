@@ -0,0 +1,41 @@
+#include <StormByte/logger/stats.hxx>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <numeric>
+
+using namespace StormByte::Logger;
+
+std::size_t LatencyHistogram::Bucket(std::uint64_t ns) noexcept {
+	const auto bucket = static_cast<std::size_t>(std::bit_width(ns));
+	return bucket < Buckets ? bucket : Buckets - 1;
+}
+
+std::uint64_t LatencyHistogram::Count() const noexcept {
+	return std::accumulate(counts.begin(), counts.end(), std::uint64_t{0});
+}
+
+std::uint64_t LatencyHistogram::Percentile(double percent) const noexcept {
+	const std::uint64_t total = Count();
+	if (total == 0)
+		return 0;
+	const double clamped = percent < 0 ? 0 : percent > 100 ? 100 : percent;
+	const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(clamped / 100 * static_cast<double>(total))));
+
+	std::uint64_t seen = 0;
+	for (std::size_t bucket = 0; bucket < Buckets; ++bucket) {
+		seen += counts[bucket];
+		if (seen >= rank)
+			return std::uint64_t{1} << bucket;
+	}
+	return std::uint64_t{1} << (Buckets - 1);
+}
+
+std::uint64_t LogStats::Emitted() const noexcept {
+	return std::accumulate(emitted.begin(), emitted.end(), std::uint64_t{0});
+}
+
+std::uint64_t LogStats::Filtered() const noexcept {
+	return std::accumulate(filtered.begin(), filtered.end(), std::uint64_t{0});
+}
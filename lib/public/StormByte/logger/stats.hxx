@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/typedefs.hxx>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct LatencyHistogram
+	 * @brief Distribution of durations in power-of-two nanosecond buckets.
+	 *
+	 * Bucket 0 counts durations under 1 ns and bucket `i` those in [2^(i-1), 2^i) ns; the
+	 * last bucket also counts everything longer.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC LatencyHistogram {
+		static constexpr std::size_t Buckets = 32;				///< Number of buckets
+		std::array<std::uint64_t, Buckets> counts{};			///< Durations per bucket
+
+		/**
+		 * @brief Bucket of a duration.
+		 * @param ns Duration in nanoseconds.
+		 * @return Bucket index.
+		 */
+		static std::size_t Bucket(std::uint64_t ns) noexcept;
+
+		/**
+		 * @brief Number of durations recorded.
+		 * @return Sum of every bucket.
+		 */
+		std::uint64_t Count() const noexcept;
+
+		/**
+		 * @brief Upper bound of the bucket holding the @p percent percentile.
+		 * @param percent Percentile, 0 to 100.
+		 * @return Duration in nanoseconds (0 when empty).
+		 */
+		std::uint64_t Percentile(double percent) const noexcept;
+	};
+
+	/**
+	 * @struct LogStats
+	 * @brief Snapshot of a logger's run-time counters (see Log::Stats()).
+	 *
+	 * Counters are read with relaxed loads while other threads keep logging, so a snapshot
+	 * is not one consistent instant. Durations are sampled (see Log::Stats()); the totals
+	 * are estimates scaled to every acquisition or write.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC LogStats {
+		static constexpr std::size_t Levels = static_cast<std::size_t>(Level::Fatal) + 1;	///< Size of the per-level arrays
+
+		std::array<std::uint64_t, Levels> emitted{};			///< Lines written, indexed by Level
+		std::array<std::uint64_t, Levels> filtered{};			///< Statements dropped by the level filter, indexed by Level
+		std::uint64_t bytes = 0;								///< Bytes of finished lines written to the output
+		std::uint64_t writes = 0;								///< Writes of finished lines to the output
+		LatencyHistogram write_latency;							///< Sampled duration of those writes
+		std::uint64_t lock_acquisitions = 0;					///< Line lock acquisitions (ThreadedLog)
+		std::uint64_t lock_wait_ns = 0;							///< Estimated time spent waiting for the line lock
+		std::uint64_t lock_hold_ns = 0;							///< Estimated time the line lock was held
+		std::uint64_t queue_high_water = 0;						///< Most records queued and not yet written at once (AsyncLog)
+		std::uint64_t dropped = 0;								///< Records discarded by the overflow policy (AsyncLog)
+
+		/**
+		 * @brief Lines written at every level.
+		 * @return Sum of @ref emitted.
+		 */
+		std::uint64_t Emitted() const noexcept;
+
+		/**
+		 * @brief Statements filtered at every level.
+		 * @return Sum of @ref filtered.
+		 */
+		std::uint64_t Filtered() const noexcept;
+	};
+}
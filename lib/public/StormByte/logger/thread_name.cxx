@@ -0,0 +1,12 @@
+#include <StormByte/logger/thread_name.hxx>
+#include <StormByte/logger/thread_identity.hxx>
+
+namespace StormByte::Logger {
+	STORMBYTE_LOGGER_PUBLIC void SetThreadName(std::string_view name) noexcept {
+		ThreadIdentity::Local().SetName(name);
+	}
+
+	STORMBYTE_LOGGER_PUBLIC std::string ThreadName() {
+		return std::string(ThreadIdentity::Local().Text().name);
+	}
+}
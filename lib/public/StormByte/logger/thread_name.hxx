@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/visibility.h>
+
+#include <string>
+#include <string_view>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @brief Name the calling thread in log headers.
+	 *
+	 * The name is shown by the `%n` header specifier (and the `thread_name` structured
+	 * field) of every logger; threads without one show their kernel thread id instead.
+	 * It only affects the logger: the operating system's thread name is left alone.
+	 *
+	 * @code
+	 * std::thread worker([&] {
+	 *     SetThreadName("worker-1");
+	 *     log << Level::Info << "started" << std::endl;	// [Info] worker-1 started
+	 * });
+	 * @endcode
+	 * @param name Name (empty to clear); truncated to 63 bytes.
+	 */
+	STORMBYTE_LOGGER_PUBLIC void SetThreadName(std::string_view name) noexcept;
+
+	/**
+	 * @brief Name of the calling thread.
+	 * @return Name set with SetThreadName (empty if none).
+	 */
+	STORMBYTE_LOGGER_PUBLIC std::string ThreadName();
+}
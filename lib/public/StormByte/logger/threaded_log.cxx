@@ -1,166 +1,351 @@
 #include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/logger/log_counters.hxx>
+#include <StormByte/logger/staged_writer.hxx>
 
-#include <sstream>
+#include <ostream>
+#include <streambuf>
+#include <string>
 
 using namespace StormByte::Logger;
 
 namespace {
 	thread_local bool t_line_held = false;
+	thread_local std::uint64_t t_line_acquired = 0;	// LockCounters::Lock() result for the held line
 
-	void claim_line(const std::shared_ptr<StormByte::ThreadLock>& lock) {
+	void claim_line(const std::shared_ptr<StormByte::ThreadLock>& lock, LockCounters& counters) {
 		if (!t_line_held) {
-			lock->Lock();
+			t_line_acquired = counters.Lock(*lock);
 			t_line_held = true;
 		}
 	}
 
-	void release_line(const std::shared_ptr<StormByte::ThreadLock>& lock) {
+	void release_line(const std::shared_ptr<StormByte::ThreadLock>& lock, LockCounters& counters) {
 		if (t_line_held) {
-			lock->Unlock();
+			counters.Unlock(*lock, t_line_acquired);
 			t_line_held = false;
 		}
 	}
 
-	bool manipulator_writes_newline(std::ostream& (*manip)(std::ostream&)) {
+	// What a stream manipulator does to the current line.
+	struct ManipulatorEffect {
+		bool newline;
+		bool flush;
+	};
+
+	// Accepts everything, remembering whether a newline or a sync request went through.
+	class ProbeBuffer final: public std::streambuf {
+		public:
+			bool newline = false;
+			bool synced = false;
+		protected:
+			int sync() override { synced = true; return 0; }
+			int_type overflow(int_type ch) override {
+				if (traits_type::eq_int_type(ch, traits_type::to_int_type('\n')))
+					newline = true;
+				return traits_type::not_eof(ch);
+			}
+			std::streamsize xsputn(const char* s, std::streamsize count) override {
+				if (std::char_traits<char>::find(s, static_cast<std::size_t>(count), '\n'))
+					newline = true;
+				return count;
+			}
+	};
+
+	ManipulatorEffect manipulator_effect(std::ostream& (*manip)(std::ostream&)) {
+		using Manipulator = std::ostream& (*)(std::ostream&);
+		if (manip == static_cast<Manipulator>(std::endl)) [[likely]]
+			return { true, true };
+		if (manip == static_cast<Manipulator>(std::flush))
+			return { false, true };
+		if (manip == static_cast<Manipulator>(std::ends))
+			return { false, false };
+
+		// Unknown manipulator, or a standard one whose address differs across shared
+		// objects: run it against a probe stream (no allocation).
 		try {
-			std::ostringstream probe;
+			ProbeBuffer buffer;
+			std::ostream probe(&buffer);
 			manip(probe);
-			const auto& s = probe.str();
-			return !s.empty() && s.find('\n') != std::string::npos;
+			return { buffer.newline, buffer.synced };
 		} catch (...) {
-			return false;
+			return { false, false };
 		}
 	}
 }
 
-ThreadedLog::ThreadedLog(std::ostream& out, const Level& level, const std::string& format):
-	Log(out, level, format), m_lock(std::make_shared<ThreadLock>()) {}
+ThreadedLog::ThreadedLog(std::ostream& out, const Level& level, const HeaderFormat& format, const LineMode& mode):
+	Log(out, level, format), m_lock(std::make_shared<ThreadLock>()), m_lock_counters(std::make_shared<LockCounters>()) {
+	if (mode == LineMode::Staged)
+		m_staged = std::make_shared<StagedWriter>(out, m_lock, m_lock_counters, level, format);
+	else if (mode == LineMode::Sharded)
+		m_staged = std::make_shared<StagedWriter>(out, m_lock, m_lock_counters, level, format, ShardOptions());
+	if (m_staged)
+		StageFilter(m_staged->Registry());
+}
+
+ThreadedLog::ThreadedLog(std::ostream& out, const Level& level, const HeaderFormat& format, const ShardOptions& shards):
+	Log(out, level, format), m_lock(std::make_shared<ThreadLock>()), m_lock_counters(std::make_shared<LockCounters>()),
+	m_staged(std::make_shared<StagedWriter>(out, m_lock, m_lock_counters, level, format, shards)) {
+	StageFilter(m_staged->Registry());
+}
+
+Implementation& ThreadedLog::Active() noexcept {
+	return m_staged ? m_staged->Local().impl : Log::Active();
+}
+
+void ThreadedLog::Attach(const std::shared_ptr<FlightRecorder>& recorder) {
+	Log::Attach(recorder);
+	if (m_staged)
+		m_staged->Attach(recorder);
+}
+
+void ThreadedLog::Collect(LogStats& stats) const {
+	Log::Collect(stats);
+	if (m_staged)
+		m_staged->Collect(stats);
+	m_lock_counters->Collect(stats);
+}
 
 void ThreadedLog::Write(bool v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(char v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(signed char v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(unsigned char v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(short v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(unsigned short v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(int v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(unsigned int v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(long v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(unsigned long v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(long long v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(unsigned long long v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(float v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(double v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(long double v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(const std::string& v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(const char* v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(const std::wstring& v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 void ThreadedLog::Write(const wchar_t* v) {
-	if (!WillWrite()) return;
-	claim_line(m_lock);
+	if (m_staged) {
+		m_staged->Local().impl << v;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(v);
 }
 
 void ThreadedLog::Write(const Level& level) {
-	claim_line(m_lock);
+	if (m_staged) {
+		// Switching level mid-line terminates the line.
+		Stage& stage = m_staged->Local();
+		stage.impl << level;
+		m_staged->Commit(stage);
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(level);
 	if (!WillWrite())
-		release_line(m_lock);
+		release_line(m_lock, *m_lock_counters);
 }
 
 void ThreadedLog::Write(std::ostream& (*manip)(std::ostream&)) {
+	if (m_staged) {
+		Stage& stage = m_staged->Local();
+		stage.impl << manip;
+		if (stage.Complete())
+			m_staged->Commit(stage);
+		else if (manipulator_effect(manip).flush)
+			m_staged->Flush();
+		return;
+	}
 	if (WillWrite()) {
-		claim_line(m_lock);
+		claim_line(m_lock, *m_lock_counters);
 		Log::Write(manip);
-		if (manipulator_writes_newline(manip))
-			release_line(m_lock);
+		if (manipulator_effect(manip).newline)
+			release_line(m_lock, *m_lock_counters);
 	} else {
 		Log::Write(manip);
 	}
 }
 
 void ThreadedLog::Write(Log& (*manip)(Log&) noexcept) {
-	claim_line(m_lock);
+	if (m_staged) {
+		Log::Write(manip);
+		m_staged->Commit(m_staged->Local());
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(manip);
-	if (!WillWrite())
-		release_line(m_lock);
+	if (manip == &endr || !WillWrite())
+		release_line(m_lock, *m_lock_counters);
 }
 
 void ThreadedLog::Write(RedactManip m) {
+	if (m_staged) {
+		m_staged->Local().impl.SetRedact(true, m.count, m.keep_first);
+		return;
+	}
 	// State change on Implementation; serialize like other manipulators.
-	claim_line(m_lock);
+	claim_line(m_lock, *m_lock_counters);
+	Log::Write(m);
+	if (!WillWrite())
+		release_line(m_lock, *m_lock_counters);
+}
+
+void ThreadedLog::Write(PrecisionManip m) {
+	if (m_staged) {
+		m_staged->Local().impl.SetPrecision(m.digits);
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
+	Log::Write(m);
+	if (!WillWrite())
+		release_line(m_lock, *m_lock_counters);
+}
+
+void ThreadedLog::Write(std::ios_base& (*manip)(std::ios_base&)) {
+	if (m_staged) {
+		m_staged->Local().impl << manip;
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
+	Log::Write(manip);
+	if (!WillWrite())
+		release_line(m_lock, *m_lock_counters);
+}
+
+void ThreadedLog::Write(KeyManip m) {
+	if (m_staged) {
+		m_staged->Local().impl.SetKey(m.key);
+		return;
+	}
+	claim_line(m_lock, *m_lock_counters);
 	Log::Write(m);
 	if (!WillWrite())
-		release_line(m_lock);
+		release_line(m_lock, *m_lock_counters);
 }
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <StormByte/logger/log.hxx>
+#include <StormByte/logger/shard_options.hxx>
 #include <StormByte/thread_lock.hxx>
 
 #include <memory>
@@ -29,12 +30,24 @@
  * @brief Logging module for StormByte library.
  */
 namespace StormByte::Logger {
+	class LockCounters;
+	class StagedWriter;
+
 	/**
 	 * @class ThreadedLog
 	 * @brief Thread-safe logging facade.
 	 *
 	 * Serializes logical lines (until a newline manipulator) so concurrent writers
 	 * do not interleave. Filtered messages do not hold the line lock.
+	 *
+	 * In LineMode::Staged each thread assembles its line in a reusable thread-local
+	 * buffer (with its own level, human-readable and redaction state) and takes the
+	 * lock only to write the finished line with a single call. std::endl then commits
+	 * the line without flushing the stream; stream std::flush to force it.
+	 *
+	 * LineMode::Sharded stages lines the same way but takes no lock at all: finished
+	 * lines go to a per-CPU queue and a merger thread writes them in timestamp order
+	 * (see ShardOptions). std::flush waits until every line queued so far is written.
 	 */
 	class STORMBYTE_LOGGER_PUBLIC ThreadedLog : public Log {
 		public:
@@ -42,9 +55,41 @@ namespace StormByte::Logger {
 			 * @brief Construct a ThreadedLog writing to @p out.
 			 * @param out Output stream.
 			 * @param level Minimum Level that will be emitted.
-			 * @param format Header format string (%L, %T, %i).
+			 * @param format Header format (see Log).
+			 * @param mode Line serialization strategy.
+			 */
+			ThreadedLog(std::ostream& out, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T",
+						const LineMode& mode = LineMode::Locked);
+
+			/**
+			 * @brief Construct a ThreadedLog writing to a Sink.
+			 * @param sink Output sink (FileSink, MappedFileSink, ...); it must outlive the logger.
+			 * @param level Minimum Level that will be emitted.
+			 * @param format Header format (see Log).
+			 * @param mode Line serialization strategy.
+			 */
+			ThreadedLog(Sink& sink, const Level& level = Level::Info, const HeaderFormat& format = "[%L] %T",
+						const LineMode& mode = LineMode::Locked):
+				ThreadedLog(sink.Stream(), level, format, mode) {}
+
+			/**
+			 * @brief Construct a ThreadedLog in LineMode::Sharded writing to @p out.
+			 * @param out Output stream.
+			 * @param level Minimum Level that will be emitted.
+			 * @param format Header format (see Log).
+			 * @param shards Shard count, capacity and merge window.
 			 */
-			ThreadedLog(std::ostream& out, const Level& level = Level::Info, const std::string& format = "[%L] %T");
+			ThreadedLog(std::ostream& out, const Level& level, const HeaderFormat& format, const ShardOptions& shards);
+
+			/**
+			 * @brief Construct a ThreadedLog in LineMode::Sharded writing to a Sink.
+			 * @param sink Output sink; it must outlive the logger.
+			 * @param level Minimum Level that will be emitted.
+			 * @param format Header format (see Log).
+			 * @param shards Shard count, capacity and merge window.
+			 */
+			ThreadedLog(Sink& sink, const Level& level, const HeaderFormat& format, const ShardOptions& shards):
+				ThreadedLog(sink.Stream(), level, format, shards) {}
 
 			ThreadedLog(const ThreadedLog&) = default;
 			ThreadedLog(ThreadedLog&&) noexcept = default;
@@ -153,6 +198,7 @@ namespace StormByte::Logger {
 				return *this;
 			}
 			inline Log& operator<<(const Level& level) {
+				if (m_report) [[unlikely]] Report();
 				Write(level);
 				return *this;
 			}
@@ -168,10 +214,39 @@ namespace StormByte::Logger {
 				Write(m);
 				return *this;
 			}
+			inline Log& operator<<(PrecisionManip m) {
+				Write(m);
+				return *this;
+			}
+			inline Log& operator<<(std::ios_base& (*manip)(std::ios_base&)) {
+				Write(manip);
+				return *this;
+			}
+			template <typename T>
+			inline Log& operator<<(const KeyValue<T>& field) {
+				return Log::operator<<(field);
+			}
+			inline Log& operator<<(SuppressedManip m) {
+				return Log::operator<<(m);
+			}
+			inline Log& operator<<(CategoryManip m) {
+				return Log::operator<<(m);
+			}
+			template <typename F>
+				requires std::invocable<F&> && (!std::is_void_v<std::invoke_result_t<F&>>)
+			inline Log& operator<<(F&& fn) {
+				return Log::operator<<(std::forward<F>(fn));
+			}
 			//@}
 
 		private:
 			std::shared_ptr<ThreadLock> m_lock;
+			std::shared_ptr<LockCounters> m_lock_counters;	///< Acquisitions and timing of m_lock
+			std::shared_ptr<StagedWriter> m_staged;		///< Set only in LineMode::Staged and LineMode::Sharded
+
+			Implementation& Active() noexcept override;
+			void Attach(const std::shared_ptr<FlightRecorder>& recorder) override;
+			void Collect(LogStats& stats) const override;
 
 			void Write(bool v) override;
 			void Write(char v) override;
@@ -196,5 +271,8 @@ namespace StormByte::Logger {
 			void Write(std::ostream& (*manip)(std::ostream&)) override;
 			void Write(Log& (*manip)(Log&) noexcept) override;
 			void Write(RedactManip m) override;
+			void Write(PrecisionManip m) override;
+			void Write(std::ios_base& (*manip)(std::ios_base&)) override;
+			void Write(KeyManip m) override;
 	};
 }
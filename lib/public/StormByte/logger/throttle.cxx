@@ -0,0 +1,70 @@
+#include <StormByte/logger/throttle.hxx>
+
+#include <functional>
+
+using namespace StormByte::Logger;
+
+namespace {
+	std::int64_t now_ns() noexcept {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	std::int64_t interval_ns(double rate) noexcept {
+		if (!(rate > 0))
+			return 0;
+		const double interval = 1e9 / rate;
+		return interval < 1 ? 1 : static_cast<std::int64_t>(interval);
+	}
+}
+
+Throttle::Throttle(const ThrottleOptions& options) noexcept:
+	m_sample(options.sample ? options.sample : 1),
+	m_collapse(std::chrono::duration_cast<std::chrono::nanoseconds>(options.collapse).count()),
+	m_interval(interval_ns(options.rate)),
+	m_tolerance(m_interval * static_cast<std::int64_t>(options.burst ? options.burst - 1 : 0)),
+	m_calls(0), m_last_key(0), m_collapse_until(0), m_next(0), m_suppressed(0) {}
+
+bool Throttle::Allow(std::uint64_t key) noexcept {
+	if (m_sample > 1 && m_calls.fetch_add(1, std::memory_order_relaxed) % m_sample != 0) {
+		m_suppressed.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	if (m_collapse <= 0 && m_interval == 0)
+		return true;
+
+	const std::int64_t now = now_ns();
+	if (m_collapse > 0) {
+		if (m_last_key.load(std::memory_order_relaxed) == key
+			&& now < m_collapse_until.load(std::memory_order_relaxed)) {
+			m_suppressed.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+	}
+	if (m_interval > 0) {
+		// Token bucket as a theoretical arrival time: a line may start up to the burst
+		// allowance early, and each accepted one pushes the next slot by one interval.
+		std::int64_t next = m_next.load(std::memory_order_relaxed);
+		do {
+			if (now + m_tolerance < next) {
+				m_suppressed.fetch_add(1, std::memory_order_relaxed);
+				return false;
+			}
+		} while (!m_next.compare_exchange_weak(next, (next > now ? next : now) + m_interval,
+											   std::memory_order_relaxed, std::memory_order_relaxed));
+	}
+	if (m_collapse > 0) {
+		m_last_key.store(key, std::memory_order_relaxed);
+		m_collapse_until.store(now + m_collapse, std::memory_order_relaxed);
+	}
+	return true;
+}
+
+ThrottleGroup::ThrottleGroup(const ThrottleOptions& options, std::size_t slots) {
+	for (std::size_t i = 0; i < (slots ? slots : 1); ++i)
+		m_slots.emplace_back(options);
+}
+
+Throttle& ThrottleGroup::For(std::string_view key) noexcept {
+	return m_slots[std::hash<std::string_view>{}(key) % m_slots.size()];
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2024-2026 David C. Manuelda (StormBytePP)
+ *
+ * This file is part of StormByte.
+ *
+ * StormByte is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * StormByte is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with StormByte. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <StormByte/logger/macros.h>
+#include <StormByte/logger/manipulators.hxx>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string_view>
+
+/**
+ * @namespace StormByte::Logger
+ * @brief Logging module for StormByte library.
+ */
+namespace StormByte::Logger {
+	/**
+	 * @struct ThrottleOptions
+	 * @brief Which lines a Throttle lets through. Every enabled stage must pass.
+	 */
+	struct STORMBYTE_LOGGER_PUBLIC ThrottleOptions {
+		std::uint32_t sample = 1;								///< Let 1 line in N through; 1 = every line
+		std::chrono::milliseconds collapse{ 0 };				///< Suppress repeats of the last line's key for this long; 0 = off
+		double rate = 0;										///< Lines per second once the burst is used; 0 = no rate limit
+		std::uint32_t burst = 1;								///< Lines let through back to back before the rate applies
+	};
+
+	/**
+	 * @class Throttle
+	 * @brief Decides whether a log statement is emitted, before any lock or formatting.
+	 *
+	 * Holds the state of one call site (see @ref STORMBYTE_THROTTLE) or one message key (see
+	 * ThrottleGroup). Allow() runs, in order:
+	 * - sampling: 1 call in @ref ThrottleOptions::sample passes;
+	 * - collapsing: a call with the same key as the last emitted line, within
+	 *   @ref ThrottleOptions::collapse of it, is a repeat and is suppressed;
+	 * - rate limiting: a token bucket of @ref ThrottleOptions::burst lines refilled at
+	 *   @ref ThrottleOptions::rate lines per second.
+	 *
+	 * Suppressed calls are counted, and the next emitted line reports the count
+	 * (`suppressed=N`, see Suppressed()). Only relaxed atomics are used: counts are exact,
+	 * while threads racing on the same decision may let a few extra lines through.
+	 *
+	 * @code
+	 * STORMBYTE_LOG_THROTTLED(log, Level::Error, STORMBYTE_THROTTLE(.rate = 10, .burst = 20))
+	 *     << "connect failed: " << error << endr;
+	 * // [Error] 16/10/2026 12:00:01 suppressed=48213 connect failed: refused
+	 * @endcode
+	 */
+	class STORMBYTE_LOGGER_PUBLIC Throttle final {
+		public:
+			/**
+			 * @brief Construct a Throttle.
+			 * @param options Stages to apply; the default lets every line through.
+			 */
+			Throttle(const ThrottleOptions& options = {}) noexcept;
+
+			Throttle(const Throttle&) = delete;
+			Throttle(Throttle&&) = delete;
+			~Throttle() noexcept = default;
+			Throttle& operator=(const Throttle&) = delete;
+			Throttle& operator=(Throttle&&) = delete;
+
+			/**
+			 * @brief Decide whether to emit a line; suppressed calls are counted.
+			 * @param key Identity of the message for collapsing (e.g. a hash of its arguments).
+			 * @return true if the line should be written.
+			 */
+			bool Allow(std::uint64_t key = 0) noexcept;
+
+			/**
+			 * @brief Take the count of calls suppressed since the last call.
+			 * @return Manipulator writing `suppressed=N` when N > 0.
+			 */
+			SuppressedManip Suppressed() noexcept {
+				return SuppressedManip{ m_suppressed.exchange(0, std::memory_order_relaxed) };
+			}
+
+		private:
+			const std::uint32_t m_sample;						///< 1 in N
+			const std::int64_t m_collapse;						///< Collapse window (ns); 0 = off
+			const std::int64_t m_interval;						///< Nanoseconds per token; 0 = no rate limit
+			const std::int64_t m_tolerance;						///< Burst allowance (ns)
+			alignas(64) std::atomic<std::uint64_t> m_calls;		///< Sampling counter
+			std::atomic<std::uint64_t> m_last_key;				///< Key of the last emitted line
+			std::atomic<std::int64_t> m_collapse_until;			///< Repeats of m_last_key before this are suppressed
+			std::atomic<std::int64_t> m_next;					///< Token bucket: theoretical arrival time of the next line
+			std::atomic<std::uint64_t> m_suppressed;			///< Suppressed since the last Suppressed()
+	};
+
+	/**
+	 * @class ThrottleGroup
+	 * @brief Throttles keyed by message, sharing the same options.
+	 *
+	 * Keys are hashed into a fixed set of Throttles created up front, so a lookup never
+	 * allocates or locks; keys that share a slot share its budget.
+	 *
+	 * @code
+	 * static ThrottleGroup per_peer({ .rate = 1 });
+	 * STORMBYTE_LOG_THROTTLED(log, Level::Warning, per_peer.For(peer)) << "peer " << peer << " timed out" << endr;
+	 * @endcode
+	 */
+	class STORMBYTE_LOGGER_PUBLIC ThrottleGroup final {
+		public:
+			/**
+			 * @brief Construct a group.
+			 * @param options Options of every Throttle.
+			 * @param slots Number of Throttles keys are spread over (at least 1).
+			 */
+			ThrottleGroup(const ThrottleOptions& options, std::size_t slots = 64);
+
+			ThrottleGroup(const ThrottleGroup&) = delete;
+			ThrottleGroup(ThrottleGroup&&) = delete;
+			~ThrottleGroup() noexcept = default;
+			ThrottleGroup& operator=(const ThrottleGroup&) = delete;
+			ThrottleGroup& operator=(ThrottleGroup&&) = delete;
+
+			/**
+			 * @brief Throttle of @p key.
+			 * @param key Message key.
+			 * @return The Throttle of the slot @p key hashes to.
+			 */
+			Throttle& For(std::string_view key) noexcept;
+
+		private:
+			std::deque<Throttle> m_slots;						///< Never resized after construction
+	};
+}
+
+/**
+ * @brief Throttle owned by the call site: a function-local static built from ThrottleOptions designators.
+ *
+ * Each expansion is a distinct Throttle shared by every thread running that statement.
+ */
+#define STORMBYTE_THROTTLE(...) \
+	([]() -> ::StormByte::Logger::Throttle& { \
+		static ::StormByte::Logger::Throttle stormbyte_throttle_{ ::StormByte::Logger::ThrottleOptions{ __VA_ARGS__ } }; \
+		return stormbyte_throttle_; \
+	}())
+
+/**
+ * @brief Start a log statement that is skipped when @p throttle does not allow it.
+ * @param logger Log, ThreadedLog, AsyncLog or a smart pointer to one.
+ * @param level Constant Level of the statement (also stripped as in @ref STORMBYTE_LOG).
+ * @param throttle Throttle& deciding; evaluated once.
+ * @param ... Optional collapse key passed to Throttle::Allow().
+ *
+ * The decision is taken before the logger is touched, so a suppressed statement takes no
+ * lock and evaluates none of its operands. An emitted line starts with the count of the
+ * statements suppressed before it.
+ */
+#define STORMBYTE_LOG_THROTTLED(logger, level, throttle, ...) \
+	if constexpr (!STORMBYTE_LOGGER_COMPILED_IN(level)) {} \
+	else if (auto& stormbyte_throttle_ = (throttle); !stormbyte_throttle_.Allow(__VA_ARGS__)) {} \
+	else (logger) << (level) << stormbyte_throttle_.Suppressed()
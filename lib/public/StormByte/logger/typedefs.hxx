@@ -47,6 +47,46 @@ namespace StormByte::Logger {
 		Fatal                                     	///< Fatal errors (usually unrecoverable)
 	};
 
+	/**
+	 * @enum OverflowPolicy
+	 * @brief What an asynchronous logger does when its record queue is full.
+	 */
+	enum class STORMBYTE_LOGGER_PRIVATE OverflowPolicy : unsigned short {
+		Block = 0,                               	///< Wait until the writer frees a slot
+		DropNewest,                              	///< Discard the record being committed
+		DropOldest,                              	///< Discard the oldest queued record to make room
+		Synchronous                              	///< Drain the queue and write the record on the calling thread
+	};
+
+	/**
+	 * @enum LineMode
+	 * @brief How a ThreadedLog keeps concurrent lines from interleaving.
+	 */
+	enum class STORMBYTE_LOGGER_PRIVATE LineMode : unsigned short {
+		Locked = 0,                              	///< Hold the line lock from the first token until the newline
+		Staged,                                  	///< Assemble each line per thread; lock only to write it out
+		Sharded                                  	///< Assemble each line per thread; queue it in a per-CPU shard, merged by time
+	};
+
+	/**
+	 * @enum FlushPolicy
+	 * @brief What a stream flush (std::endl, std::flush) does to a FileSink.
+	 */
+	enum class STORMBYTE_LOGGER_PRIVATE FlushPolicy : unsigned short {
+		Immediate = 0,                           	///< Write buffered records to the file right away
+		Batched                                  	///< Only mark a record boundary; write once the flush threshold is reached
+	};
+
+	/**
+	 * @enum Encoding
+	 * @brief How a logger lays out each line.
+	 */
+	enum class STORMBYTE_LOGGER_PRIVATE Encoding : unsigned short {
+		Text = 0,                                	///< Header followed by free text; fields as key=value
+		Json,                                    	///< One JSON object per line
+		Logfmt                                   	///< One logfmt record (key=value pairs) per line
+	};
+
 	/**
 	 * @brief Convert a `Level` value into a human-readable name.
 	 *
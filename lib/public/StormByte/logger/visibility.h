@@ -21,7 +21,10 @@
 
 #include <StormByte/platform.h>
 
-#ifdef WINDOWS
+#if defined(STORMBYTE_LOGGER_STATIC) && defined(WINDOWS)
+	#define STORMBYTE_LOGGER_PUBLIC
+	#define STORMBYTE_LOGGER_PRIVATE
+#elif defined(WINDOWS)
 	#ifdef StormByte_Logger_EXPORTS
 		#define STORMBYTE_LOGGER_PUBLIC	__declspec(dllexport)
   	#else
@@ -0,0 +1,162 @@
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/manipulators.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+using namespace StormByte::Logger;
+
+// Every allocation made by this process goes through these replacements so a test
+// can assert that a code path does not touch the heap.
+namespace {
+	std::atomic<std::size_t> g_allocations{0};
+
+	// Accepts and discards everything, so the stream itself never allocates.
+	class NullBuffer final: public std::streambuf {
+		protected:
+			int_type overflow(int_type ch) override { return traits_type::not_eof(ch); }
+			std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+	};
+}
+
+void* operator new(std::size_t size) {
+	g_allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+int test_numeric_tokens_do_not_allocate() {
+	NullBuffer buffer;
+	std::ostream output(&buffer);
+	Log log(output, Level::Info, "%L:");
+
+	// Warm up: first use may set up locale facets and similar one-time state.
+	log << Level::Info << 1 << 1.0 << std::endl;
+
+	const std::size_t before = g_allocations.load();
+	for (int i = 0; i < 1000; ++i) {
+		log << Level::Info << i << " " << static_cast<unsigned long long>(i) * 1000003ULL
+			<< " " << i * 0.1 << " " << static_cast<float>(i) / 7.0f << " " << -i << std::endl;
+	}
+	const std::size_t allocations = g_allocations.load() - before;
+
+	ASSERT_EQUAL("test_numeric_tokens_do_not_allocate", std::size_t{0}, allocations);
+	RETURN_TEST("test_numeric_tokens_do_not_allocate", 0);
+}
+
+int test_manipulated_numbers_do_not_allocate() {
+	NullBuffer buffer;
+	std::ostream output(&buffer);
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << 1 << 1.0 << std::endl;
+
+	const std::size_t before = g_allocations.load();
+	for (int i = 0; i < 1000; ++i) {
+		log << Level::Info << precision(3) << i * 1.25 << " " << std::hex << i << std::dec
+			<< " " << shortest << 1.0 / (i + 1) << std::endl;
+	}
+	const std::size_t allocations = g_allocations.load() - before;
+
+	ASSERT_EQUAL("test_manipulated_numbers_do_not_allocate", std::size_t{0}, allocations);
+	RETURN_TEST("test_manipulated_numbers_do_not_allocate", 0);
+}
+
+int test_redacted_values_do_not_allocate() {
+	NullBuffer buffer;
+	std::ostream output(&buffer);
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << redact(4) << 1 << std::endl;
+
+	const std::size_t before = g_allocations.load();
+	for (int i = 0; i < 1000; ++i) {
+		log << Level::Info << redact(4) << "a-fairly-long-secret-token-that-exceeds-the-mask-chunk-size-0123456789"
+			<< " " << i << " " << no_redact << "visible" << std::endl;
+	}
+	const std::size_t allocations = g_allocations.load() - before;
+
+	ASSERT_EQUAL("test_redacted_values_do_not_allocate", std::size_t{0}, allocations);
+	RETURN_TEST("test_redacted_values_do_not_allocate", 0);
+}
+
+int test_disabled_level_does_not_allocate() {
+	NullBuffer buffer;
+	std::ostream output(&buffer);
+	Log log(output, Level::Warning, "%L:");
+
+	log << Level::Info << 1 << std::endl;
+
+	const std::size_t before = g_allocations.load();
+	for (int i = 0; i < 1000; ++i)
+		log << Level::Info << "skipped " << i << " " << i * 0.5 << std::endl;
+	const std::size_t allocations = g_allocations.load() - before;
+
+	ASSERT_EQUAL("test_disabled_level_does_not_allocate", std::size_t{0}, allocations);
+	RETURN_TEST("test_disabled_level_does_not_allocate", 0);
+}
+
+int test_threaded_line_end_does_not_allocate() {
+	NullBuffer buffer;
+	std::ostream output(&buffer);
+	ThreadedLog tlog(output, Level::Info, "%L:");
+
+	tlog << Level::Info << 1 << std::endl;
+	tlog << Level::Info << 1 << endr;
+
+	const std::size_t before = g_allocations.load();
+	for (int i = 0; i < 1000; ++i) {
+		tlog << Level::Info << i << std::endl;
+		tlog << Level::Info << i << endr;
+	}
+	const std::size_t allocations = g_allocations.load() - before;
+
+	ASSERT_EQUAL("test_threaded_line_end_does_not_allocate", std::size_t{0}, allocations);
+	RETURN_TEST("test_threaded_line_end_does_not_allocate", 0);
+}
+
+int test_thread_fields_do_not_allocate() {
+	NullBuffer buffer;
+	std::ostream output(&buffer);
+	Log log(output, Level::Info, "[%L] %i %n %t:");
+
+	SetThreadName("allocation-test");
+	log << Level::Info << 1 << std::endl;
+
+	const std::size_t before = g_allocations.load();
+	for (int i = 0; i < 1000; ++i)
+		log << Level::Info << i << std::endl;
+	const std::size_t allocations = g_allocations.load() - before;
+	SetThreadName("");
+
+	ASSERT_EQUAL("test_thread_fields_do_not_allocate", std::size_t{0}, allocations);
+	RETURN_TEST("test_thread_fields_do_not_allocate", 0);
+}
+
+int main() {
+	int result = 0;
+
+	result += test_numeric_tokens_do_not_allocate();
+	result += test_manipulated_numbers_do_not_allocate();
+	result += test_redacted_values_do_not_allocate();
+	result += test_disabled_level_does_not_allocate();
+	result += test_threaded_line_end_does_not_allocate();
+	result += test_thread_fields_do_not_allocate();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
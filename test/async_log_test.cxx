@@ -0,0 +1,342 @@
+#include <StormByte/logger/async_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <atomic>
+#include <latch>
+#include <memory>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include <regex>
+#include <mutex>
+#include <condition_variable>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Stream buffer that blocks every write until opened, so tests can fill the queue deterministically.
+	class GateBuffer: public std::streambuf {
+		public:
+			void Open() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_open = true;
+				m_cv.notify_all();
+			}
+
+			void WaitEntered() {
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_cv.wait(lock, [this] { return m_entered; });
+			}
+
+			std::string Data() {
+				std::lock_guard<std::mutex> lock(m_mutex);
+				return m_data;
+			}
+
+		protected:
+			int_type overflow(int_type ch) override {
+				if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+					const char c = traits_type::to_char_type(ch);
+					xsputn(&c, 1);
+				}
+				return traits_type::not_eof(ch);
+			}
+
+			std::streamsize xsputn(const char* s, std::streamsize n) override {
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_entered = true;
+				m_cv.notify_all();
+				m_cv.wait(lock, [this] { return m_open; });
+				m_data.append(s, static_cast<std::size_t>(n));
+				return n;
+			}
+
+		private:
+			std::mutex m_mutex;
+			std::condition_variable m_cv;
+			bool m_open = false;
+			bool m_entered = false;
+			std::string m_data;
+	};
+
+	int count_lines(const std::string& text) {
+		std::istringstream in(text);
+		std::string line;
+		int count = 0;
+		while (std::getline(in, line))
+			if (!line.empty()) ++count;
+		return count;
+	}
+}
+
+int test_asynclog_basic() {
+	std::ostringstream output;
+	AsyncLog alog(output, Level::Info, "%L:");
+
+	alog << Level::Info << "Async basic message " << 42 << std::endl;
+	alog << Level::Debug << "hidden" << std::endl;
+	alog << Level::Error << "Async error" << std::endl;
+	alog.Flush();
+
+	std::string expected = "Info    : Async basic message 42\nError   : Async error\n";
+	ASSERT_EQUAL("test_asynclog_basic", expected, output.str());
+	RETURN_TEST("test_asynclog_basic", 0);
+}
+
+int test_asynclog_manipulators_per_thread() {
+	std::ostringstream output;
+	AsyncLog alog(output, Level::Info, "%L:");
+
+	alog << Level::Info << humanreadable_number << 1000 << " " << redact(2) << "secret" << std::endl;
+	alog << Level::Info << nohumanreadable << no_redact << 1000 << std::endl;
+	alog.Flush();
+
+	std::string expected = "Info    : 1,000 ****et\nInfo    : 1000\n";
+	ASSERT_EQUAL("test_asynclog_manipulators_per_thread", expected, output.str());
+	RETURN_TEST("test_asynclog_manipulators_per_thread", 0);
+}
+
+int test_asynclog_multithreaded() {
+	std::ostringstream output;
+	AsyncLog alog(output, Level::Info, "%L:", 64);
+
+	const int threads = 8;
+	const int repeats = 500;
+
+	auto worker = [&](int id) {
+		for (int i = 0; i < repeats; ++i)
+			alog << Level::Info << "T" << id << ":" << i << std::endl;
+	};
+
+	std::vector<std::thread> pool;
+	for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+	for (auto &th : pool) th.join();
+	alog.Flush();
+
+	std::istringstream in(output.str());
+	std::string line;
+	int count = 0;
+	std::regex r("^Info\\s+: T\\d+:\\d+$");
+	while (std::getline(in, line)) {
+		if (line.empty()) continue;
+		if (!std::regex_match(line, r)) {
+			ASSERT_EQUAL("test_asynclog_multithreaded (line_format)", "OK", std::string("BAD: ") + line);
+			RETURN_TEST("test_asynclog_multithreaded", 1);
+		}
+		++count;
+	}
+
+	ASSERT_EQUAL("test_asynclog_multithreaded (count)", std::to_string(threads * repeats), std::to_string(count));
+	ASSERT_EQUAL("test_asynclog_multithreaded (dropped)", std::string("0"), std::to_string(alog.Dropped()));
+	RETURN_TEST("test_asynclog_multithreaded", 0);
+}
+
+int test_asynclog_destructor_drains() {
+	std::ostringstream output;
+	{
+		AsyncLog alog(output, Level::Info, "%L:");
+		for (int i = 0; i < 1000; ++i)
+			alog << Level::Info << "line " << i << std::endl;
+		alog << Level::Info << "unterminated";
+	}
+
+	const std::string out = output.str();
+	ASSERT_EQUAL("test_asynclog_destructor_drains (count)", std::string("1001"), std::to_string(count_lines(out)));
+	ASSERT_EQUAL("test_asynclog_destructor_drains (tail)", std::string("Info    : unterminated\n"),
+		out.substr(out.rfind('\n', out.size() - 2) + 1));
+	RETURN_TEST("test_asynclog_destructor_drains", 0);
+}
+
+int test_asynclog_destructor_ends_partial_lines() {
+	// Both producers are still running when the logger goes: the destructor commits their lines.
+	std::ostringstream output;
+	auto log = std::make_unique<AsyncLog>(output, Level::Info, "%L:");
+	std::latch staged(2);
+	std::latch destroyed(1);
+	auto producer = [&](const char* text) {
+		*log << Level::Info << text;
+		staged.count_down();
+		destroyed.wait();
+	};
+	std::thread first(producer, "first");
+	std::thread second(producer, "second");
+	staged.wait();
+	log.reset();
+	destroyed.count_down();
+	first.join();
+	second.join();
+
+	const std::string out = output.str();
+	ASSERT_TRUE("test_asynclog_destructor_ends_partial_lines",
+		out == "Info    : first\nInfo    : second\n" || out == "Info    : second\nInfo    : first\n");
+	RETURN_TEST("test_asynclog_destructor_ends_partial_lines", 0);
+}
+
+int test_asynclog_drop_newest() {
+	GateBuffer gate;
+	std::ostream out(&gate);
+	AsyncLog alog(out, Level::Info, "%L:", 2, OverflowPolicy::DropNewest);
+
+	alog << Level::Info << "first" << std::endl;
+	gate.WaitEntered();				// writer holds "first" and is blocked
+	for (int i = 0; i < 5; ++i)
+		alog << Level::Info << "n" << i << std::endl;
+	gate.Open();
+	alog.Flush();
+
+	ASSERT_EQUAL("test_asynclog_drop_newest (output)",
+		std::string("Info    : first\nInfo    : n0\nInfo    : n1\n"), gate.Data());
+	ASSERT_EQUAL("test_asynclog_drop_newest (dropped)", std::string("3"), std::to_string(alog.Dropped()));
+	RETURN_TEST("test_asynclog_drop_newest", 0);
+}
+
+int test_asynclog_drop_oldest() {
+	GateBuffer gate;
+	std::ostream out(&gate);
+	AsyncLog alog(out, Level::Info, "%L:", 2, OverflowPolicy::DropOldest);
+
+	alog << Level::Info << "first" << std::endl;
+	gate.WaitEntered();
+	for (int i = 0; i < 5; ++i)
+		alog << Level::Info << "n" << i << std::endl;
+	gate.Open();
+	alog.Flush();
+
+	ASSERT_EQUAL("test_asynclog_drop_oldest (output)",
+		std::string("Info    : first\nInfo    : n3\nInfo    : n4\n"), gate.Data());
+	ASSERT_EQUAL("test_asynclog_drop_oldest (dropped)", std::string("3"), std::to_string(alog.Dropped()));
+	RETURN_TEST("test_asynclog_drop_oldest", 0);
+}
+
+int test_asynclog_flush_waits_for_own_line() {
+	// Flush() returns only once the caller's own line is written, even while other producers
+	// are between queueing a line and having it counted.
+	GateBuffer gate;
+	gate.Open();
+	std::ostream out(&gate);
+	AsyncLog alog(out, Level::Info, "%L:");
+	constexpr int threads = 4;
+	constexpr int per_thread = 300;
+	std::atomic<int> missing(0);
+	std::vector<std::thread> pool;
+	for (int t = 0; t < threads; ++t) {
+		pool.emplace_back([&, t] {
+			for (int i = 0; i < per_thread; ++i) {
+				alog << Level::Info << "T" << t << ":" << i << std::endl;
+				alog.Flush();
+				const std::string line = "Info    : T" + std::to_string(t) + ":" + std::to_string(i) + "\n";
+				if (gate.Data().find(line) == std::string::npos)
+					missing.fetch_add(1, std::memory_order_relaxed);
+			}
+		});
+	}
+	for (auto& th : pool) th.join();
+
+	ASSERT_EQUAL("test_asynclog_flush_waits_for_own_line", 0, missing.load());
+	RETURN_TEST("test_asynclog_flush_waits_for_own_line", 0);
+}
+
+int test_asynclog_block_and_synchronous_keep_everything() {
+	int result = 0;
+	for (const auto policy : { OverflowPolicy::Block, OverflowPolicy::Synchronous }) {
+		GateBuffer gate;
+		std::ostream out(&gate);
+		AsyncLog alog(out, Level::Info, "%L:", 2, policy);
+
+		alog << Level::Info << "first" << std::endl;
+		gate.WaitEntered();
+		std::thread producer([&alog] {
+			for (int i = 0; i < 6; ++i)
+				alog << Level::Info << "n" << i << std::endl;
+		});
+		gate.Open();
+		producer.join();
+		alog.Flush();
+
+		const std::string expected = "Info    : first\nInfo    : n0\nInfo    : n1\nInfo    : n2\n"
+			"Info    : n3\nInfo    : n4\nInfo    : n5\n";
+		ASSERT_EQUAL("test_asynclog_block_and_synchronous_keep_everything", expected, gate.Data());
+		ASSERT_EQUAL("test_asynclog_block_and_synchronous_keep_everything (dropped)",
+			std::string("0"), std::to_string(alog.Dropped()));
+	}
+	RETURN_TEST("test_asynclog_block_and_synchronous_keep_everything", result);
+}
+
+int test_smart_pointer_usage() {
+	std::ostringstream output;
+	{
+		std::shared_ptr<Log> log = std::make_shared<AsyncLog>(output, Level::Info, "%L:");
+		log << Level::Info << "Smart pointer log message" << std::endl;
+	}
+
+	std::string expected = "Info    : Smart pointer log message\n";
+	ASSERT_EQUAL("test_smart_pointer_usage", expected, output.str());
+	RETURN_TEST("test_smart_pointer_usage", 0);
+}
+
+int test_asynclog_lazy_uses_thread_level() {
+	std::ostringstream output;
+	int calls = 0;
+	{
+		AsyncLog log(output, Level::Info, "%L:");
+		auto dump = [&] { ++calls; return std::string("dump"); };
+		log << Level::Debug << dump << std::endl;
+		log << Level::Info << dump << std::endl;
+	}
+
+	ASSERT_EQUAL("test_asynclog_lazy_uses_thread_level (calls)", 1, calls);
+	ASSERT_EQUAL("test_asynclog_lazy_uses_thread_level", std::string("Info    : dump\n"), output.str());
+	RETURN_TEST("test_asynclog_lazy_uses_thread_level", 0);
+}
+
+int test_asynclog_record() {
+	std::ostringstream output;
+	{
+		AsyncLog log(output, Level::Info, "%L:");
+		log.Record(Level::Info) << "record " << 1;
+		log << Level::Info << "endr " << 2 << endr;
+	}
+
+	ASSERT_EQUAL("test_asynclog_record", std::string("Info    : record 1\nInfo    : endr 2\n"), output.str());
+	RETURN_TEST("test_asynclog_record", 0);
+}
+
+int test_asynclog_exited_thread() {
+	// The second thread may be handed the first one's id: it must not inherit its line.
+	std::ostringstream output;
+	LogStats stats;
+	{
+		AsyncLog log(output, Level::Info, "%L:");
+		std::thread([&] { log << Level::Info << "partial"; }).join();
+		std::thread([&] { log << Level::Info << "whole" << endr; }).join();
+		stats = log.Stats();
+	}
+
+	ASSERT_EQUAL("test_asynclog_exited_thread", std::string("Info    : partial\nInfo    : whole\n"), output.str());
+	ASSERT_EQUAL("test_asynclog_exited_thread (counted)", std::uint64_t{2}, stats.Emitted());
+	RETURN_TEST("test_asynclog_exited_thread", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_asynclog_basic();
+	result += test_asynclog_manipulators_per_thread();
+	result += test_asynclog_multithreaded();
+	result += test_asynclog_destructor_drains();
+	result += test_asynclog_destructor_ends_partial_lines();
+	result += test_asynclog_drop_newest();
+	result += test_asynclog_drop_oldest();
+	result += test_asynclog_flush_waits_for_own_line();
+	result += test_asynclog_block_and_synchronous_keep_everything();
+	result += test_smart_pointer_usage();
+	result += test_asynclog_lazy_uses_thread_level();
+	result += test_asynclog_record();
+	result += test_asynclog_exited_thread();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
@@ -0,0 +1,192 @@
+#include <StormByte/logger/binary_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <cstring>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Sequence run against a text Log and a BinaryLog; the decoded file must match the text.
+	void script(Log& log) {
+		log << Level::Info << "ints " << 42 << " " << -7L << " " << 123456789012345ULL << " " << static_cast<short>(-3)
+			<< " " << static_cast<unsigned char>(200) << " " << 'A' << " " << true << std::endl;
+		log << Level::Info << "floats " << 1.5f << " " << 0.1 << " " << 2.5L << " " << precision(3) << 3.14159
+			<< " " << shortest << 3.14159 << std::endl;
+		log << Level::Info << "bases " << std::hex << 255 << " " << std::oct << 8 << " " << std::dec << 10 << std::endl;
+		log << Level::Info << humanreadable_number << 1234567 << " " << humanreadable_bytes << 1048576
+			<< nohumanreadable << " " << 1000 << std::endl;
+		log << Level::Info << "secret=" << redact(2) << "password" << no_redact << " done" << std::endl;
+		log << Level::Info << std::string("string ") << std::wstring(L"wide ") << L"literal" << std::endl;
+		log << Level::Debug << "filtered " << 1 << std::endl;
+		log << Level::Warning << "level switch mid-line" << Level::Error << "next line" << std::endl;
+		log << Level::Info << "ended by endr" << endr;
+		log << "no header twice" << endr << endr;
+		{
+			auto record = log.Record(Level::Notice);
+			record << "scoped " << 5;
+		}
+		log << Level::Info << "ends" << std::ends << "after" << std::endl;
+		log << Level::Fatal << "unterminated";
+	}
+
+	std::string text_of(const HeaderFormat& format) {
+		std::ostringstream text;
+		{
+			Log log(text, Level::Info, format);
+			script(log);
+		}
+		return text.str();
+	}
+
+	std::string binary_of(const HeaderFormat& format) {
+		std::ostringstream binary;
+		{
+			BinaryLog log(binary, Level::Info, format);
+			script(log);
+		}
+		return binary.str();
+	}
+
+	std::string decode(const std::string& binary, bool* ok = nullptr) {
+		std::istringstream in(binary);
+		std::ostringstream out;
+		const bool decoded = BinaryLog::Decode(in, out);
+		if (ok) *ok = decoded;
+		return out.str();
+	}
+}
+
+int test_binarylog_matches_text() {
+	const HeaderFormat format("%L [%i] 100%%:");
+	bool ok = false;
+	const std::string decoded = decode(binary_of(format), &ok);
+	ASSERT_EQUAL("test_binarylog_matches_text (decoded)", true, ok);
+	ASSERT_EQUAL("test_binarylog_matches_text", text_of(format), decoded);
+	RETURN_TEST("test_binarylog_matches_text", 0);
+}
+
+int test_binarylog_timestamps() {
+	const std::string binary = binary_of("[%L] %I.%6 %z");
+
+	// Recorded instants are rendered with the recorded format...
+	std::istringstream in(binary);
+	std::ostringstream out;
+	ASSERT_EQUAL("test_binarylog_timestamps (decoded)", true, BinaryLog::Decode(in, out));
+	std::istringstream lines(out.str());
+	std::string line;
+	std::getline(lines, line);
+	const std::regex iso(R"(^\[Info    \] \d{4}-\d{2}-\d{2}T\d{2}:\d{2}:\d{2}\.\d{6} [+-]\d{2}:\d{2} ints .*)");
+	ASSERT_EQUAL("test_binarylog_timestamps (format)", true, std::regex_match(line, iso));
+
+	// ... or with an override.
+	std::istringstream again(binary);
+	std::ostringstream plain;
+	ASSERT_EQUAL("test_binarylog_timestamps (override)", true, BinaryLog::Decode(again, plain, "%L:"));
+	ASSERT_EQUAL("test_binarylog_timestamps (override text)", text_of("%L:"), plain.str());
+	RETURN_TEST("test_binarylog_timestamps", 0);
+}
+
+int test_binarylog_interns_literals() {
+	std::ostringstream binary;
+	const char* message = "a fairly long literal message that repeats on every line";
+	char buffer[16];
+	{
+		BinaryLog log(binary, Level::Info, "%L:");
+		for (int i = 0; i < 1000; ++i)
+			log << Level::Info << message << std::endl;
+		// Same address, different contents: must not be mistaken for the interned text.
+		std::strcpy(buffer, "first");
+		log << Level::Info << static_cast<const char*>(buffer) << std::endl;
+		std::strcpy(buffer, "second");
+		log << Level::Info << static_cast<const char*>(buffer) << std::endl;
+		log << Level::Info << static_cast<const char*>(nullptr) << std::endl;
+	}
+
+	ASSERT_EQUAL("test_binarylog_interns_literals (size)", true, binary.str().size() < 1000 * std::strlen(message));
+	std::string expected;
+	for (int i = 0; i < 1000; ++i)
+		expected += std::string("Info    : ") + message + "\n";
+	expected += "Info    : first\nInfo    : second\nInfo    : \n";
+	ASSERT_EQUAL("test_binarylog_interns_literals", expected, decode(binary.str()));
+	RETURN_TEST("test_binarylog_interns_literals", 0);
+}
+
+int test_binarylog_filtered_levels_fold() {
+	std::ostringstream binary;
+	{
+		BinaryLog log(binary, Level::Warning, "%L:");
+		for (int i = 0; i < 100000; ++i)
+			log << Level::Debug << "filtered " << i << std::endl;
+		log << Level::Error << "kept" << std::endl;
+	}
+	ASSERT_EQUAL("test_binarylog_filtered_levels_fold (size)", true, binary.str().size() < 256);
+	ASSERT_EQUAL("test_binarylog_filtered_levels_fold", std::string("Error   : kept\n"), decode(binary.str()));
+	RETURN_TEST("test_binarylog_filtered_levels_fold", 0);
+}
+
+int test_binarylog_multithreaded() {
+	std::ostringstream binary;
+	const int threads = 8;
+	const int repeats = 500;
+	{
+		BinaryLog log(binary, Level::Info, "%L %i:");
+		auto worker = [&](int id) {
+			BinaryLog local = log;
+			for (int i = 0; i < repeats; ++i)
+				local << Level::Info << "T" << id << ":" << i << std::endl;
+		};
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+		for (auto& th : pool) th.join();
+	}
+
+	std::istringstream in(decode(binary.str()));
+	std::string line;
+	int count = 0;
+	std::regex r("^Info\\s+ \\S+: T\\d+:\\d+$");
+	while (std::getline(in, line)) {
+		if (!std::regex_match(line, r)) {
+			ASSERT_EQUAL("test_binarylog_multithreaded (line_format)", "OK", std::string("BAD: ") + line);
+			RETURN_TEST("test_binarylog_multithreaded", 1);
+		}
+		++count;
+	}
+	ASSERT_EQUAL("test_binarylog_multithreaded (count)", threads * repeats, count);
+	RETURN_TEST("test_binarylog_multithreaded", 0);
+}
+
+int test_binarylog_rejects_bad_input() {
+	bool ok = true;
+	decode("not a binary log", &ok);
+	ASSERT_EQUAL("test_binarylog_rejects_bad_input (magic)", false, ok);
+
+	// A truncated file decodes up to the last whole chunk.
+	std::string binary = binary_of("%L:");
+	binary.resize(binary.size() - 3);
+	const std::string partial = decode(binary, &ok);
+	ASSERT_EQUAL("test_binarylog_rejects_bad_input (truncated)", false, ok);
+	ASSERT_EQUAL("test_binarylog_rejects_bad_input (prefix)", std::size_t{ 0 }, text_of("%L:").find(partial));
+	ASSERT_EQUAL("test_binarylog_rejects_bad_input (partial)", false, partial.empty());
+	RETURN_TEST("test_binarylog_rejects_bad_input", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_binarylog_matches_text();
+	result += test_binarylog_timestamps();
+	result += test_binarylog_interns_literals();
+	result += test_binarylog_filtered_levels_fold();
+	result += test_binarylog_multithreaded();
+	result += test_binarylog_rejects_bad_input();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
@@ -0,0 +1,124 @@
+#include <StormByte/logger/category.hxx>
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace StormByte::Logger;
+
+int test_inheritance() {
+	Categories categories(Level::Warning);
+	const Category http = categories.Get("net.http");
+	const Category net = categories.Get("net");
+	const Category pool = categories.Get("db.pool");
+	ASSERT_EQUAL("test_inheritance (root)", true, http.EffectiveLevel() == Level::Warning);
+
+	categories.SetLevel("net", Level::Debug);
+	ASSERT_EQUAL("test_inheritance (net)", true, net.Enabled(Level::Debug));
+	ASSERT_EQUAL("test_inheritance (net.http)", true, http.Enabled(Level::Debug));
+	ASSERT_EQUAL("test_inheritance (db.pool)", false, pool.Enabled(Level::Debug));
+
+	categories.SetLevel("net.http", Level::Error);
+	categories.SetLevel("", Level::LowLevel);
+	ASSERT_EQUAL("test_inheritance (own level kept)", true, http.EffectiveLevel() == Level::Error);
+	ASSERT_EQUAL("test_inheritance (net kept)", true, net.EffectiveLevel() == Level::Debug);
+	ASSERT_EQUAL("test_inheritance (db.pool follows root)", true, pool.EffectiveLevel() == Level::LowLevel);
+
+	categories.ResetLevel("net.http");
+	ASSERT_EQUAL("test_inheritance (reset)", true, http.EffectiveLevel() == Level::Debug);
+	categories.ResetLevel("net");
+	ASSERT_EQUAL("test_inheritance (reset to root)", true, http.EffectiveLevel() == Level::LowLevel);
+	categories.ResetLevel("");
+	ASSERT_EQUAL("test_inheritance (root keeps level)", true, categories.Get("").EffectiveLevel() == Level::LowLevel);
+	RETURN_TEST("test_inheritance", 0);
+}
+
+int test_new_category_inherits() {
+	Categories categories;
+	categories.SetLevel("net", Level::Fatal);
+	const Category tcp = categories.Get("net.tcp.accept");
+	ASSERT_EQUAL("test_new_category_inherits", true, tcp.EffectiveLevel() == Level::Fatal);
+	ASSERT_EQUAL("test_new_category_inherits (name)", std::string("net.tcp.accept"), std::string(tcp.Name()));
+	ASSERT_EQUAL("test_new_category_inherits (same node)", true, categories.Get("net.tcp").Name() == "net.tcp");
+	RETURN_TEST("test_new_category_inherits", 0);
+}
+
+int test_statement() {
+	std::ostringstream out;
+	Categories categories(Level::Info);
+	const Category http = categories.Get("net.http");
+	int evaluated = 0;
+	{
+		Log log(out, Level::LowLevel, "%L");
+		STORMBYTE_LOG_CATEGORY(log, http, Level::Debug) << "hidden " << ++evaluated << endr;
+		categories.SetLevel("net", Level::Debug);
+		STORMBYTE_LOG_CATEGORY(log, http, Level::Debug) << "shown " << ++evaluated << endr;
+		STORMBYTE_LOG_CATEGORY(log, categories.Get(""), Level::Info) << "root" << endr;
+	}
+	ASSERT_EQUAL("test_statement (operands)", 1, evaluated);
+	ASSERT_EQUAL("test_statement", std::string("Debug    category=net.http shown 1\nInfo     root\n"), out.str());
+	RETURN_TEST("test_statement", 0);
+}
+
+int test_structured() {
+	std::ostringstream out;
+	Categories categories(Level::Info);
+	{
+		Log log(out, Level::Info, HeaderFormat("%L", Encoding::Json));
+		STORMBYTE_LOG_CATEGORY(log, categories.Get("db.pool"), Level::Error) << "exhausted" << endr;
+	}
+	ASSERT_EQUAL("test_structured", std::string("{\"level\":\"Error\",\"category\":\"db.pool\",\"msg\":\"exhausted\"}\n"), out.str());
+	RETURN_TEST("test_structured", 0);
+}
+
+int test_concurrent_changes() {
+	// Levels flip while other threads log and create categories; every line is whole.
+	std::ostringstream out;
+	Categories categories(Level::Info);
+	{
+		ThreadedLog log(out, Level::LowLevel, "%L");
+		std::atomic<bool> done{ false };
+		std::thread toggler([&] {
+			for (int i = 0; !done.load(); ++i)
+				categories.SetLevel("net", i % 2 ? Level::Debug : Level::Error);
+		});
+		std::vector<std::thread> workers;
+		for (int t = 0; t < 4; ++t) {
+			workers.emplace_back([&, t] {
+				const Category mine = categories.Get("net.worker" + std::to_string(t));
+				for (int i = 0; i < 2000; ++i)
+					STORMBYTE_LOG_CATEGORY(log, mine, Level::Debug) << "tick" << endr;
+			});
+		}
+		for (auto& worker : workers)
+			worker.join();
+		done = true;
+		toggler.join();
+	}
+	std::istringstream lines(out.str());
+	std::string line;
+	while (std::getline(lines, line)) {
+		if (line.rfind("Debug    category=net.worker", 0) != 0 || line.substr(line.size() - 5) != " tick")
+			ASSERT_EQUAL("test_concurrent_changes", std::string("whole line"), line);
+	}
+	RETURN_TEST("test_concurrent_changes", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_inheritance();
+	result += test_new_category_inherits();
+	result += test_statement();
+	result += test_structured();
+	result += test_concurrent_changes();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
@@ -0,0 +1,125 @@
+#include <StormByte/logger/clock_source.hxx>
+#include <StormByte/logger/log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace StormByte::Logger;
+
+namespace {
+	std::int64_t system_ns() {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	int digits(const std::string& text, std::size_t offset, std::size_t count) {
+		return std::stoi(text.substr(offset, count));
+	}
+
+	// Nanoseconds since the epoch of a `YYYY-MM-DDTHH:MM:SS.nnnnnnnnn` (%Z.%9) prefix.
+	std::int64_t parse_ns(const std::string& line) {
+		using namespace std::chrono;
+		const year_month_day date{ year(digits(line, 0, 4)), month(static_cast<unsigned>(digits(line, 5, 2))),
+								   day(static_cast<unsigned>(digits(line, 8, 2))) };
+		const auto time = sys_days(date) + hours(digits(line, 11, 2)) + minutes(digits(line, 14, 2))
+						+ seconds(digits(line, 17, 2)) + nanoseconds(digits(line, 20, 9));
+		return duration_cast<nanoseconds>(time.time_since_epoch()).count();
+	}
+
+	// How far the header time of a line logged now falls outside the system clock reads around it.
+	std::int64_t header_error(Log& log, std::ostringstream& output) {
+		output.str("");
+		const std::int64_t before = system_ns();
+		log << Level::Info << "x" << endr;
+		const std::int64_t after = system_ns();
+		const std::int64_t logged = parse_ns(output.str());
+		return logged < before ? before - logged : logged > after ? logged - after : 0;
+	}
+}
+
+int test_system_by_default() {
+	const ClockStatus status = GetClockStatus();
+	ASSERT_EQUAL("test_system_by_default", true, status.source == ClockSource::System);
+
+	std::ostringstream output;
+	Log log(output, Level::Info, "%Z.%9");
+	ASSERT_EQUAL("test_system_by_default (exact)", std::int64_t{0}, header_error(log, output));
+	RETURN_TEST("test_system_by_default", 0);
+}
+
+int test_counter_drift() {
+	SetClockSource(ClockSource::Counter);
+	ClockStatus status = GetClockStatus();
+	ASSERT_EQUAL("test_counter_drift (source)", true, status.source == ClockSource::Counter);
+	ASSERT_TRUE("test_counter_drift (calibrated)", status.calibrations >= 1 && status.ticks_per_second > 0);
+
+	// 2.5 s of lines: spans two background calibrations.
+	std::ostringstream output;
+	Log log(output, Level::Info, "%Z.%9");
+	std::int64_t worst = 0;
+	const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(2500);
+	int lines = 0;
+	while (std::chrono::steady_clock::now() < end) {
+		worst = std::max(worst, header_error(log, output));
+		++lines;
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+	status = GetClockStatus();
+
+	std::cout << "  [clock] " << (status.invariant ? "invariant counter" : "steady_clock fallback") << " at "
+			  << static_cast<std::int64_t>(status.ticks_per_second) << " ticks/s: worst header error "
+			  << worst << " ns over " << lines << " lines, " << status.calibrations
+			  << " calibrations, last correction " << status.correction_ns << " ns\n";
+	ASSERT_TRUE("test_counter_drift (recalibrated)", status.calibrations >= 2);
+	// Loose bound: virtual machines can stall between the reads bracketing a line.
+	ASSERT_TRUE("test_counter_drift (error)", worst < 5'000'000);
+	RETURN_TEST("test_counter_drift", 0);
+}
+
+int test_flight_recorder_converts_on_dump() {
+	SetClockSource(ClockSource::Counter);
+	std::ostringstream output;
+	Log log(output, Level::Info, "%Z.%9");
+	log.EnableFlightRecorder({ .capture = Level::Debug });
+
+	const std::int64_t before = system_ns();
+	log << Level::Debug << "captured" << endr;
+	const std::int64_t after = system_ns();
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	log << Level::Error << "failed" << endr;
+
+	// The dumped record shows when it was captured, not when it was dumped.
+	const std::int64_t captured = parse_ns(output.str());
+	ASSERT_TRUE("test_flight_recorder_converts_on_dump", captured >= before - 5'000'000 && captured <= after + 5'000'000);
+	RETURN_TEST("test_flight_recorder_converts_on_dump", 0);
+}
+
+int test_back_to_system() {
+	SetClockSource(ClockSource::System);
+	ASSERT_EQUAL("test_back_to_system (source)", true, GetClockStatus().source == ClockSource::System);
+
+	std::ostringstream output;
+	Log log(output, Level::Info, "%Z.%9");
+	ASSERT_EQUAL("test_back_to_system", std::int64_t{0}, header_error(log, output));
+	RETURN_TEST("test_back_to_system", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_system_by_default();
+	result += test_counter_drift();
+	result += test_flight_recorder_converts_on_dump();
+	result += test_back_to_system();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
@@ -0,0 +1,106 @@
+// This translation unit strips everything below Warning, whatever the build configured.
+#undef STORMBYTE_LOGGER_MIN_LEVEL
+#define STORMBYTE_LOGGER_MIN_LEVEL STORMBYTE_LOGGER_LEVEL_WARNING
+
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <memory>
+#include <sstream>
+#include <string>
+
+using namespace StormByte::Logger;
+
+namespace {
+	int evaluations = 0;
+
+	std::string expensive(const std::string& text) {
+		++evaluations;
+		return text;
+	}
+}
+
+int test_stripped_levels_emit_nothing() {
+	std::ostringstream output;
+	Log log(output, Level::LowLevel, "%L:");
+
+	STORMBYTE_LOG(log, Level::LowLevel) << "low" << std::endl;
+	STORMBYTE_LOG(log, Level::Debug) << "debug" << std::endl;
+	STORMBYTE_LOG(log, Level::Warning) << "warning" << std::endl;
+	STORMBYTE_LOG(log, Level::Error) << "error " << 42 << std::endl;
+
+	std::string expected = "Warning : warning\nError   : error 42\n";
+	ASSERT_EQUAL("test_stripped_levels_emit_nothing", expected, output.str());
+	RETURN_TEST("test_stripped_levels_emit_nothing", 0);
+}
+
+int test_stripped_operands_not_evaluated() {
+	std::ostringstream output;
+	Log log(output, Level::LowLevel, "%L:");
+	evaluations = 0;
+
+	STORMBYTE_LOG(log, Level::Debug) << expensive("a") << std::endl;
+	STORMBYTE_LOG(log, Level::LowLevel) << expensive("b") << std::endl;
+	ASSERT_EQUAL("test_stripped_operands_not_evaluated (stripped)", 0, evaluations);
+
+	STORMBYTE_LOG(log, Level::Info) << expensive("c") << std::endl;
+	ASSERT_EQUAL("test_stripped_operands_not_evaluated (kept)", 1, evaluations);
+	RETURN_TEST("test_stripped_operands_not_evaluated", 0);
+}
+
+int test_runtime_filter_still_applies() {
+	std::ostringstream output;
+	Log log(output, Level::Error, "%L:");
+
+	STORMBYTE_LOG(log, Level::Warning) << "filtered at run time" << std::endl;
+	STORMBYTE_LOG(log, Level::Fatal) << "shown" << std::endl;
+
+	std::string expected = "Fatal   : shown\n";
+	ASSERT_EQUAL("test_runtime_filter_still_applies", expected, output.str());
+	RETURN_TEST("test_runtime_filter_still_applies", 0);
+}
+
+int test_macro_with_smart_pointer_and_threaded() {
+	std::ostringstream output;
+	std::shared_ptr<Log> log = std::make_shared<ThreadedLog>(output, Level::LowLevel, "%L:");
+
+	STORMBYTE_LOG(log, Level::Debug) << "hidden" << std::endl;
+	STORMBYTE_LOG(log, Level::Notice) << "shown" << std::endl;
+
+	std::string expected = "Notice  : shown\n";
+	ASSERT_EQUAL("test_macro_with_smart_pointer_and_threaded", expected, output.str());
+	RETURN_TEST("test_macro_with_smart_pointer_and_threaded", 0);
+}
+
+int test_macro_in_unbraced_if_else() {
+	std::ostringstream output;
+	Log log(output, Level::LowLevel, "%L:");
+	bool verbose = false;
+
+	if (verbose)
+		STORMBYTE_LOG(log, Level::Info) << "verbose" << std::endl;
+	else
+		STORMBYTE_LOG(log, Level::Info) << "quiet" << std::endl;
+
+	std::string expected = "Info    : quiet\n";
+	ASSERT_EQUAL("test_macro_in_unbraced_if_else", expected, output.str());
+	RETURN_TEST("test_macro_in_unbraced_if_else", 0);
+}
+
+int main() {
+	int result = 0;
+
+	result += test_stripped_levels_emit_nothing();
+	result += test_stripped_operands_not_evaluated();
+	result += test_runtime_filter_still_applies();
+	result += test_macro_with_smart_pointer_and_threaded();
+	result += test_macro_in_unbraced_if_else();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
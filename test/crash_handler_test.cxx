@@ -0,0 +1,291 @@
+#include <StormByte/logger/async_log.hxx>
+#include <StormByte/logger/crash_handler.hxx>
+#include <StormByte/logger/file_sink.hxx>
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/mapped_file_sink.hxx>
+#include <StormByte/platform.h>
+#include <StormByte/test_handlers.h>
+
+#include "temp_dir.hxx"
+
+#include <atomic>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#ifndef WINDOWS
+	#include <sys/mman.h>
+	#include <sys/resource.h>
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+using namespace StormByte::Logger;
+using StormByte::Logger::Test::TempDir;
+
+#ifndef WINDOWS
+namespace {
+	// Keep crashing children from leaving core files behind.
+	void no_core() {
+		const rlimit none{ 0, 0 };
+		::setrlimit(RLIMIT_CORE, &none);
+	}
+
+	// Run @p body in a child process; returns the signal that ended it (0 if it exited).
+	int crash_child(const std::function<void()>& body) {
+		std::cout.flush();
+		const pid_t pid = ::fork();
+		if (pid == 0) {
+			no_core();
+			// A child that hangs instead of dying is ended by SIGALRM.
+			::alarm(30);
+			body();
+			::_exit(0);
+		}
+		int status = 0;
+		::waitpid(pid, &status, 0);
+		return WIFSIGNALED(status) ? WTERMSIG(status) : 0;
+	}
+
+	std::string record(int i) {
+		return "Info    : record " + std::to_string(i) + "\n";
+	}
+
+	// FileSink whose crash drain crashes itself, as a broken custom sink would.
+	class CrashingSink final: public FileSink {
+		public:
+			CrashingSink(const std::filesystem::path& path, bool fault): FileSink(path), m_fault(fault) {}
+
+			bool CrashDrain() noexcept override {
+				if (m_fault) {
+					volatile int* volatile target = nullptr;
+					*target = 0;
+				} else {
+					std::abort();
+				}
+				return FileSink::CrashDrain();
+			}
+
+		private:
+			const bool m_fault;
+	};
+
+	volatile bool never = false;
+
+	// Recurses until the stack runs out: each frame stays live for the call below it.
+	int overflow_stack(volatile char* previous) {
+		volatile char frame[1024];
+		frame[0] = previous[0];
+		if (never)
+			return frame[0];
+		return overflow_stack(frame) + frame[0];
+	}
+}
+
+int test_buffered_records_on_abort() {
+	TempDir dir("crash_abort");
+	const int signal = crash_child([&] {
+		FileSink sink(dir.Log(), 1024 * 1024);
+		Log log(sink, Level::Info, "%L:");
+		CrashHandler::Install();
+		for (int i = 0; i < 1000; ++i)
+			log << Level::Info << "record " << i << endr;
+		std::abort();
+	});
+	std::string expected;
+	for (int i = 0; i < 1000; ++i)
+		expected += record(i);
+	expected += "fatal signal " + std::to_string(SIGABRT) + " (SIGABRT)\n";
+	ASSERT_EQUAL("test_buffered_records_on_abort (signal)", SIGABRT, signal);
+	ASSERT_EQUAL("test_buffered_records_on_abort", expected, dir.Read());
+	RETURN_TEST("test_buffered_records_on_abort", 0);
+}
+
+int test_unfinished_line() {
+	TempDir dir("crash_unfinished");
+	const int signal = crash_child([&] {
+		FileSink sink(dir.Log());
+		Log log(sink, Level::Info, "%L:");
+		CrashHandler::Install();
+		log << Level::Info << "done" << endr;
+		log << Level::Error << "half a";
+		std::raise(SIGSEGV);
+	});
+	ASSERT_EQUAL("test_unfinished_line (signal)", SIGSEGV, signal);
+	ASSERT_EQUAL("test_unfinished_line", "Info    : done\nError   : half a\nfatal signal "
+				 + std::to_string(SIGSEGV) + " (SIGSEGV)\n", dir.Read());
+	RETURN_TEST("test_unfinished_line", 0);
+}
+
+int test_killed_mid_stream() {
+	// The child logs until it is killed; every record it finished must be in the file, in order.
+	TempDir dir("crash_killed");
+	auto* committed = static_cast<std::atomic<int>*>(::mmap(nullptr, sizeof(std::atomic<int>), PROT_READ | PROT_WRITE,
+															  MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+	new (committed) std::atomic<int>(0);
+	int finished = 0;
+	std::cout.flush();
+	const pid_t pid = ::fork();
+	if (pid == 0) {
+		no_core();
+		FileSink sink(dir.Log(), 256 * 1024);
+		Log log(sink, Level::Info, "%L:");
+		CrashHandler::Install();
+		for (int i = 0;; ++i) {
+			log << Level::Info << "record " << i << endr;
+			committed->store(i + 1, std::memory_order_release);
+		}
+	}
+	while (committed->load(std::memory_order_acquire) < 20000) {}
+	::kill(pid, SIGSEGV);
+	int status = 0;
+	::waitpid(pid, &status, 0);
+	finished = committed->load(std::memory_order_acquire);
+	::munmap(committed, sizeof(std::atomic<int>));
+
+	std::istringstream lines(dir.Read());
+	std::string line, last;
+	int next = 0;
+	while (std::getline(lines, line)) {
+		if (line == "Info    : record " + std::to_string(next))
+			++next;
+		last = line;
+	}
+	ASSERT_EQUAL("test_killed_mid_stream (signal)", true, WIFSIGNALED(status) && WTERMSIG(status) == SIGSEGV);
+	ASSERT_EQUAL("test_killed_mid_stream (records)", true, next >= finished);
+	ASSERT_EQUAL("test_killed_mid_stream (fatal record)", "fatal signal " + std::to_string(SIGSEGV) + " (SIGSEGV)", last);
+	RETURN_TEST("test_killed_mid_stream", 0);
+}
+
+int test_async_queue() {
+	// Records still queued for the writer thread are written by the handler.
+	TempDir dir("crash_async");
+	constexpr int count = 20000;
+	const int signal = crash_child([&] {
+		FileSink sink(dir.Log(), 1024 * 1024, 0, FlushPolicy::Batched);
+		AsyncLog log(sink, Level::Info, "%L:", count);
+		CrashHandler::Install();
+		for (int i = 0; i < count; ++i)
+			log << Level::Info << "record " << i << endr;
+		std::abort();
+	});
+	std::istringstream lines(dir.Read());
+	std::string line, last;
+	int present = 0, previous = -1;
+	bool ordered = true;
+	while (std::getline(lines, line)) {
+		if (line.rfind("Info    : record ", 0) == 0) {
+			const int i = std::stoi(line.substr(17));
+			ordered = ordered && i > previous;
+			previous = i;
+			++present;
+		}
+		last = line;
+	}
+	ASSERT_EQUAL("test_async_queue (signal)", SIGABRT, signal);
+	ASSERT_EQUAL("test_async_queue (ordered)", true, ordered);
+	// The record the writer thread was copying when the signal arrived may be lost.
+	ASSERT_EQUAL("test_async_queue (records)", true, present >= count - 1);
+	ASSERT_EQUAL("test_async_queue (fatal record)", "fatal signal " + std::to_string(SIGABRT) + " (SIGABRT)", last);
+	RETURN_TEST("test_async_queue", 0);
+}
+
+int test_mapped_commits_last_record() {
+	TempDir dir("crash_mapped");
+	const int signal = crash_child([&] {
+		MappedFileSink sink(dir.Log(), 1024 * 1024);
+		Log log(sink, Level::Info, "%L:");
+		CrashHandler::Install();
+		log << Level::Info << "record " << 0 << endr;
+		log << Level::Info << "record " << 1 << endr;
+		std::abort();
+	});
+	ASSERT_EQUAL("test_mapped_commits_last_record (signal)", SIGABRT, signal);
+	ASSERT_EQUAL("test_mapped_commits_last_record", record(0) + record(1) + "fatal signal "
+				 + std::to_string(SIGABRT) + " (SIGABRT)\n", MappedFileSink::ReadAll(dir.Log()));
+	RETURN_TEST("test_mapped_commits_last_record", 0);
+}
+
+int test_stack_overflow_on_prepared_thread() {
+	// A thread that set up its own alternate signal stack can report its stack overflow.
+	TempDir dir("crash_overflow");
+	const int signal = crash_child([&] {
+		FileSink sink(dir.Log());
+		Log log(sink, Level::Info, "%L:");
+		CrashHandler::Install();
+		log << Level::Info << "before" << endr;
+		std::thread([] {
+			CrashHandler::PrepareThread();
+			char start = 0;
+			overflow_stack(&start);
+		}).join();
+	});
+	ASSERT_EQUAL("test_stack_overflow_on_prepared_thread (signal)", SIGSEGV, signal);
+	ASSERT_EQUAL("test_stack_overflow_on_prepared_thread", "Info    : before\nfatal signal "
+				 + std::to_string(SIGSEGV) + " (SIGSEGV)\n", dir.Read());
+	RETURN_TEST("test_stack_overflow_on_prepared_thread", 0);
+}
+
+int test_signal_inside_drain() {
+	// A fatal signal raised while the handler drains ends the process instead of waiting for
+	// the drain it interrupted; a hang is ended by the alarm and shows up as SIGALRM.
+	TempDir dir("crash_reentry");
+	const int aborted = crash_child([&] {
+		CrashingSink sink(dir.Log(), false);
+		CrashHandler::Install();
+		std::raise(SIGSEGV);
+	});
+	const int faulted = crash_child([&] {
+		CrashingSink sink(dir.Log(), true);
+		CrashHandler::Install();
+		std::raise(SIGABRT);
+	});
+	ASSERT_EQUAL("test_signal_inside_drain (abort)", SIGABRT, aborted);
+	ASSERT_EQUAL("test_signal_inside_drain (fault)", SIGSEGV, faulted);
+	RETURN_TEST("test_signal_inside_drain", 0);
+}
+
+int test_install_uninstall() {
+	ASSERT_EQUAL("test_install_uninstall (initial)", false, CrashHandler::Installed());
+	ASSERT_EQUAL("test_install_uninstall (install)", true, CrashHandler::Install());
+	ASSERT_EQUAL("test_install_uninstall (twice)", true, CrashHandler::Install());
+	CrashHandler::Uninstall();
+	ASSERT_EQUAL("test_install_uninstall (uninstalled)", false, CrashHandler::Installed());
+
+	// Without the handler nothing is saved.
+	TempDir dir("crash_uninstalled");
+	crash_child([&] {
+		FileSink sink(dir.Log());
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "lost" << endr;
+		std::abort();
+	});
+	ASSERT_EQUAL("test_install_uninstall (nothing saved)", std::string(), dir.Read());
+	RETURN_TEST("test_install_uninstall", 0);
+}
+#endif
+
+int main() {
+	int result = 0;
+#ifndef WINDOWS
+	result += test_buffered_records_on_abort();
+	result += test_unfinished_line();
+	result += test_killed_mid_stream();
+	result += test_async_queue();
+	result += test_mapped_commits_last_record();
+	result += test_stack_overflow_on_prepared_thread();
+	result += test_signal_inside_drain();
+	result += test_install_uninstall();
+#endif
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
@@ -0,0 +1,189 @@
+#include <StormByte/logger/fanout_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <latch>
+#include <regex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Sequence run against a text Log and a single-route FanoutLog; the outputs must match.
+	void script(Log& log) {
+		log << Level::Info << "value " << 42 << " " << humanreadable_bytes << 1048576 << nohumanreadable << std::endl;
+		log << Level::Info << "secret=" << redact(2) << "password" << no_redact << std::endl;
+		log << Level::Debug << "filtered" << std::endl;
+		log << Level::Warning << "level switch" << Level::Error << "next line" << std::endl;
+		log << Level::Info << "before ends" << std::ends << "after ends" << std::endl;
+		log << Level::Info << "ended by endr" << endr;
+		{
+			auto record = log.Record(Level::Notice);
+			record << "scoped " << 5;
+		}
+		log << std::endl;
+	}
+
+	int count_lines(const std::string& text) {
+		std::istringstream in(text);
+		std::string line;
+		int count = 0;
+		while (std::getline(in, line))
+			if (!line.empty()) ++count;
+		return count;
+	}
+}
+
+int test_fanoutlog_matches_log() {
+	std::ostringstream text, fanned;
+	{
+		Log log(text, Level::Info, "%L [%i]:");
+		script(log);
+	}
+	{
+		FanoutLog log({ Route(fanned, Level::Info) }, "%L [%i]:");
+		script(log);
+	}
+	ASSERT_EQUAL("test_fanoutlog_matches_log", text.str(), fanned.str());
+	RETURN_TEST("test_fanoutlog_matches_log", 0);
+}
+
+int test_fanoutlog_route_levels() {
+	std::ostringstream errors, everything, info;
+	{
+		FanoutLog log({ Route(errors, Level::Error), Route(everything, Level::LowLevel), Route(info) }, "%L:");
+		log << Level::Debug << "debug " << 1 << std::endl;
+		log << Level::Info << "info " << 2 << std::endl;
+		log << Level::Error << "error " << 3 << std::endl;
+	}
+	ASSERT_EQUAL("test_fanoutlog_route_levels (errors)", std::string("Error   : error 3\n"), errors.str());
+	ASSERT_EQUAL("test_fanoutlog_route_levels (info)", std::string("Info    : info 2\nError   : error 3\n"), info.str());
+	ASSERT_EQUAL("test_fanoutlog_route_levels (everything)",
+				 std::string("Debug   : debug 1\nInfo    : info 2\nError   : error 3\n"), everything.str());
+	RETURN_TEST("test_fanoutlog_route_levels", 0);
+}
+
+int test_fanoutlog_route_formats() {
+	std::ostringstream plain, detailed, same;
+	{
+		FanoutLog log({ Route(plain), Route(detailed, Level::Info, "[%L] %i |"), Route(same, Level::Info, "%L:") }, "%L:");
+		log << Level::Info << "hello" << std::endl;
+	}
+	std::ostringstream id;
+	id << std::this_thread::get_id();
+	ASSERT_EQUAL("test_fanoutlog_route_formats (plain)", std::string("Info    : hello\n"), plain.str());
+	ASSERT_EQUAL("test_fanoutlog_route_formats (same)", plain.str(), same.str());
+	ASSERT_EQUAL("test_fanoutlog_route_formats (detailed)", "[Info    ] " + id.str() + " | hello\n", detailed.str());
+
+	// Time fields of every route show the same instant.
+	std::ostringstream a, b;
+	{
+		FanoutLog log({ Route(a, Level::Info, "%T.%9"), Route(b, Level::Info, "%T.%9 x") });
+		log << Level::Info << "t" << std::endl;
+	}
+	const std::string stamp = a.str().substr(0, a.str().size() - 3);
+	ASSERT_EQUAL("test_fanoutlog_route_formats (instant)", stamp + " x t\n", b.str());
+	RETURN_TEST("test_fanoutlog_route_formats", 0);
+}
+
+int test_fanoutlog_lowest_level_filters() {
+	std::ostringstream errors, warnings;
+	int calls = 0;
+	auto expensive = [&] { ++calls; return std::string("dump"); };
+	{
+		FanoutLog log({ Route(errors, Level::Error), Route(warnings, Level::Warning) }, "%L:");
+		log << Level::Debug << expensive << std::endl;
+		ASSERT_EQUAL("test_fanoutlog_lowest_level_filters (enabled)", false, log.Enabled());
+		log << Level::Warning << expensive << std::endl;
+		ASSERT_EQUAL("test_fanoutlog_lowest_level_filters (warning enabled)", true, log.Enabled());
+	}
+	ASSERT_EQUAL("test_fanoutlog_lowest_level_filters (calls)", 1, calls);
+	ASSERT_EQUAL("test_fanoutlog_lowest_level_filters (errors)", std::string(), errors.str());
+	ASSERT_EQUAL("test_fanoutlog_lowest_level_filters (warnings)", std::string("Warning : dump\n"), warnings.str());
+	RETURN_TEST("test_fanoutlog_lowest_level_filters", 0);
+}
+
+int test_fanoutlog_multithreaded() {
+	std::ostringstream all, errors;
+	const int threads = 8;
+	const int repeats = 500;
+	{
+		FanoutLog log({ Route(all, Level::Info), Route(errors, Level::Error, "E %i:") }, "%L:");
+		auto worker = [&](int id) {
+			FanoutLog local = log;
+			for (int i = 0; i < repeats; ++i)
+				local << (i % 2 ? Level::Error : Level::Info) << "T" << id << ":" << i << std::endl;
+		};
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+		for (auto& th : pool) th.join();
+	}
+
+	std::istringstream in(errors.str());
+	std::string line;
+	std::regex r("^E \\S+: T\\d+:\\d*[13579]$");
+	while (std::getline(in, line)) {
+		if (!std::regex_match(line, r)) {
+			ASSERT_EQUAL("test_fanoutlog_multithreaded (line_format)", "OK", std::string("BAD: ") + line);
+			RETURN_TEST("test_fanoutlog_multithreaded", 1);
+		}
+	}
+	ASSERT_EQUAL("test_fanoutlog_multithreaded (all)", threads * repeats, count_lines(all.str()));
+	ASSERT_EQUAL("test_fanoutlog_multithreaded (errors)", threads * repeats / 2, count_lines(errors.str()));
+	RETURN_TEST("test_fanoutlog_multithreaded", 0);
+}
+
+int test_fanoutlog_unterminated_line_written_on_destruction() {
+	std::ostringstream out;
+	{
+		FanoutLog log({ Route(out) }, "%L:");
+		log << Level::Info << "no newline";
+		ASSERT_EQUAL("test_fanoutlog_unterminated_line_written_on_destruction (pending)", std::string(), out.str());
+	}
+	ASSERT_EQUAL("test_fanoutlog_unterminated_line_written_on_destruction", std::string("Info    : no newline\n"), out.str());
+	RETURN_TEST("test_fanoutlog_unterminated_line_written_on_destruction", 0);
+}
+
+int test_fanoutlog_filter_per_thread() {
+	// Values are filtered inline on the calling thread's level in the logger written to.
+	std::ostringstream first_out, second_out;
+	FanoutLog first({ Route(first_out, Level::Info) }, "%L:");
+	FanoutLog second({ Route(second_out, Level::Debug) }, "%L:");
+	std::latch filtered(1);
+	std::latch written(1);
+	std::thread worker([&] {
+		first << Level::Debug << "dropped " << 1;
+		filtered.count_down();
+		written.wait();
+		first << " still dropped" << endr;
+	});
+	filtered.wait();
+	first << Level::Info << "kept " << 2 << endr;
+	second << Level::Debug << "other logger " << 3 << endr;
+	first << "same level " << 4 << endr;
+	written.count_down();
+	worker.join();
+
+	ASSERT_EQUAL("test_fanoutlog_filter_per_thread (first)", std::string("Info    : kept 2\nInfo    : same level 4\n"), first_out.str());
+	ASSERT_EQUAL("test_fanoutlog_filter_per_thread (second)", std::string("Debug   : other logger 3\n"), second_out.str());
+	RETURN_TEST("test_fanoutlog_filter_per_thread", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_fanoutlog_matches_log();
+	result += test_fanoutlog_route_levels();
+	result += test_fanoutlog_route_formats();
+	result += test_fanoutlog_lowest_level_filters();
+	result += test_fanoutlog_multithreaded();
+	result += test_fanoutlog_unterminated_line_written_on_destruction();
+	result += test_fanoutlog_filter_per_thread();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
@@ -0,0 +1,196 @@
+#include <StormByte/logger/async_log.hxx>
+#include <StormByte/logger/file_sink.hxx>
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/platform.h>
+#include <StormByte/test_handlers.h>
+
+#include "temp_dir.hxx"
+
+#include <algorithm>
+#include <filesystem>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef WINDOWS
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+using namespace StormByte::Logger;
+using StormByte::Logger::Test::TempDir;
+
+namespace {
+}
+
+int test_file_sink_basic() {
+	TempDir dir("file_basic");
+	{
+		FileSink sink(dir.Log());
+		ASSERT_EQUAL("test_file_sink_basic (open)", true, sink.IsOpen());
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "hello " << 42 << std::endl;
+		log << Level::Debug << "hidden" << std::endl;
+		log << Level::Error << "bye" << endr;
+	}
+
+	ASSERT_EQUAL("test_file_sink_basic", std::string("Info    : hello 42\nError   : bye\n"), dir.Read());
+	RETURN_TEST("test_file_sink_basic", 0);
+}
+
+int test_file_sink_appends() {
+	TempDir dir("file_appends");
+	{
+		FileSink sink(dir.Log());
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "first" << std::endl;
+	}
+	{
+		FileSink sink(dir.Log());
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "second" << std::endl;
+	}
+
+	ASSERT_EQUAL("test_file_sink_appends", std::string("Info    : first\nInfo    : second\n"), dir.Read());
+	RETURN_TEST("test_file_sink_appends", 0);
+}
+
+int test_file_sink_immediate_vs_batched() {
+	TempDir immediate_dir("file_immediate");
+	TempDir batched_dir("file_batched");
+	FileSink immediate(immediate_dir.Log());
+	FileSink batched(batched_dir.Log(), 64 * 1024, 0, FlushPolicy::Batched);
+	Log a(immediate, Level::Info, "%L:");
+	Log b(batched, Level::Info, "%L:");
+
+	a << Level::Info << "endl" << std::endl;
+	b << Level::Info << "endl" << std::endl;
+	ASSERT_EQUAL("test_file_sink_immediate_vs_batched (immediate)", std::string("Info    : endl\n"), immediate_dir.Read());
+	ASSERT_EQUAL("test_file_sink_immediate_vs_batched (batched)", std::string(""), batched_dir.Read());
+
+	a << Level::Info << "endr" << endr;
+	ASSERT_EQUAL("test_file_sink_immediate_vs_batched (endr buffered)", std::string("Info    : endl\n"), immediate_dir.Read());
+
+	batched.Flush();
+	ASSERT_EQUAL("test_file_sink_immediate_vs_batched (flushed)", std::string("Info    : endl\n"), batched_dir.Read());
+	RETURN_TEST("test_file_sink_immediate_vs_batched", 0);
+}
+
+int test_file_sink_threshold_writes_whole_records() {
+	TempDir dir("file_threshold");
+	FileSink sink(dir.Log(), 4096, 100, FlushPolicy::Batched);
+	Log log(sink, Level::Info, "%L:");
+
+	for (int i = 0; i < 20; ++i)
+		log << Level::Info << "record " << i << endr;
+
+	// Every record is 20 bytes or less: once past 100 bytes the buffered records are written
+	// as soon as the next one starts, so the file holds only complete lines.
+	const std::string written = dir.Read();
+	ASSERT_EQUAL("test_file_sink_threshold_writes_whole_records (some)", true, written.size() >= 100);
+	ASSERT_EQUAL("test_file_sink_threshold_writes_whole_records (whole)", '\n', written.back());
+	RETURN_TEST("test_file_sink_threshold_writes_whole_records", 0);
+}
+
+int test_file_sink_large_record() {
+	TempDir dir("file_large");
+	const std::string big(20000, 'x');
+	{
+		FileSink sink(dir.Log(), 4096);
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "a" << endr;
+		log << Level::Info << big << endr;
+		log << Level::Info << "b" << endr;
+	}
+
+	ASSERT_EQUAL("test_file_sink_large_record", "Info    : a\nInfo    : " + big + "\nInfo    : b\n", dir.Read());
+	RETURN_TEST("test_file_sink_large_record", 0);
+}
+
+// Lines written from several threads must arrive whole.
+int check_concurrent_lines(const char* name, const std::string& written, int expected) {
+	std::istringstream in(written);
+	std::string line;
+	int count = 0;
+	const std::regex r("^Info\\s+: T\\d+:\\d+$");
+	while (std::getline(in, line)) {
+		if (!std::regex_match(line, r)) {
+			ASSERT_EQUAL(name, "OK", std::string("BAD: ") + line);
+			return 1;
+		}
+		++count;
+	}
+	ASSERT_EQUAL(name, expected, count);
+	return 0;
+}
+
+int test_file_sink_threaded_and_async() {
+	TempDir threaded_dir("file_threaded");
+	TempDir async_dir("file_async");
+	constexpr int threads = 4;
+	constexpr int per_thread = 2000;
+	{
+		FileSink threaded_sink(threaded_dir.Log(), 16 * 1024, 0, FlushPolicy::Batched);
+		FileSink async_sink(async_dir.Log(), 16 * 1024, 0, FlushPolicy::Batched);
+		ThreadedLog tlog(threaded_sink, Level::Info, "%L:", LineMode::Staged);
+		AsyncLog alog(async_sink, Level::Info, "%L:");
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t) {
+			pool.emplace_back([&, t] {
+				for (int i = 0; i < per_thread; ++i) {
+					tlog << Level::Info << "T" << t << ":" << i << std::endl;
+					alog << Level::Info << "T" << t << ":" << i << std::endl;
+				}
+			});
+		}
+		for (auto& th : pool) th.join();
+	}
+
+	int result = 0;
+	result += check_concurrent_lines("test_file_sink_threaded_and_async (threaded)", threaded_dir.Read(), threads * per_thread);
+	result += check_concurrent_lines("test_file_sink_threaded_and_async (async)", async_dir.Read(), threads * per_thread);
+	RETURN_TEST("test_file_sink_threaded_and_async", result);
+}
+
+int test_file_sink_descriptor_and_failure() {
+	FileSink missing(std::filesystem::path("/nonexistent-directory/stormbyte.log"));
+	Log log(missing, Level::Info, "%L:");
+	log << Level::Info << "lost" << std::endl;
+	ASSERT_EQUAL("test_file_sink_descriptor_and_failure (open)", false, missing.IsOpen());
+	ASSERT_EQUAL("test_file_sink_descriptor_and_failure (dropped)", true, missing.DroppedBytes() > 0);
+
+#ifndef WINDOWS
+	TempDir dir("file_descriptor");
+	const int fd = ::open(dir.Log().c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	{
+		FileSink sink(fd, false);
+		Log fd_log(sink, Level::Info, "%L:");
+		fd_log << Level::Info << "via fd" << std::endl;
+	}
+	ASSERT_EQUAL("test_file_sink_descriptor_and_failure (not closed)", 0, ::close(fd));
+	ASSERT_EQUAL("test_file_sink_descriptor_and_failure (fd)", std::string("Info    : via fd\n"), dir.Read());
+#endif
+	RETURN_TEST("test_file_sink_descriptor_and_failure", 0);
+}
+
+int main() {
+	int result = 0;
+
+	result += test_file_sink_basic();
+	result += test_file_sink_appends();
+	result += test_file_sink_immediate_vs_batched();
+	result += test_file_sink_threshold_writes_whole_records();
+	result += test_file_sink_large_record();
+	result += test_file_sink_threaded_and_async();
+	result += test_file_sink_descriptor_and_failure();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
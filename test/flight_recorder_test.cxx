@@ -0,0 +1,143 @@
+#include <StormByte/logger/async_log.hxx>
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace StormByte::Logger;
+
+int test_dump_ahead_of_error() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+	log.EnableFlightRecorder({ .capture = Level::Debug });
+
+	log << Level::Debug << "step " << 1 << endr;
+	log << Level::LowLevel << "not captured" << endr;
+	log << Level::Debug << "step " << 2 << std::endl;
+	log << Level::Info << "info" << endr;
+	ASSERT_EQUAL("test_dump_ahead_of_error (filtered)", std::string("Info    : info\n"), output.str());
+
+	log << Level::Error << "failed" << endr;
+	ASSERT_EQUAL("test_dump_ahead_of_error (dump)",
+		std::string("Info    : info\nDebug   : step 1\nDebug   : step 2\nError   : failed\n"), output.str());
+
+	output.str("");
+	log << Level::Error << "again" << endr;
+	ASSERT_EQUAL("test_dump_ahead_of_error (dumped once)", std::string("Error   : again\n"), output.str());
+	RETURN_TEST("test_dump_ahead_of_error", 0);
+}
+
+int test_trigger_needs_output() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+	log.EnableFlightRecorder({ .capture = Level::Debug, .trigger = Level::Error });
+
+	log << Level::Debug << "context" << endr;
+	log << Level::Error << endr;
+	log << Level::Warning << "warn" << endr;
+	ASSERT_EQUAL("test_trigger_needs_output (empty record)", std::string(""), output.str());
+	log << Level::Fatal << "fatal" << endr;
+	ASSERT_EQUAL("test_trigger_needs_output (fatal)", std::string("Debug   : context\nWarning : warn\nFatal   : fatal\n"), output.str());
+	RETURN_TEST("test_trigger_needs_output", 0);
+}
+
+int test_most_recent_records() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+	log.EnableFlightRecorder({ .records = 3, .budget = 256 });
+
+	for (int i = 0; i < 100; ++i)
+		log << Level::Debug << "i=" << i << endr;
+	log << Level::Error << "failed" << endr;
+	ASSERT_EQUAL("test_most_recent_records",
+		std::string("Debug   : i=97\nDebug   : i=98\nDebug   : i=99\nError   : failed\n"), output.str());
+
+	// A record larger than the whole budget is not kept.
+	output.str("");
+	log << Level::Debug << std::string(1024, 'x') << endr;
+	log << Level::Error << "failed" << endr;
+	ASSERT_EQUAL("test_most_recent_records (oversized)", std::string("Error   : failed\n"), output.str());
+	RETURN_TEST("test_most_recent_records", 0);
+}
+
+int test_formatting_state_kept() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+	log.EnableFlightRecorder();
+
+	bool invoked = false;
+	log << Level::Debug << std::hex << 255 << std::dec << " " << precision(2) << 1.0 / 3
+		<< " " << redact(2) << "secret" << no_redact << kv("user", "bob") << " "
+		<< L"wide" << " " << true << " " << [&] { invoked = true; return 1; } << endr;
+	log << shortest << Level::Error << "failed " << 0.5 << endr;
+	ASSERT_EQUAL("test_formatting_state_kept (lazy)", false, invoked);
+	ASSERT_EQUAL("test_formatting_state_kept",
+		std::string("Debug   : ff 0.33 ****et user=bob wide true \nError   : failed 0.5\n"), output.str());
+	RETURN_TEST("test_formatting_state_kept", 0);
+}
+
+int test_disabled_by_default() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+	log << Level::Debug << "context" << endr;
+	ASSERT_EQUAL("test_disabled_by_default (enabled)", false, log.Enabled());
+	log << Level::Error << "failed" << endr;
+	ASSERT_EQUAL("test_disabled_by_default", std::string("Error   : failed\n"), output.str());
+	RETURN_TEST("test_disabled_by_default", 0);
+}
+
+int test_threaded_scope() {
+	for (const auto mode : { LineMode::Locked, LineMode::Staged }) {
+		for (const auto scope : { FlightScope::Thread, FlightScope::All }) {
+			std::ostringstream output;
+			ThreadedLog log(output, Level::Info, "%L:", mode);
+			log.EnableFlightRecorder({ .scope = scope });
+
+			std::thread worker([&] {
+				log << Level::Debug << "worker" << endr;
+			});
+			worker.join();
+			log << Level::Debug << "main" << endr;
+			log << Level::Error << "failed" << endr;
+
+			const std::string expected = scope == FlightScope::All
+				? "Debug   : worker\nDebug   : main\nError   : failed\n"
+				: "Debug   : main\nError   : failed\n";
+			ASSERT_EQUAL("test_threaded_scope", expected, output.str());
+		}
+	}
+	RETURN_TEST("test_threaded_scope", 0);
+}
+
+int test_async_dump() {
+	std::ostringstream output;
+	{
+		AsyncLog log(output, Level::Info, "%L:");
+		log.EnableFlightRecorder({ .capture = Level::Debug });
+		log << Level::Debug << "context " << 42 << endr;
+		log << Level::Error << "failed" << endr;
+	}
+	ASSERT_EQUAL("test_async_dump", std::string("Debug   : context 42\nError   : failed\n"), output.str());
+	RETURN_TEST("test_async_dump", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_dump_ahead_of_error();
+	result += test_trigger_needs_output();
+	result += test_most_recent_records();
+	result += test_formatting_state_kept();
+	result += test_disabled_by_default();
+	result += test_threaded_scope();
+	result += test_async_dump();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
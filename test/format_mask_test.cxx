@@ -44,9 +44,83 @@ int test_format_mask_literals() {
 	RETURN_TEST("test_format_mask_literals", 0);
 }
 
+int test_format_mask_time_specifiers() {
+	struct Case {
+		const char* format;
+		const char* pattern;
+	};
+	const Case cases[] = {
+		{ "%T", "\\d{2}/\\d{2}/\\d{4} \\d{2}:\\d{2}:\\d{2}" },
+		{ "%U", "\\d{2}/\\d{2}/\\d{4} \\d{2}:\\d{2}:\\d{2}" },
+		{ "%T.%3", "\\d{2}/\\d{2}/\\d{4} \\d{2}:\\d{2}:\\d{2}\\.\\d{3}" },
+		{ "%I.%6%z", "\\d{4}-\\d{2}-\\d{2}T\\d{2}:\\d{2}:\\d{2}\\.\\d{6}[+-]\\d{2}:\\d{2}" },
+		{ "%Z.%9Z", "\\d{4}-\\d{2}-\\d{2}T\\d{2}:\\d{2}:\\d{2}\\.\\d{9}Z" },
+	};
+
+	for (const auto& c : cases) {
+		std::ostringstream output;
+		Log log(output, Level::Info, std::string("[") + c.format + "]");
+		log << Level::Info << "msg" << std::endl;
+
+		const std::regex r(std::string("^\\[") + c.pattern + "\\] msg\n$");
+		if (!std::regex_match(output.str(), r)) {
+			ASSERT_EQUAL("test_format_mask_time_specifiers", std::string(c.format), output.str());
+			RETURN_TEST("test_format_mask_time_specifiers", 1);
+		}
+	}
+
+	RETURN_TEST("test_format_mask_time_specifiers", 0);
+}
+
+int test_format_mask_same_instant() {
+	// %3 and %6 of one header come from the same clock sample.
+	std::ostringstream output;
+	Log log(output, Level::Info, "%3|%6");
+
+	for (int i = 0; i < 100; ++i)
+		log << Level::Info << "x" << std::endl;
+
+	std::istringstream in(output.str());
+	std::string line;
+	while (std::getline(in, line)) {
+		ASSERT_EQUAL("test_format_mask_same_instant", line.substr(0, 3), line.substr(4, 3));
+	}
+	RETURN_TEST("test_format_mask_same_instant", 0);
+}
+
+int test_format_mask_compiled_program() {
+	const HeaderFormat format("[%L] %% %x%");
+
+	// Literal runs (with %% collapsed and unknown specifiers kept) are merged into single spans.
+	ASSERT_EQUAL("test_format_mask_compiled_program (tokens)", std::string("3"), std::to_string(format.Tokens().size()));
+	ASSERT_EQUAL("test_format_mask_compiled_program (literals)", std::string("[] % %x% "), std::string(format.Literals()));
+	RETURN_TEST("test_format_mask_compiled_program", 0);
+}
+
+int test_format_mask_static_matches_runtime() {
+	const HeaderFormat runtime("[%L] %% %i %T.%3:");
+	const HeaderFormat compiled = header_format<"[%L] %% %i %T.%3:">;
+
+	if (runtime.Tokens() != compiled.Tokens()) {
+		ASSERT_EQUAL("test_format_mask_static_matches_runtime (tokens)", std::string("equal"), std::string("different"));
+		RETURN_TEST("test_format_mask_static_matches_runtime", 1);
+	}
+	ASSERT_EQUAL("test_format_mask_static_matches_runtime (literals)", std::string(runtime.Literals()), std::string(compiled.Literals()));
+
+	std::ostringstream output;
+	Log log(output, Level::Info, header_format<"%L|%%:">);
+	log << Level::Info << "static" << std::endl;
+	ASSERT_EQUAL("test_format_mask_static_matches_runtime (output)", std::string("Info    |%: static\n"), output.str());
+	RETURN_TEST("test_format_mask_static_matches_runtime", 0);
+}
+
 int main() {
 	int result = 0;
 	result += test_format_mask_literals();
+	result += test_format_mask_time_specifiers();
+	result += test_format_mask_same_instant();
+	result += test_format_mask_compiled_program();
+	result += test_format_mask_static_matches_runtime();
 
 	if (result == 0) std::cout << "All tests passed!" << std::endl;
 	else std::cout << result << " tests failed." << std::endl;
@@ -193,6 +193,98 @@ int test_escaped_percent_in_format() {
 	RETURN_TEST("test_escaped_percent_in_format", 0);
 }
 
+// --- Lazy arguments ---
+
+int test_lazy_invoked_only_when_enabled() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+	int calls = 0;
+	auto dump = [&] { ++calls; return std::string("state"); };
+
+	log << Level::Debug << "hidden " << dump << std::endl;
+	ASSERT_EQUAL("test_lazy_invoked_only_when_enabled (filtered)", 0, calls);
+
+	log << Level::Info << "shown " << dump << " " << [] { return 42; } << std::endl;
+	ASSERT_EQUAL("test_lazy_invoked_only_when_enabled (enabled)", 1, calls);
+
+	std::string expected = "Info    : shown state 42\n";
+	ASSERT_EQUAL("test_lazy_invoked_only_when_enabled", expected, output.str());
+	RETURN_TEST("test_lazy_invoked_only_when_enabled", 0);
+}
+
+int test_lazy_result_is_redacted_and_formatted() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << humanreadable_number << [] { return 1000; } << nohumanreadable << " "
+		<< redact(2) << [] { return std::string("secret"); } << std::endl;
+
+	std::string expected = "Info    : 1,000 ****et\n";
+	ASSERT_EQUAL("test_lazy_result_is_redacted_and_formatted", expected, output.str());
+	RETURN_TEST("test_lazy_result_is_redacted_and_formatted", 0);
+}
+
+int test_lazy_throwing_invocable_discards_value() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << "a" << []() -> int { throw 1; } << "b" << std::endl;
+
+	std::string expected = "Info    : ab\n";
+	ASSERT_EQUAL("test_lazy_throwing_invocable_discards_value", expected, output.str());
+	RETURN_TEST("test_lazy_throwing_invocable_discards_value", 0);
+}
+
+int test_enabled_reflects_current_level() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Debug;
+	const bool debug = log.Enabled();
+	log << std::endl << Level::Error;
+	const bool error = log.Enabled();
+	log << std::endl;
+
+	ASSERT_EQUAL("test_enabled_reflects_current_level (debug)", false, debug);
+	ASSERT_EQUAL("test_enabled_reflects_current_level (error)", true, error);
+	RETURN_TEST("test_enabled_reflects_current_level", 0);
+}
+
+// --- Records ---
+
+int test_record_ends_on_destruction() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	{
+		auto record = log.Record(Level::Info);
+		record << "value=" << 7;
+		record << " " << [] { return std::string("lazy"); };
+	}
+	{
+		auto record = log.Record(Level::Debug);
+		record << "hidden";
+	}
+	log.Record(Level::Error) << "inline";
+
+	std::string expected = "Info    : value=7 lazy\nError   : inline\n";
+	ASSERT_EQUAL("test_record_ends_on_destruction", expected, output.str());
+	RETURN_TEST("test_record_ends_on_destruction", 0);
+}
+
+int test_endr_ends_record_once() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << "one" << endr;
+	log << endr;											// nothing pending: no empty line
+	log << Level::Info << "two" << endr << "three" << endr;
+
+	std::string expected = "Info    : one\nInfo    : two\nInfo    : three\n";
+	ASSERT_EQUAL("test_endr_ends_record_once", expected, output.str());
+	RETURN_TEST("test_endr_ends_record_once", 0);
+}
+
 int main() {
 	int result = 0;
 
@@ -209,6 +301,12 @@ int main() {
 	result += test_filtered_produces_empty_output();
 	result += test_filtered_then_enabled_message();
 	result += test_escaped_percent_in_format();
+	result += test_lazy_invoked_only_when_enabled();
+	result += test_lazy_result_is_redacted_and_formatted();
+	result += test_lazy_throwing_invocable_discards_value();
+	result += test_enabled_reflects_current_level();
+	result += test_record_ends_on_destruction();
+	result += test_endr_ends_record_once();
 
 	if (result == 0) {
 		std::cout << "All tests passed!" << std::endl;
@@ -277,6 +277,70 @@ int test_manip_redact_first_threadedlog() {
 	RETURN_TEST("test_manip_redact_first_threadedlog", 0);
 }
 
+// ---------------------------------------------------------------------------
+// Numeric formatting: shortest round-trip by default, precision(N) for fixed
+// decimals, std::hex / std::oct / std::dec for integer bases. State persists.
+// ---------------------------------------------------------------------------
+
+int test_manip_float_shortest_default() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << 1.5 << " " << 0.1 << " " << 2.0f << std::endl;
+
+	std::string expected = "Info    : 1.5 0.1 2\n";
+	ASSERT_EQUAL("test_manip_float_shortest_default", expected, output.str());
+	RETURN_TEST("test_manip_float_shortest_default", 0);
+}
+
+int test_manip_precision_fixed() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << precision(3) << 3.14159 << " " << 2.0 << std::endl;
+	log << Level::Info << 1.0 / 3.0 << std::endl;
+	log << Level::Info << shortest << 0.25 << std::endl;
+
+	std::string expected = "Info    : 3.142 2.000\nInfo    : 0.333\nInfo    : 0.25\n";
+	ASSERT_EQUAL("test_manip_precision_fixed", expected, output.str());
+	RETURN_TEST("test_manip_precision_fixed", 0);
+}
+
+int test_manip_integer_bases() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << std::hex << 255 << " " << std::oct << 8 << " " << std::dec << 42 << std::endl;
+	log << Level::Info << std::hex << -16 << std::dec << std::endl;
+
+	std::string expected = "Info    : ff 10 42\nInfo    : -10\n";
+	ASSERT_EQUAL("test_manip_integer_bases", expected, output.str());
+	RETURN_TEST("test_manip_integer_bases", 0);
+}
+
+int test_manip_precision_threadedlog() {
+	std::ostringstream output;
+	ThreadedLog tlog(output, Level::Info, "%L:");
+
+	tlog << Level::Info << precision(1) << 2.26 << " " << std::hex << 4096 << std::endl;
+
+	std::string expected = "Info    : 2.3 1000\n";
+	ASSERT_EQUAL("test_manip_precision_threadedlog", expected, output.str());
+	RETURN_TEST("test_manip_precision_threadedlog", 0);
+}
+
+int test_manip_precision_redacted() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+
+	log << Level::Info << precision(2) << redact(2) << 1234.5 << std::endl;
+
+	// "1234.50" (7) → *****50
+	std::string expected = "Info    : *****50\n";
+	ASSERT_EQUAL("test_manip_precision_redacted", expected, output.str());
+	RETURN_TEST("test_manip_precision_redacted", 0);
+}
+
 int main() {
 	int result = 0;
 
@@ -305,6 +369,12 @@ int main() {
 	result += test_manip_redact_first_const_char_ptr();
 	result += test_manip_redact_first_threadedlog();
 
+	result += test_manip_float_shortest_default();
+	result += test_manip_precision_fixed();
+	result += test_manip_integer_bases();
+	result += test_manip_precision_threadedlog();
+	result += test_manip_precision_redacted();
+
 	if (result == 0) {
 		std::cout << "All tests passed!" << std::endl;
 	} else {
@@ -0,0 +1,183 @@
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/mapped_file_sink.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/platform.h>
+#include <StormByte/test_handlers.h>
+
+#include "temp_dir.hxx"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef WINDOWS
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+using namespace StormByte::Logger;
+using StormByte::Logger::Test::TempDir;
+
+namespace {
+	std::string record(int i) {
+		return "Info    : record " + std::to_string(i) + "\n";
+	}
+}
+
+int test_mapped_basic() {
+	TempDir dir("mapped_basic");
+	{
+		MappedFileSink sink(dir.Log());
+		ASSERT_EQUAL("test_mapped_basic (open)", true, sink.IsOpen());
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "hello " << 42 << std::endl;
+		log << Level::Debug << "hidden" << std::endl;
+		log << Level::Error << "bye" << endr;
+	}
+
+	const std::string expected = "Info    : hello 42\nError   : bye\n";
+	ASSERT_EQUAL("test_mapped_basic", expected, MappedFileSink::ReadSegment(dir.Segment(1)));
+	// Finished segments are trimmed to header + committed data, and the unused spare is removed.
+	ASSERT_EQUAL("test_mapped_basic (trimmed)", static_cast<std::uintmax_t>(64 + expected.size()), std::filesystem::file_size(dir.Segment(1)));
+	ASSERT_EQUAL("test_mapped_basic (files)", static_cast<std::size_t>(1), dir.Files());
+	RETURN_TEST("test_mapped_basic", 0);
+}
+
+int test_mapped_segments() {
+	TempDir dir("mapped_segments");
+	std::string expected;
+	std::uint64_t segments;
+	{
+		MappedFileSink sink(dir.Log(), 64 * 1024);
+		Log log(sink, Level::Info, "%L:");
+		for (int i = 0; i < 20000; ++i) {
+			log << Level::Info << "record " << i << endr;
+			expected += record(i);
+			if (i % 1000 == 999)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		segments = sink.Segments();
+	}
+
+	ASSERT_EQUAL("test_mapped_segments (count)", true, segments >= 5);
+	ASSERT_EQUAL("test_mapped_segments (files)", static_cast<std::size_t>(segments), dir.Files());
+	for (std::uint64_t i = 1; i <= segments; ++i) {
+		const std::string segment = MappedFileSink::ReadSegment(dir.Segment(static_cast<int>(i)));
+		ASSERT_EQUAL("test_mapped_segments (whole records)", '\n', segment.back());
+		ASSERT_EQUAL("test_mapped_segments (record start)", 0, static_cast<int>(segment.find("Info    : record ")));
+	}
+	ASSERT_EQUAL("test_mapped_segments (content)", expected, MappedFileSink::ReadAll(dir.Log()));
+	RETURN_TEST("test_mapped_segments", 0);
+}
+
+int test_mapped_large_record() {
+	TempDir dir("mapped_large");
+	const std::string big(100000, 'x');
+	{
+		MappedFileSink sink(dir.Log(), 64 * 1024);
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "a" << endr;
+		log << Level::Info << big << endr;
+		log << Level::Info << "b" << endr;
+	}
+
+	ASSERT_EQUAL("test_mapped_large_record", "Info    : a\nInfo    : " + big + "\nInfo    : b\n", MappedFileSink::ReadAll(dir.Log()));
+	RETURN_TEST("test_mapped_large_record", 0);
+}
+
+int test_mapped_continues_numbering() {
+	TempDir dir("mapped_numbering");
+	{
+		MappedFileSink sink(dir.Log());
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "first" << endr;
+	}
+	{
+		MappedFileSink sink(dir.Log());
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "second" << endr;
+	}
+
+	ASSERT_EQUAL("test_mapped_continues_numbering (1)", std::string("Info    : first\n"), MappedFileSink::ReadSegment(dir.Segment(1)));
+	ASSERT_EQUAL("test_mapped_continues_numbering (2)", std::string("Info    : second\n"), MappedFileSink::ReadSegment(dir.Segment(2)));
+	RETURN_TEST("test_mapped_continues_numbering", 0);
+}
+
+int test_mapped_crash_recovery() {
+#ifndef WINDOWS
+	TempDir dir("mapped_crash");
+	const pid_t child = ::fork();
+	if (child == 0) {
+		// Die without running any destructor, in the middle of a record.
+		MappedFileSink sink(dir.Log());
+		Log log(sink, Level::Info, "%L:");
+		for (int i = 0; i < 10; ++i)
+			log << Level::Info << "record " << i << endr;
+		log << Level::Info << "unfinished";
+		::_exit(0);
+	}
+	int status = 0;
+	::waitpid(child, &status, 0);
+
+	std::string expected;
+	for (int i = 0; i < 10; ++i)
+		expected += record(i);
+	ASSERT_EQUAL("test_mapped_crash_recovery", expected, MappedFileSink::ReadAll(dir.Log()));
+#endif
+	RETURN_TEST("test_mapped_crash_recovery", 0);
+}
+
+int test_mapped_threaded() {
+	TempDir dir("mapped_threaded");
+	constexpr int threads = 4;
+	constexpr int per_thread = 5000;
+	{
+		MappedFileSink sink(dir.Log(), 64 * 1024);
+		ThreadedLog log(sink, Level::Info, "%L:");
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t) {
+			pool.emplace_back([&, t] {
+				for (int i = 0; i < per_thread; ++i)
+					log << Level::Info << "T" << t << ":" << i << endr;
+			});
+		}
+		for (auto& th : pool) th.join();
+	}
+
+	std::istringstream in(MappedFileSink::ReadAll(dir.Log()));
+	std::string line;
+	int count = 0;
+	const std::regex r("^Info\\s+: T\\d+:\\d+$");
+	while (std::getline(in, line)) {
+		if (!std::regex_match(line, r)) {
+			ASSERT_EQUAL("test_mapped_threaded", "OK", std::string("BAD: ") + line);
+			return 1;
+		}
+		++count;
+	}
+	ASSERT_EQUAL("test_mapped_threaded (count)", threads * per_thread, count);
+	RETURN_TEST("test_mapped_threaded", 0);
+}
+
+int main() {
+	int result = 0;
+
+	result += test_mapped_basic();
+	result += test_mapped_segments();
+	result += test_mapped_large_record();
+	result += test_mapped_continues_numbering();
+	result += test_mapped_crash_recovery();
+	result += test_mapped_threaded();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
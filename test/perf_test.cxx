@@ -1,13 +1,20 @@
+// Debug and below are compiled out of STORMBYTE_LOG statements in this translation unit.
+#undef STORMBYTE_LOGGER_MIN_LEVEL
+#define STORMBYTE_LOGGER_MIN_LEVEL STORMBYTE_LOGGER_LEVEL_WARNING
+
+#include <StormByte/logger/clock_source.hxx>
 #include <StormByte/logger/log.hxx>
 #include <StormByte/logger/threaded_log.hxx>
 #include <StormByte/test_handlers.h>
 
+#include <algorithm>
 #include <sstream>
 #include <chrono>
 #include <thread>
 #include <vector>
 #include <atomic>
 #include <iostream>
+#include <memory>
 
 using namespace StormByte::Logger;
 
@@ -31,6 +38,53 @@ int test_log_filtered_high_volume() {
 	RETURN_TEST("test_log_filtered_high_volume", 0);
 }
 
+// Same statements as test_log_filtered_high_volume, run-time filtered vs compiled out.
+int test_log_filtered_vs_stripped() {
+	std::ostringstream output;
+	Log log(output, Level::Error, "%L:");
+	constexpr int N = 100000;
+
+	const auto t0 = std::chrono::steady_clock::now();
+	for (int i = 0; i < N; ++i)
+		log << Level::Debug << "x=" << i << " b=" << true << " d=" << 1.5 << std::endl;
+	const auto t1 = std::chrono::steady_clock::now();
+	for (int i = 0; i < N; ++i)
+		STORMBYTE_LOG(log, Level::Debug) << "x=" << i << " b=" << true << " d=" << 1.5 << std::endl;
+	const auto t2 = std::chrono::steady_clock::now();
+
+	const auto filtered = std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / N;
+	const auto stripped = std::chrono::duration_cast<std::chrono::nanoseconds>(t2 - t1).count() / N;
+
+	ASSERT_EQUAL("test_log_filtered_vs_stripped (output)", std::string(""), output.str());
+	std::cout << "  [perf] Log Debug statement: filtered " << filtered << " ns, stripped "
+			<< stripped << " ns\n";
+	RETURN_TEST("test_log_filtered_vs_stripped", 0);
+}
+
+// Enabled numeric tokens: one level check per token, then straight into the formatter.
+int test_enabled_token_cost() {
+	constexpr int N = 100000;
+	constexpr int tokens = 8;
+
+	for (const auto threaded : { false, true }) {
+		std::ostringstream output;
+		std::unique_ptr<Log> log = threaded
+			? std::make_unique<ThreadedLog>(output, Level::Info, "%L:")
+			: std::make_unique<Log>(output, Level::Info, "%L:");
+
+		const auto t0 = std::chrono::steady_clock::now();
+		for (int i = 0; i < N; ++i) {
+			*log << Level::Info << i << " " << i << " " << i << " " << i << std::endl;
+			if ((i & 1023) == 0) output.str("");
+		}
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - t0).count() / (static_cast<long long>(N) * tokens);
+
+		std::cout << "  [perf] " << (threaded ? "ThreadedLog" : "Log") << " enabled token: " << ns << " ns\n";
+	}
+	RETURN_TEST("test_enabled_token_cost", 0);
+}
+
 // Filtered ThreadedLog then one visible line (lock must not leak).
 int test_threaded_filtered_high_volume() {
 	std::ostringstream output;
@@ -92,11 +146,183 @@ int test_threaded_filtered_multithreaded_volume() {
 	RETURN_TEST("test_threaded_filtered_multithreaded_volume", 0);
 }
 
+// Per-header cost of the time fields, relative to a header without them.
+int test_log_header_timestamp_cost() {
+	constexpr int N = 100000;
+	long long baseline = 0;
+
+	for (const char* format : { "%L:", "%L %T:", "%L %T.%6:", "%L %Z.%9Z:", "%L %i:", "%L %n %t:" }) {
+		std::ostringstream output;
+		Log log(output, Level::Info, format);
+
+		const auto t0 = std::chrono::steady_clock::now();
+		for (int i = 0; i < N; ++i) {
+			log << Level::Info << "x" << std::endl;
+			if ((i & 1023) == 0) output.str("");
+		}
+		const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - t0).count() / N;
+		if (baseline == 0) baseline = ns;
+
+		std::cout << "  [perf] Log header \"" << format << "\": " << ns << " ns/line ("
+				<< (ns - baseline) << " ns over \"%L:\")\n";
+	}
+	RETURN_TEST("test_log_header_timestamp_cost", 0);
+}
+
+// Nanosecond header: system clock read vs calibrated CPU counter.
+int test_clock_source_cost() {
+	constexpr int N = 100000;
+	long long cost[2];
+
+	for (const auto source : { ClockSource::System, ClockSource::Counter }) {
+		SetClockSource(source);
+		std::ostringstream output;
+		Log log(output, Level::Info, "%L %Z.%9:");
+
+		const auto t0 = std::chrono::steady_clock::now();
+		for (int i = 0; i < N; ++i) {
+			log << Level::Info << "x" << endr;
+			if ((i & 1023) == 0) output.str("");
+		}
+		cost[source == ClockSource::Counter] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now() - t0).count() / N;
+	}
+	SetClockSource(ClockSource::System);
+
+	std::cout << "  [perf] Log header \"%L %Z.%9:\": system clock " << cost[0] << " ns/line, "
+			<< (GetClockStatus().invariant ? "CPU counter " : "steady_clock fallback ") << cost[1] << " ns/line\n";
+	RETURN_TEST("test_clock_source_cost", 0);
+}
+
+// Enabled lines from several threads: Locked vs Staged line mode.
+int test_threaded_enabled_locked_vs_staged() {
+	constexpr int threads = 8;
+	constexpr int per_thread = 5000;
+
+	for (const auto mode : { LineMode::Locked, LineMode::Staged, LineMode::Sharded }) {
+		std::ostringstream output;
+		long long ms;
+		{
+			ThreadedLog tlog(output, Level::Info, "%L:", mode);
+
+			auto worker = [&](int id) {
+				for (int i = 0; i < per_thread; ++i) {
+					tlog << Level::Info << "t" << id << " i=" << i << " d=" << 1.5 << std::endl;
+				}
+			};
+
+			std::vector<std::thread> pool;
+			pool.reserve(threads);
+			const auto t0 = std::chrono::steady_clock::now();
+			for (int t = 0; t < threads; ++t) {
+				pool.emplace_back(worker, t);
+			}
+			for (auto& th : pool) {
+				th.join();
+			}
+			// Producer time only: sharded lines may still be merging.
+			ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now() - t0).count();
+		}
+
+		const std::string out = output.str();
+		const auto lines = std::count(out.begin(), out.end(), '\n');
+		ASSERT_EQUAL("test_threaded_enabled_locked_vs_staged (lines)",
+			std::to_string(threads * per_thread), std::to_string(lines));
+
+		std::cout << "  [perf] ThreadedLog " << (mode == LineMode::Sharded ? "sharded" : mode == LineMode::Staged ? "staged" : "locked")
+				<< " enabled " << (threads * per_thread) << " lines (" << threads << " threads) in "
+				<< ms << " ms\n";
+	}
+	RETURN_TEST("test_threaded_enabled_locked_vs_staged", 0);
+}
+
+// Filtered Debug statements: dropped at the level check vs captured by a flight recorder.
+int test_flight_recorder_capture_cost() {
+	constexpr int N = 100000;
+
+	for (const auto staged : { false, true }) {
+		long long cost[2];
+		for (const auto recording : { false, true }) {
+			std::ostringstream output;
+			std::unique_ptr<Log> log = staged
+				? std::unique_ptr<Log>(std::make_unique<ThreadedLog>(output, Level::Info, "%L:", LineMode::Staged))
+				: std::make_unique<Log>(output, Level::Info, "%L:");
+			if (recording)
+				log->EnableFlightRecorder({ .capture = Level::Debug, .records = 16 });
+
+			const auto t0 = std::chrono::steady_clock::now();
+			for (int i = 0; i < N; ++i)
+				*log << Level::Debug << "x=" << i << " b=" << true << " d=" << 1.5 << endr;
+			cost[recording] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now() - t0).count() / N;
+
+			*log << Level::Error << "failed" << endr;
+			const std::string out = output.str();
+			const auto lines = std::count(out.begin(), out.end(), '\n');
+			ASSERT_EQUAL("test_flight_recorder_capture_cost (lines)", std::to_string(recording ? 17 : 1), std::to_string(lines));
+		}
+		std::cout << "  [perf] " << (staged ? "ThreadedLog staged" : "Log") << " Debug statement: filtered "
+				<< cost[0] << " ns, captured by flight recorder " << cost[1] << " ns\n";
+	}
+	RETURN_TEST("test_flight_recorder_capture_cost", 0);
+}
+
+// Always-on counters, through the public surface: what a filtered and an enabled statement cost
+// with every counter live, and whether Stats() accounts for each of them.
+int test_stats_counter_cost() {
+	constexpr int N = 200000;
+
+	for (const auto staged : { false, true }) {
+		std::ostringstream output;
+		std::unique_ptr<Log> log = staged
+			? std::unique_ptr<Log>(std::make_unique<ThreadedLog>(output, Level::Info, "%L:", LineMode::Staged))
+			: std::make_unique<Log>(output, Level::Info, "%L:");
+
+		const auto t0 = std::chrono::steady_clock::now();
+		for (int i = 0; i < N; ++i)
+			*log << Level::Debug << "x=" << i << endr;
+		const auto t1 = std::chrono::steady_clock::now();
+		for (int i = 0; i < N; ++i)
+			*log << Level::Info << "x=" << i << endr;
+		const auto t2 = std::chrono::steady_clock::now();
+		const LogStats stats = log->Stats();
+		const auto t3 = std::chrono::steady_clock::now();
+
+		ASSERT_EQUAL("test_stats_counter_cost (filtered)", static_cast<std::uint64_t>(N), stats.Filtered());
+		ASSERT_EQUAL("test_stats_counter_cost (emitted)", static_cast<std::uint64_t>(N), stats.Emitted());
+		if (staged) {
+			// Staged lines also pay for the write, byte and lock counters and the sampled latency.
+			ASSERT_EQUAL("test_stats_counter_cost (writes)", static_cast<std::uint64_t>(N), stats.writes);
+			ASSERT_EQUAL("test_stats_counter_cost (bytes)", static_cast<std::uint64_t>(output.str().size()), stats.bytes);
+			ASSERT_EQUAL("test_stats_counter_cost (lock)", stats.writes, stats.lock_acquisitions);
+		}
+
+		auto ns = [](auto from, auto to, long long count) {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count() / count;
+		};
+		std::cout << "  [perf] " << (staged ? "ThreadedLog staged" : "Log") << " with counters: filtered statement "
+				<< ns(t0, t1, N) << " ns, enabled " << ns(t1, t2, N) << " ns; Stats() " << ns(t2, t3, 1) << " ns";
+		if (staged)
+			std::cout << "; write p50 " << stats.write_latency.Percentile(50) << " ns";
+		std::cout << "\n";
+	}
+	RETURN_TEST("test_stats_counter_cost", 0);
+}
+
 int main() {
 	int result = 0;
 	result += test_log_filtered_high_volume();
+	result += test_log_filtered_vs_stripped();
+	result += test_enabled_token_cost();
 	result += test_threaded_filtered_high_volume();
 	result += test_threaded_filtered_multithreaded_volume();
+	result += test_log_header_timestamp_cost();
+	result += test_clock_source_cost();
+	result += test_threaded_enabled_locked_vs_staged();
+	result += test_flight_recorder_capture_cost();
+	result += test_stats_counter_cost();
 
 	if (result == 0) {
 		std::cout << "All tests passed!" << std::endl;
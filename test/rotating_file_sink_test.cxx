@@ -0,0 +1,257 @@
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/rotating_file_sink.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include "temp_dir.hxx"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace StormByte::Logger;
+using StormByte::Logger::Test::TempDir;
+
+namespace {
+	// Number of segment files, ".next" excluded.
+	std::size_t segment_count(const TempDir& dir) {
+		std::size_t count = 0;
+		for (const auto& entry : std::filesystem::directory_iterator(dir.Path())) {
+			const std::string name = entry.path().filename().string();
+			if (name != "app.log" && name != "app.log.next")
+				++count;
+		}
+		return count;
+	}
+
+	bool has_spare(const TempDir& dir) {
+		return std::filesystem::exists(dir.Path() / "app.log.next");
+	}
+
+	// Segments in rotation order followed by the active file; fails the test on a torn record.
+	int read_all(const char* name, const TempDir& dir, std::size_t segments, std::string& all) {
+		for (std::size_t i = 1; i <= segments; ++i) {
+			const std::string segment = TempDir::Read(dir.Segment(static_cast<int>(i)));
+			if (segment.empty() || segment.back() != '\n') {
+				ASSERT_EQUAL(name, "whole records", "segment " + std::to_string(i) + ": " + segment);
+				return 1;
+			}
+			all += segment;
+		}
+		all += TempDir::Read(dir.Log());
+		return 0;
+	}
+}
+
+int test_rotating_by_size() {
+	TempDir dir("rotating_size");
+	std::string expected;
+	std::uint64_t rotations;
+	{
+		RotationOptions rotation;
+		rotation.max_size = 200;
+		RotatingFileSink sink(dir.Log(), rotation);
+		Log log(sink, Level::Info, "%L:");
+		for (int i = 0; i < 200; ++i) {
+			log << Level::Info << "record " << i << endr;
+			expected += "Info    : record " + std::to_string(i) + "\n";
+			if (i % 10 == 9)
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));	// let the next file be prepared
+		}
+		rotations = sink.Rotations();
+	}
+
+	ASSERT_EQUAL("test_rotating_by_size (rotated)", true, rotations >= 2);
+	ASSERT_EQUAL("test_rotating_by_size (segments)", static_cast<std::size_t>(rotations), segment_count(dir));
+	ASSERT_EQUAL("test_rotating_by_size (spare removed)", false, has_spare(dir));
+	std::string all;
+	if (read_all("test_rotating_by_size (whole)", dir, segment_count(dir), all) != 0)
+		return 1;
+	ASSERT_EQUAL("test_rotating_by_size (content)", expected, all);
+	RETURN_TEST("test_rotating_by_size", 0);
+}
+
+int test_rotating_retention_and_hook() {
+	TempDir dir("rotating_retention");
+	std::vector<std::string> rotated;
+	std::uint64_t rotations;
+	{
+		RotationOptions rotation;
+		rotation.max_size = 100;
+		rotation.max_files = 2;
+		// Stand-in for compression: replace each segment with a renamed copy.
+		rotation.on_rotate = [&rotated](const std::filesystem::path& segment) {
+			rotated.push_back(segment.filename().string());
+			std::filesystem::path compressed = segment;
+			compressed += ".gz";
+			std::filesystem::rename(segment, compressed);
+		};
+		RotatingFileSink sink(dir.Log(), rotation);
+		Log log(sink, Level::Info, "%L:");
+		for (int i = 0; i < 100; ++i) {
+			log << Level::Info << "record " << i << endr;
+			if (i % 5 == 4)
+				std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		rotations = sink.Rotations();
+	}
+
+	ASSERT_EQUAL("test_rotating_retention_and_hook (rotated)", true, rotations > 2);
+	ASSERT_EQUAL("test_rotating_retention_and_hook (hook calls)", static_cast<std::size_t>(rotations), rotated.size());
+	ASSERT_EQUAL("test_rotating_retention_and_hook (first)", std::string("app.log.1"), rotated.front());
+	ASSERT_EQUAL("test_rotating_retention_and_hook (kept)", static_cast<std::size_t>(2), segment_count(dir));
+	std::filesystem::path newest = dir.Segment(static_cast<int>(rotations));
+	newest += ".gz";
+	ASSERT_EQUAL("test_rotating_retention_and_hook (newest kept)", true, std::filesystem::exists(newest));
+	RETURN_TEST("test_rotating_retention_and_hook", 0);
+}
+
+int test_rotating_by_time() {
+	TempDir dir("rotating_time");
+	{
+		RotationOptions rotation;
+		rotation.interval = std::chrono::milliseconds(100);
+		RotatingFileSink sink(dir.Log(), rotation);
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "a" << std::endl;
+		std::this_thread::sleep_for(std::chrono::milliseconds(300));
+		log << Level::Info << "b" << std::endl;
+		ASSERT_EQUAL("test_rotating_by_time (rotations)", static_cast<std::uint64_t>(1), sink.Rotations());
+	}
+
+	ASSERT_EQUAL("test_rotating_by_time (segment)", std::string("Info    : a\n"), TempDir::Read(dir.Segment(1)));
+	ASSERT_EQUAL("test_rotating_by_time (active)", std::string("Info    : b\n"), TempDir::Read(dir.Log()));
+	RETURN_TEST("test_rotating_by_time", 0);
+}
+
+int test_rotating_resumes_interrupted_rotation() {
+	TempDir dir("rotating_resume");
+	std::ofstream(dir.Log()) << "old\n";
+	std::ofstream(dir.Segment(3)) << "older\n";
+	{
+		std::filesystem::path spare = dir.Log();
+		spare += ".next";
+		std::ofstream(spare) << "new\n";
+	}
+	{
+		RotatingFileSink sink(dir.Log(), RotationOptions{});
+		Log log(sink, Level::Info, "%L:");
+		log << Level::Info << "x" << std::endl;
+	}
+
+	ASSERT_EQUAL("test_rotating_resumes_interrupted_rotation (segment)", std::string("old\n"), TempDir::Read(dir.Segment(4)));
+	ASSERT_EQUAL("test_rotating_resumes_interrupted_rotation (active)", std::string("new\nInfo    : x\n"), TempDir::Read(dir.Log()));
+	ASSERT_EQUAL("test_rotating_resumes_interrupted_rotation (spare removed)", false, has_spare(dir));
+	RETURN_TEST("test_rotating_resumes_interrupted_rotation", 0);
+}
+
+int test_rotating_threaded() {
+	TempDir dir("rotating_threaded");
+	constexpr int threads = 4;
+	constexpr int per_thread = 2000;
+	{
+		RotationOptions rotation;
+		rotation.max_size = 16 * 1024;
+		RotatingFileSink sink(dir.Log(), rotation, 4096);
+		ThreadedLog log(sink, Level::Info, "%L:");
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t) {
+			pool.emplace_back([&, t] {
+				for (int i = 0; i < per_thread; ++i)
+					log << Level::Info << "T" << t << ":" << i << endr;
+			});
+		}
+		for (auto& th : pool) th.join();
+	}
+
+	ASSERT_EQUAL("test_rotating_threaded (rotated)", true, segment_count(dir) > 0);
+	std::string all;
+	if (read_all("test_rotating_threaded (whole)", dir, segment_count(dir), all) != 0)
+		return 1;
+	std::istringstream in(all);
+	std::string line;
+	int count = 0;
+	const std::regex r("^Info\\s+: T\\d+:\\d+$");
+	while (std::getline(in, line)) {
+		if (!std::regex_match(line, r)) {
+			ASSERT_EQUAL("test_rotating_threaded", "OK", std::string("BAD: ") + line);
+			return 1;
+		}
+		++count;
+	}
+	ASSERT_EQUAL("test_rotating_threaded (count)", threads * per_thread, count);
+	RETURN_TEST("test_rotating_threaded", 0);
+}
+
+int test_rotating_by_size_and_time() {
+	// Both triggers at once, at a pace where the spare is often ready when the interval wakes the
+	// maintenance thread: a size rotation in that wake must not make it open a second spare.
+	TempDir dir("rotating_size_and_time");
+	constexpr int threads = 2;
+	constexpr int per_thread = 4000;
+	std::uint64_t rotations;
+	{
+		RotationOptions rotation;
+		rotation.max_size = 256;
+		rotation.interval = std::chrono::milliseconds(1);
+		RotatingFileSink sink(dir.Log(), rotation, 1024);
+		ThreadedLog log(sink, Level::Info, "%L:");
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t) {
+			pool.emplace_back([&, t] {
+				for (int i = 0; i < per_thread; ++i) {
+					log << Level::Info << "T" << t << ":" << i << endr;
+					std::this_thread::sleep_for(std::chrono::microseconds(10));
+				}
+			});
+		}
+		for (auto& th : pool) th.join();
+		rotations = sink.Rotations();
+	}
+
+	ASSERT_EQUAL("test_rotating_by_size_and_time (rotated)", true, rotations > 0);
+	ASSERT_EQUAL("test_rotating_by_size_and_time (segments)", static_cast<std::size_t>(rotations), segment_count(dir));
+	ASSERT_EQUAL("test_rotating_by_size_and_time (spare removed)", false, has_spare(dir));
+	std::string all;
+	if (read_all("test_rotating_by_size_and_time (whole)", dir, segment_count(dir), all) != 0)
+		return 1;
+	std::vector<int> next(threads, 0);
+	std::istringstream in(all);
+	std::string line;
+	const std::regex r("^Info\\s+: T(\\d+):(\\d+)$");
+	std::smatch match;
+	while (std::getline(in, line)) {
+		// Each thread's records appear once, in order, across the segments and the active file.
+		if (!std::regex_match(line, match, r) || std::stoi(match[2]) != next[std::stoi(match[1])]++) {
+			ASSERT_EQUAL("test_rotating_by_size_and_time", "OK", std::string("BAD: ") + line);
+			return 1;
+		}
+	}
+	for (int t = 0; t < threads; ++t)
+		ASSERT_EQUAL("test_rotating_by_size_and_time (count)", per_thread, next[t]);
+	RETURN_TEST("test_rotating_by_size_and_time", 0);
+}
+
+int main() {
+	int result = 0;
+
+	result += test_rotating_by_size();
+	result += test_rotating_retention_and_hook();
+	result += test_rotating_by_time();
+	result += test_rotating_resumes_interrupted_rotation();
+	result += test_rotating_threaded();
+	result += test_rotating_by_size_and_time();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
@@ -0,0 +1,203 @@
+#include <StormByte/logger/async_log.hxx>
+#include <StormByte/logger/binary_log.hxx>
+#include <StormByte/logger/fanout_log.hxx>
+#include <StormByte/logger/log.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace StormByte::Logger;
+
+namespace {
+	std::uint64_t at(const std::array<std::uint64_t, LogStats::Levels>& counts, const Level& level) {
+		return counts[static_cast<std::size_t>(level)];
+	}
+}
+
+int test_level_counts() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%L:");
+	for (int i = 0; i < 3; ++i)
+		log << Level::Info << "info " << i << endr;
+	log << Level::Error << "error" << std::endl;
+	for (int i = 0; i < 5; ++i)
+		log << Level::Debug << "hidden " << i << endr;
+	log << Level::Info << endr;
+
+	const LogStats stats = log.Stats();
+	ASSERT_EQUAL("test_level_counts (info)", std::uint64_t{3}, at(stats.emitted, Level::Info));
+	ASSERT_EQUAL("test_level_counts (error)", std::uint64_t{1}, at(stats.emitted, Level::Error));
+	ASSERT_EQUAL("test_level_counts (emitted)", std::uint64_t{4}, stats.Emitted());
+	ASSERT_EQUAL("test_level_counts (debug)", std::uint64_t{5}, at(stats.filtered, Level::Debug));
+	ASSERT_EQUAL("test_level_counts (filtered)", std::uint64_t{5}, stats.Filtered());
+	// Log streams tokens straight to the output: no line writes to count.
+	ASSERT_EQUAL("test_level_counts (bytes)", std::uint64_t{0}, stats.bytes);
+
+	Log copy = log;
+	copy << Level::Info << "copy" << endr;
+	ASSERT_EQUAL("test_level_counts (shared)", std::uint64_t{5}, log.Stats().Emitted());
+	RETURN_TEST("test_level_counts", 0);
+}
+
+int test_locked_lock_counts() {
+	std::ostringstream output;
+	ThreadedLog log(output, Level::Info, "%L:");
+	constexpr int threads = 4;
+	constexpr int per_thread = 500;
+
+	std::vector<std::thread> pool;
+	for (int t = 0; t < threads; ++t) {
+		pool.emplace_back([&] {
+			for (int i = 0; i < per_thread; ++i) {
+				log << Level::Info << "line " << i << std::endl;
+				log << Level::Debug << "hidden" << std::endl;
+			}
+		});
+	}
+	for (auto& thread : pool)
+		thread.join();
+
+	const LogStats stats = log.Stats();
+	ASSERT_EQUAL("test_locked_lock_counts (emitted)", std::uint64_t{threads * per_thread}, stats.Emitted());
+	ASSERT_EQUAL("test_locked_lock_counts (filtered)", std::uint64_t{threads * per_thread}, stats.Filtered());
+	// One acquisition per line, filtered statements included.
+	ASSERT_EQUAL("test_locked_lock_counts (acquisitions)", std::uint64_t{2 * threads * per_thread}, stats.lock_acquisitions);
+	ASSERT_TRUE("test_locked_lock_counts (hold)", stats.lock_hold_ns > 0);
+	RETURN_TEST("test_locked_lock_counts", 0);
+}
+
+int test_staged_bytes() {
+	std::ostringstream output;
+	constexpr int threads = 4;
+	constexpr int per_thread = 300;
+	LogStats stats;
+	{
+		ThreadedLog log(output, Level::Info, "%L:", LineMode::Staged);
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t) {
+			pool.emplace_back([&, t] {
+				for (int i = 0; i < per_thread; ++i)
+					log << Level::Info << "t" << t << " i=" << i << endr;
+			});
+		}
+		for (auto& thread : pool)
+			thread.join();
+		stats = log.Stats();
+	}
+
+	ASSERT_EQUAL("test_staged_bytes (emitted)", std::uint64_t{threads * per_thread}, stats.Emitted());
+	ASSERT_EQUAL("test_staged_bytes (writes)", std::uint64_t{threads * per_thread}, stats.writes);
+	ASSERT_EQUAL("test_staged_bytes (bytes)", static_cast<std::uint64_t>(output.str().size()), stats.bytes);
+	// One write in 64 is timed, the first one always.
+	ASSERT_TRUE("test_staged_bytes (sampled)", stats.write_latency.Count() >= 1
+		&& stats.write_latency.Count() <= stats.writes / 64 + 1);
+	ASSERT_TRUE("test_staged_bytes (p99)", stats.write_latency.Percentile(99) > 0);
+	ASSERT_EQUAL("test_staged_bytes (lock)", stats.writes, stats.lock_acquisitions);
+	RETURN_TEST("test_staged_bytes", 0);
+}
+
+int test_async_queue() {
+	std::ostringstream output;
+	constexpr int lines = 2000;
+	LogStats stats;
+	std::uint64_t dropped;
+	{
+		AsyncLog log(output, Level::Info, "%L:", 16, OverflowPolicy::DropNewest);
+		for (int i = 0; i < lines; ++i)
+			log << Level::Info << "line " << i << endr;
+		log.Flush();
+		stats = log.Stats();
+		dropped = log.Dropped();
+	}
+
+	ASSERT_EQUAL("test_async_queue (dropped)", dropped, stats.dropped);
+	ASSERT_EQUAL("test_async_queue (written)", std::uint64_t{lines}, stats.writes + stats.dropped);
+	ASSERT_EQUAL("test_async_queue (bytes)", static_cast<std::uint64_t>(output.str().size()), stats.bytes);
+	ASSERT_TRUE("test_async_queue (high water)", stats.queue_high_water >= 1 && stats.queue_high_water <= lines);
+	RETURN_TEST("test_async_queue", 0);
+}
+
+int test_fanout_and_binary() {
+	std::ostringstream errors, everything;
+	{
+		FanoutLog log({ Route(errors, Level::Error), Route(everything, Level::Info) }, "%L:");
+		log << Level::Info << "info" << endr;
+		log << Level::Error << "error" << endr;
+		log << Level::Debug << "hidden" << endr;
+
+		const LogStats stats = log.Stats();
+		ASSERT_EQUAL("test_fanout_and_binary (emitted)", std::uint64_t{2}, stats.Emitted());
+		ASSERT_EQUAL("test_fanout_and_binary (filtered)", std::uint64_t{1}, stats.Filtered());
+		ASSERT_EQUAL("test_fanout_and_binary (writes)", std::uint64_t{3}, stats.writes);
+		ASSERT_EQUAL("test_fanout_and_binary (bytes)",
+			static_cast<std::uint64_t>(errors.str().size() + everything.str().size()), stats.bytes);
+	}
+
+	std::ostringstream binary;
+	BinaryLog log(binary, Level::Info, "%L:");
+	log << Level::Info << "value " << 42 << endr;
+	log << Level::Warning << "hidden" << endr;
+	const LogStats stats = log.Stats();
+	ASSERT_EQUAL("test_fanout_and_binary (binary emitted)", std::uint64_t{1}, at(stats.emitted, Level::Info));
+	ASSERT_EQUAL("test_fanout_and_binary (binary filtered)", std::uint64_t{1}, at(stats.filtered, Level::Warning));
+	ASSERT_TRUE("test_fanout_and_binary (binary bytes)", stats.bytes > 0 && stats.bytes < binary.str().size());
+	RETURN_TEST("test_fanout_and_binary", 0);
+}
+
+int test_histogram() {
+	LatencyHistogram histogram;
+	ASSERT_EQUAL("test_histogram (empty)", std::uint64_t{0}, histogram.Percentile(50));
+	ASSERT_EQUAL("test_histogram (bucket 0)", std::size_t{0}, LatencyHistogram::Bucket(0));
+	ASSERT_EQUAL("test_histogram (bucket 1)", std::size_t{1}, LatencyHistogram::Bucket(1));
+	ASSERT_EQUAL("test_histogram (bucket 1000)", std::size_t{10}, LatencyHistogram::Bucket(1000));
+	ASSERT_EQUAL("test_histogram (last)", LatencyHistogram::Buckets - 1, LatencyHistogram::Bucket(~std::uint64_t{0}));
+
+	histogram.counts[LatencyHistogram::Bucket(100)] = 98;
+	histogram.counts[LatencyHistogram::Bucket(5000)] = 2;
+	ASSERT_EQUAL("test_histogram (count)", std::uint64_t{100}, histogram.Count());
+	ASSERT_EQUAL("test_histogram (p50)", std::uint64_t{128}, histogram.Percentile(50));
+	ASSERT_EQUAL("test_histogram (p98)", std::uint64_t{128}, histogram.Percentile(98));
+	ASSERT_EQUAL("test_histogram (p99)", std::uint64_t{8192}, histogram.Percentile(99));
+	RETURN_TEST("test_histogram", 0);
+}
+
+int test_periodic_report() {
+	std::ostringstream output;
+	ThreadedLog log(output, Level::Info, "%L:");
+	log.ReportStats(std::chrono::seconds(0), Level::Error);
+
+	log << Level::Info << "first" << endr;
+	ASSERT_EQUAL("test_periodic_report (first)",
+		std::string("Error   : logger stats emitted=0 filtered=0 bytes=0 dropped=0 queue_high_water=0 "
+					"lock_wait_us=0 lock_hold_us=0 write_p99_ns=0\nInfo    : first\n"), output.str());
+
+	// Not due yet: no report.
+	output.str("");
+	log.ReportStats(std::chrono::seconds(3600));
+	log << Level::Info << "second" << endr;
+	ASSERT_EQUAL("test_periodic_report (not due)", std::string("Info    : second\n"), output.str());
+	RETURN_TEST("test_periodic_report", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_level_counts();
+	result += test_locked_lock_counts();
+	result += test_staged_bytes();
+	result += test_async_queue();
+	result += test_fanout_and_binary();
+	result += test_histogram();
+	result += test_periodic_report();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
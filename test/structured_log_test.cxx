@@ -0,0 +1,184 @@
+#include <StormByte/logger/async_log.hxx>
+#include <StormByte/logger/binary_log.hxx>
+#include <StormByte/logger/fanout_log.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <limits>
+#include <regex>
+#include <sstream>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Sequence run against every logger kind; outputs must match the plain Log's.
+	void script(Log& log) {
+		log << Level::Info << "login" << kv("user", "bob") << kv("attempts", 3) << kv("admin", true) << endr;
+		log << Level::Debug << "filtered" << kv("user", "eve") << endr;
+		log << Level::Error << "disk \"sda\" failing" << kv("free", 0.5) << std::endl;
+		log << Level::Info << redact(4) << kv("token", std::string("abcdef123456")) << no_redact << endr;
+	}
+}
+
+int test_text_fields() {
+	std::ostringstream out;
+	{
+		Log log(out, Level::Info, "%L:");
+		log << Level::Info << "login" << kv("user", "bob") << kv("attempts", 3) << endr;
+		log << Level::Info << kv("first", 1) << " then text" << endr;
+	}
+	ASSERT_EQUAL("test_text_fields", std::string(
+		"Info    : login user=bob attempts=3\n"
+		"Info    : first=1 then text\n"), out.str());
+	RETURN_TEST("test_text_fields", 0);
+}
+
+int test_json_fields() {
+	std::ostringstream out;
+	{
+		Log log(out, Level::Info, HeaderFormat("%L", Encoding::Json));
+		log << Level::Info << "login " << "ok" << kv("user", "bob") << kv("attempts", 3) << kv("ratio", 0.25)
+			<< kv("admin", false) << endr;
+		log << Level::Fatal << kv("only", "field") << std::endl;
+		log << Level::Error << "a" << kv("k", 1) << "b" << endr;
+	}
+	ASSERT_EQUAL("test_json_fields", std::string(
+		"{\"level\":\"Info\",\"msg\":\"login ok\",\"user\":\"bob\",\"attempts\":3,\"ratio\":0.25,\"admin\":false}\n"
+		"{\"level\":\"Fatal\",\"only\":\"field\"}\n"
+		"{\"level\":\"Error\",\"msg\":\"a\",\"k\":1,\"msg\":\"b\"}\n"), out.str());
+	RETURN_TEST("test_json_fields", 0);
+}
+
+int test_logfmt_fields() {
+	std::ostringstream out;
+	{
+		Log log(out, Level::Info, HeaderFormat("%L", Encoding::Logfmt));
+		log << Level::Info << "login" << kv("user", "bob") << kv("name", "Bob Smith") << kv("empty", "")
+			<< kv("eq", "a=b") << kv("attempts", 3) << endr;
+	}
+	ASSERT_EQUAL("test_logfmt_fields", std::string(
+		"level=Info msg=\"login\" user=bob name=\"Bob Smith\" empty=\"\" eq=\"a=b\" attempts=3\n"), out.str());
+	RETURN_TEST("test_logfmt_fields", 0);
+}
+
+int test_escaping() {
+	std::ostringstream json, logfmt;
+	// Longer than 32 bytes on both sides of every special character, so the vector scans see them.
+	const std::string padding(40, 'x');
+	const std::string value = padding + "\"q\" \\ \n\t\r\b\f" + std::string(1, '\x01') + padding;
+	const std::string escaped = padding + "\\\"q\\\" \\\\ \\n\\t\\r\\b\\f\\u0001" + padding;
+	{
+		Log log(json, Level::Info, HeaderFormat("%L", Encoding::Json));
+		log << Level::Info << value << kv("v", value) << kv("ke\"y", 1) << endr;
+	}
+	{
+		Log log(logfmt, Level::Info, HeaderFormat("%L", Encoding::Logfmt));
+		log << Level::Info << kv("v", value) << kv("plain", padding) << endr;
+	}
+	ASSERT_EQUAL("test_escaping (json)", "{\"level\":\"Info\",\"msg\":\"" + escaped + "\",\"v\":\"" + escaped
+		+ "\",\"ke\\\"y\":1}\n", json.str());
+	ASSERT_EQUAL("test_escaping (logfmt)", "level=Info v=\"" + escaped + "\" plain=" + padding + "\n", logfmt.str());
+	RETURN_TEST("test_escaping", 0);
+}
+
+int test_non_bare_numbers_quoted() {
+	std::ostringstream out;
+	{
+		Log log(out, Level::Info, HeaderFormat("%L", Encoding::Json));
+		log << Level::Info << std::hex << kv("hex", 255) << std::dec
+			<< humanreadable_number << kv("big", 1234567) << nohumanreadable
+			<< kv("inf", std::numeric_limits<double>::infinity()) << kv("nan", std::numeric_limits<double>::quiet_NaN())
+			<< endr;
+	}
+	const std::string text = out.str();
+	ASSERT_EQUAL("test_non_bare_numbers_quoted (hex)", true, text.find(",\"hex\":\"ff\"") != std::string::npos);
+	ASSERT_EQUAL("test_non_bare_numbers_quoted (human readable)", true, std::regex_search(text, std::regex(",\"big\":\"1[^\"]*\"")));
+	ASSERT_EQUAL("test_non_bare_numbers_quoted (inf)", true, text.find(",\"inf\":\"inf\"") != std::string::npos);
+	ASSERT_EQUAL("test_non_bare_numbers_quoted (nan)", true, std::regex_search(text, std::regex(",\"nan\":\"-?nan\"")));
+	RETURN_TEST("test_non_bare_numbers_quoted", 0);
+}
+
+int test_redacted_values() {
+	std::ostringstream json, logfmt;
+	{
+		Log log(json, Level::Info, HeaderFormat("%L", Encoding::Json));
+		log << Level::Info << kv("user", "bob") << redact(4) << kv("card", "4111111111111111") << kv("pin", 1234)
+			<< no_redact << kv("n", 1) << endr;
+	}
+	{
+		Log log(logfmt, Level::Info, HeaderFormat("%L", Encoding::Logfmt));
+		log << Level::Info << redact << kv("password", "hunter2") << endr;
+	}
+	ASSERT_EQUAL("test_redacted_values (json)", std::string(
+		"{\"level\":\"Info\",\"user\":\"bob\",\"card\":\"************1111\",\"pin\":\"1234\",\"n\":1}\n"), json.str());
+	ASSERT_EQUAL("test_redacted_values (logfmt)", std::string("level=Info password=\"*******\"\n"), logfmt.str());
+	RETURN_TEST("test_redacted_values", 0);
+}
+
+int test_structured_header_fields() {
+	std::ostringstream json, logfmt;
+	{
+		Log log(json, Level::Info, HeaderFormat("[%i] %T.%3 <%L>", Encoding::Json));
+		log << Level::Info << "hi" << endr;
+	}
+	{
+		Log log(logfmt, Level::Info, HeaderFormat("%L %I", Encoding::Logfmt));
+		log << Level::Info << "hi" << endr;
+	}
+	ASSERT_EQUAL("test_structured_header_fields (json)", true, std::regex_match(json.str(),
+		std::regex("\\{\"level\":\"Info\",\"time\":\"[^\"]+ \\d\\d:\\d\\d:\\d\\d\\.\\d{3}\",\"thread\":\"[^\"]+\",\"msg\":\"hi\"\\}\n")));
+	ASSERT_EQUAL("test_structured_header_fields (logfmt)", true, std::regex_match(logfmt.str(),
+		std::regex("level=Info time=\\S+ msg=\"hi\"\n")));
+	RETURN_TEST("test_structured_header_fields", 0);
+}
+
+int test_loggers_agree() {
+	const HeaderFormat format("%L", Encoding::Json);
+	std::ostringstream text, async, staged, fanned, binary, decoded;
+	{
+		Log log(text, Level::Info, format);
+		script(log);
+	}
+	{
+		AsyncLog log(async, Level::Info, format);
+		script(log);
+	}
+	{
+		ThreadedLog log(staged, Level::Info, format, LineMode::Staged);
+		script(log);
+	}
+	{
+		FanoutLog log({ Route(fanned, Level::Info, HeaderFormat("%L")) }, format);
+		script(log);
+	}
+	{
+		BinaryLog log(binary, Level::Info, format);
+		script(log);
+	}
+	std::istringstream in(binary.str());
+	ASSERT_EQUAL("test_loggers_agree (decode)", true, BinaryLog::Decode(in, decoded));
+	ASSERT_EQUAL("test_loggers_agree (async)", text.str(), async.str());
+	ASSERT_EQUAL("test_loggers_agree (staged)", text.str(), staged.str());
+	ASSERT_EQUAL("test_loggers_agree (fanout)", text.str(), fanned.str());
+	ASSERT_EQUAL("test_loggers_agree (binary)", text.str(), decoded.str());
+	RETURN_TEST("test_loggers_agree", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_text_fields();
+	result += test_json_fields();
+	result += test_logfmt_fields();
+	result += test_escaping();
+	result += test_non_bare_numbers_quoted();
+	result += test_redacted_values();
+	result += test_structured_header_fields();
+	result += test_loggers_agree();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
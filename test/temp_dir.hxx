@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <system_error>
+
+namespace StormByte::Logger::Test {
+	/**
+	 * Fresh directory in the temp directory, removed with its content when the guard goes out of scope.
+	 * @p name must be unique across the test programs, which may run in parallel.
+	 */
+	class TempDir {
+		public:
+			explicit TempDir(const std::string& name):
+				m_path(std::filesystem::temp_directory_path() / ("stormbyte_logger_" + name)) {
+				std::filesystem::remove_all(m_path);
+				std::filesystem::create_directories(m_path);
+			}
+			~TempDir() {
+				std::error_code error;
+				std::filesystem::remove_all(m_path, error);
+			}
+			TempDir(const TempDir&) = delete;
+			TempDir& operator=(const TempDir&) = delete;
+
+			const std::filesystem::path& Path() const { return m_path; }
+			std::filesystem::path Log() const { return m_path / "app.log"; }
+			std::filesystem::path Segment(int index) const { return m_path / ("app.log." + std::to_string(index)); }
+			std::size_t Files() const {
+				return static_cast<std::size_t>(std::distance(std::filesystem::directory_iterator(m_path), std::filesystem::directory_iterator()));
+			}
+			// Content of the log file.
+			std::string Read() const { return Read(Log()); }
+			static std::string Read(const std::filesystem::path& path) {
+				std::ifstream in(path, std::ios::binary);
+				return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+			}
+		private:
+			std::filesystem::path m_path;
+	};
+}
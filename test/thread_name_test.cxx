@@ -0,0 +1,169 @@
+#include <StormByte/logger/async_log.hxx>
+#include <StormByte/logger/binary_log.hxx>
+#include <StormByte/logger/fanout_log.hxx>
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+using namespace StormByte::Logger;
+
+namespace {
+	std::string this_thread_id() {
+		std::ostringstream id;
+		id << std::this_thread::get_id();
+		return id.str();
+	}
+
+	std::string this_thread_tid() {
+		std::ostringstream probe;
+		Log(probe, Level::Info, "%t:") << Level::Info << "x" << endr;
+		return probe.str().substr(0, probe.str().find(':'));
+	}
+
+	bool all_digits(const std::string& text) {
+		return !text.empty() && text.find_first_not_of("0123456789") == std::string::npos;
+	}
+
+	// Logs one unnamed and one named line from a new thread; returns that thread's id.
+	std::string rename_in_worker(Log& log, std::string& tid) {
+		std::string id;
+		std::thread worker([&] {
+			id = this_thread_id();
+			tid = this_thread_tid();
+			log << Level::Info << "unnamed" << endr;
+			SetThreadName("worker");
+			log << Level::Info << "named" << endr;
+		});
+		worker.join();
+		return id;
+	}
+}
+
+int test_thread_id_text() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%i:");
+	log << Level::Info << "a" << endr;
+	log << Level::Info << "b" << endr;
+	const std::string id = this_thread_id();
+	ASSERT_EQUAL("test_thread_id_text", id + ": a\n" + id + ": b\n", output.str());
+	RETURN_TEST("test_thread_id_text", 0);
+}
+
+int test_thread_name() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "[%n|%t]");
+
+	std::string tid, name;
+	std::thread worker([&] {
+		tid = this_thread_tid();
+		log << Level::Info << "unnamed" << endr;
+		SetThreadName("db-pool-1");
+		name = ThreadName();
+		log << Level::Info << "named" << endr;
+		SetThreadName("");
+		log << Level::Info << "cleared" << endr;
+	});
+	worker.join();
+
+	// Unnamed threads show their kernel thread id in both fields.
+	ASSERT_EQUAL("test_thread_name (tid)", true, all_digits(tid));
+	ASSERT_EQUAL("test_thread_name (get)", std::string("db-pool-1"), name);
+	ASSERT_EQUAL("test_thread_name", "[" + tid + "|" + tid + "] unnamed\n[db-pool-1|" + tid + "] named\n["
+		+ tid + "|" + tid + "] cleared\n", output.str());
+	RETURN_TEST("test_thread_name", 0);
+}
+
+int test_thread_name_truncated() {
+	std::ostringstream output;
+	Log log(output, Level::Info, "%n:");
+	std::thread worker([&] {
+		SetThreadName(std::string(100, 'n'));
+		log << Level::Info << "x" << endr;
+	});
+	worker.join();
+	ASSERT_EQUAL("test_thread_name_truncated", std::string(63, 'n') + ": x\n", output.str());
+	RETURN_TEST("test_thread_name_truncated", 0);
+}
+
+int test_staged_loggers_follow_renames() {
+	// Loggers that render headers away from the producing thread keep a copy of its name.
+	std::ostringstream threaded, async, fanout;
+	std::string tid;
+	{
+		ThreadedLog log(threaded, Level::Info, "%n:", LineMode::Staged);
+		rename_in_worker(log, tid);
+	}
+	const std::string expected = tid + ": unnamed\nworker: named\n";
+	ASSERT_EQUAL("test_staged_loggers_follow_renames (threaded)", expected, threaded.str());
+	{
+		AsyncLog log(async, Level::Info, "%n:");
+		rename_in_worker(log, tid);
+	}
+	ASSERT_EQUAL("test_staged_loggers_follow_renames (async)", tid + ": unnamed\nworker: named\n", async.str());
+	{
+		FanoutLog log({ Route(fanout, Level::Info) }, "%n:");
+		rename_in_worker(log, tid);
+	}
+	ASSERT_EQUAL("test_staged_loggers_follow_renames (fanout)", tid + ": unnamed\nworker: named\n", fanout.str());
+	RETURN_TEST("test_staged_loggers_follow_renames", 0);
+}
+
+int test_binary_thread_name() {
+	std::ostringstream binary;
+	std::string tid, id;
+	{
+		BinaryLog log(binary, Level::Info, "%i %n %t:");
+		id = rename_in_worker(log, tid);
+	}
+	std::istringstream in(binary.str());
+	std::ostringstream decoded;
+	ASSERT_EQUAL("test_binary_thread_name (decoded)", true, BinaryLog::Decode(in, decoded));
+	ASSERT_EQUAL("test_binary_thread_name",
+		id + " " + tid + " " + tid + ": unnamed\n" + id + " worker " + tid + ": named\n", decoded.str());
+	RETURN_TEST("test_binary_thread_name", 0);
+}
+
+int test_structured_thread_fields() {
+	std::ostringstream json, logfmt;
+	std::thread worker([&] {
+		SetThreadName("io \"main\"");
+		Log(json, Level::Info, HeaderFormat("%L %n", Encoding::Json)) << Level::Info << "x" << endr;
+		Log(logfmt, Level::Info, HeaderFormat("%L %n %t", Encoding::Logfmt)) << Level::Info << "x" << endr;
+	});
+	worker.join();
+	ASSERT_EQUAL("test_structured_thread_fields (json)",
+		std::string("{\"level\":\"Info\",\"thread_name\":\"io \\\"main\\\"\",\"msg\":\"x\"}\n"), json.str());
+	const std::string line = logfmt.str();
+	ASSERT_EQUAL("test_structured_thread_fields (logfmt)", std::size_t{ 0 },
+		line.find("level=Info thread_name=\"io \\\"main\\\"\" tid="));
+	RETURN_TEST("test_structured_thread_fields", 0);
+}
+
+int test_pattern_round_trip() {
+	const HeaderFormat runtime("[%L] %n/%t %i:");
+	const HeaderFormat compiled = header_format<"[%L] %n/%t %i:">;
+	ASSERT_EQUAL("test_pattern_round_trip (pattern)", std::string("[%L] %n/%t %i:"), runtime.Pattern());
+	ASSERT_EQUAL("test_pattern_round_trip (compiled)", true, runtime.Tokens() == compiled.Tokens());
+	RETURN_TEST("test_pattern_round_trip", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_thread_id_text();
+	result += test_thread_name();
+	result += test_thread_name_truncated();
+	result += test_staged_loggers_follow_renames();
+	result += test_binary_thread_name();
+	result += test_structured_thread_fields();
+	result += test_pattern_round_trip();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
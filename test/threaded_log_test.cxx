@@ -1,6 +1,7 @@
 #include <StormByte/logger/threaded_log.hxx>
 #include <StormByte/test_handlers.h>
 
+#include <algorithm>
 #include <sstream>
 #include <thread>
 #include <vector>
@@ -8,6 +9,8 @@
 #include <future>
 #include <chrono>
 #include <atomic>
+#include <latch>
+#include <memory>
 
 using namespace StormByte::Logger;
 
@@ -218,6 +221,309 @@ int test_threadedlog_level_switch_flush() {
 	RETURN_TEST("test_threadedlog_level_switch_flush", 0);
 }
 
+// --- Staged line mode ---
+
+int test_threadedlog_staged_basic() {
+	std::ostringstream output;
+	ThreadedLog tlog(output, Level::Info, "%L:", LineMode::Staged);
+
+	tlog << Level::Info << "Staged " << 42 << " " << redact(2) << "secret" << std::endl;
+	tlog << Level::Debug << "hidden" << std::endl;
+	tlog << Level::Error << no_redact << "visible" << std::endl;
+
+	std::string expected = "Info    : Staged 42 ****et\nError   : visible\n";
+	ASSERT_EQUAL("test_threadedlog_staged_basic", expected, output.str());
+	RETURN_TEST("test_threadedlog_staged_basic", 0);
+}
+
+int test_threadedlog_staged_multithreaded_ordering() {
+	std::ostringstream output;
+	ThreadedLog tlog(output, Level::Info, "%L:", LineMode::Staged);
+
+	const int threads = 8;
+	const int repeats = 200;
+
+	auto worker = [&](int id) {
+		for (int i = 0; i < repeats; ++i) {
+			tlog << Level::Info << "T" << id << ":" << i;
+			if (i % 2) tlog << Level::Debug << "filtered" << std::endl;
+			else tlog << std::endl;
+		}
+	};
+
+	std::vector<std::thread> pool;
+	for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+	for (auto &th : pool) th.join();
+
+	std::istringstream in(output.str());
+	std::string line;
+	int count = 0;
+	std::regex r("^Info\\s+: T\\d+:\\d+$");
+	while (std::getline(in, line)) {
+		if (line.empty()) continue;
+		if (!std::regex_match(line, r)) {
+			ASSERT_EQUAL("test_threadedlog_staged_multithreaded_ordering (line_format)", "OK", std::string("BAD: ") + line);
+			RETURN_TEST("test_threadedlog_staged_multithreaded_ordering", 1);
+		}
+		++count;
+	}
+
+	ASSERT_EQUAL("test_threadedlog_staged_multithreaded_ordering (count)", std::to_string(threads * repeats), std::to_string(count));
+	RETURN_TEST("test_threadedlog_staged_multithreaded_ordering", 0);
+}
+
+int test_threadedlog_staged_unterminated_written_on_destruction() {
+	std::ostringstream output;
+	{
+		ThreadedLog tlog(output, Level::Info, "%L:", LineMode::Staged);
+		tlog << Level::Info << "partial";
+		ASSERT_EQUAL("test_threadedlog_staged_unterminated_written_on_destruction (staged)", std::string(""), output.str());
+	}
+
+	ASSERT_EQUAL("test_threadedlog_staged_unterminated_written_on_destruction", std::string("Info    : partial\n"), output.str());
+	RETURN_TEST("test_threadedlog_staged_unterminated_written_on_destruction", 0);
+}
+
+int test_threadedlog_staged_destructor_ends_partial_lines() {
+	// Both producers are still running when the logger goes: the destructor commits their lines.
+	std::ostringstream output;
+	auto log = std::make_unique<ThreadedLog>(output, Level::Info, "%L:", LineMode::Staged);
+	std::latch staged(2);
+	std::latch destroyed(1);
+	auto producer = [&](const char* text) {
+		*log << Level::Info << text;
+		staged.count_down();
+		destroyed.wait();
+	};
+	std::thread first(producer, "first");
+	std::thread second(producer, "second");
+	staged.wait();
+	log.reset();
+	destroyed.count_down();
+	first.join();
+	second.join();
+
+	const std::string out = output.str();
+	ASSERT_TRUE("test_threadedlog_staged_destructor_ends_partial_lines",
+		out == "Info    : first\nInfo    : second\n" || out == "Info    : second\nInfo    : first\n");
+	RETURN_TEST("test_threadedlog_staged_destructor_ends_partial_lines", 0);
+}
+
+int test_threadedlog_staged_exited_thread() {
+	// The second thread may be handed the first one's id: it must not inherit its line.
+	std::ostringstream output;
+	LogStats stats;
+	{
+		ThreadedLog tlog(output, Level::Info, "%L:", LineMode::Staged);
+		std::thread([&] { tlog << Level::Info << "partial"; }).join();
+		std::thread([&] { tlog << Level::Info << "whole" << endr; }).join();
+		stats = tlog.Stats();
+	}
+
+	ASSERT_EQUAL("test_threadedlog_staged_exited_thread", std::string("Info    : partial\nInfo    : whole\n"), output.str());
+	ASSERT_EQUAL("test_threadedlog_staged_exited_thread (counted)", std::uint64_t{2}, stats.Emitted());
+	RETURN_TEST("test_threadedlog_staged_exited_thread", 0);
+}
+
+int test_threadedlog_staged_flush_reaches_stream() {
+	// Counts sync requests reaching the underlying buffer.
+	struct SyncCounter final: std::stringbuf {
+		int syncs = 0;
+		int sync() override { ++syncs; return std::stringbuf::sync(); }
+	} buffer;
+	std::ostream output(&buffer);
+	ThreadedLog tlog(output, Level::Info, "%L:", LineMode::Staged);
+
+	tlog << Level::Info << "pending" << std::flush;
+	ASSERT_EQUAL("test_threadedlog_staged_flush_reaches_stream (synced)", true, buffer.syncs > 0);
+	ASSERT_EQUAL("test_threadedlog_staged_flush_reaches_stream (staged)", std::string(""), buffer.str());
+	tlog << std::endl;
+
+	ASSERT_EQUAL("test_threadedlog_staged_flush_reaches_stream", std::string("Info    : pending\n"), buffer.str());
+	RETURN_TEST("test_threadedlog_staged_flush_reaches_stream", 0);
+}
+
+// --- Sharded line mode ---
+
+int test_threadedlog_sharded_basic() {
+	std::ostringstream output;
+	{
+		ThreadedLog tlog(output, Level::Info, "%L:", LineMode::Sharded);
+		tlog << Level::Info << "Sharded " << 42 << " " << redact(2) << "secret" << std::endl;
+		tlog << Level::Debug << "hidden" << std::endl;
+		tlog << Level::Error << no_redact << "visible" << std::endl;
+	}
+
+	std::string expected = "Info    : Sharded 42 ****et\nError   : visible\n";
+	ASSERT_EQUAL("test_threadedlog_sharded_basic", expected, output.str());
+	RETURN_TEST("test_threadedlog_sharded_basic", 0);
+}
+
+int test_threadedlog_sharded_multithreaded_ordering() {
+	std::ostringstream output;
+	const int threads = 8;
+	const int repeats = 500;
+	{
+		// Few small shards: producers share them and wait on full rings.
+		ThreadedLog tlog(output, Level::Info, "%L:", ShardOptions{ .shards = 3, .capacity = 16 });
+		auto worker = [&](int id) {
+			for (int i = 0; i < repeats; ++i)
+				tlog << Level::Info << "T" << id << ":" << i << endr;
+		};
+		std::vector<std::thread> pool;
+		for (int t = 0; t < threads; ++t) pool.emplace_back(worker, t);
+		for (auto &th : pool) th.join();
+	}
+
+	// Every line present, each thread's lines in the order it wrote them.
+	std::vector<int> next(threads, 0);
+	std::istringstream in(output.str());
+	std::string line;
+	std::regex r("^Info\\s+: T(\\d+):(\\d+)$");
+	std::smatch match;
+	int count = 0;
+	while (std::getline(in, line)) {
+		if (!std::regex_match(line, match, r)) {
+			ASSERT_EQUAL("test_threadedlog_sharded_multithreaded_ordering (line_format)", "OK", std::string("BAD: ") + line);
+			RETURN_TEST("test_threadedlog_sharded_multithreaded_ordering", 1);
+		}
+		const int id = std::stoi(match[1]);
+		ASSERT_EQUAL("test_threadedlog_sharded_multithreaded_ordering (per thread)", next[id], std::stoi(match[2]));
+		++next[id];
+		++count;
+	}
+	ASSERT_EQUAL("test_threadedlog_sharded_multithreaded_ordering (count)", threads * repeats, count);
+	RETURN_TEST("test_threadedlog_sharded_multithreaded_ordering", 0);
+}
+
+int test_threadedlog_sharded_time_order() {
+	std::ostringstream output;
+	{
+		ThreadedLog tlog(output, Level::Info, "%L:", ShardOptions{ .shards = 4 });
+		// Each phase's threads finish before the next starts: lines stay in phase order
+		// whichever shard they went through.
+		for (int phase = 0; phase < 4; ++phase) {
+			std::vector<std::thread> pool;
+			for (int t = 0; t < 4; ++t) {
+				pool.emplace_back([&, phase] {
+					for (int i = 0; i < 50; ++i)
+						tlog << Level::Info << "P" << phase << endr;
+				});
+			}
+			for (auto& th : pool) th.join();
+		}
+	}
+
+	std::istringstream in(output.str());
+	std::string line;
+	std::string seen_order;
+	int count = 0;
+	while (std::getline(in, line)) {
+		if (seen_order.empty() || seen_order.back() != line.back())
+			seen_order += line.back();
+		++count;
+	}
+	ASSERT_EQUAL("test_threadedlog_sharded_time_order (count)", 800, count);
+	ASSERT_EQUAL("test_threadedlog_sharded_time_order", std::string("0123"), seen_order);
+	RETURN_TEST("test_threadedlog_sharded_time_order", 0);
+}
+
+int test_threadedlog_sharded_unterminated_written_on_destruction() {
+	std::ostringstream output;
+	{
+		ThreadedLog tlog(output, Level::Info, "%L:", LineMode::Sharded);
+		tlog << Level::Info << "done" << endr;
+		tlog << Level::Info << "partial";
+	}
+
+	ASSERT_EQUAL("test_threadedlog_sharded_unterminated_written_on_destruction",
+		std::string("Info    : done\nInfo    : partial\n"), output.str());
+	RETURN_TEST("test_threadedlog_sharded_unterminated_written_on_destruction", 0);
+}
+
+int test_threadedlog_sharded_flush_reaches_stream() {
+	struct SyncCounter final: std::stringbuf {
+		std::atomic<int> syncs = 0;
+		int sync() override { ++syncs; return std::stringbuf::sync(); }
+	} buffer;
+	std::ostream output(&buffer);
+	// A long merge window: only the flush can get the line out this early.
+	ThreadedLog tlog(output, Level::Info, "%L:", ShardOptions{ .skew = std::chrono::seconds(30) });
+
+	tlog << Level::Info << "queued" << endr;
+	tlog << Level::Info << "pending" << std::flush;
+	ASSERT_EQUAL("test_threadedlog_sharded_flush_reaches_stream (synced)", true, buffer.syncs > 0);
+	ASSERT_EQUAL("test_threadedlog_sharded_flush_reaches_stream", std::string("Info    : queued\n"), buffer.str());
+	RETURN_TEST("test_threadedlog_sharded_flush_reaches_stream", 0);
+}
+
+int test_threadedlog_lazy_per_mode() {
+	int result = 0;
+	for (const auto mode : { LineMode::Locked, LineMode::Staged, LineMode::Sharded }) {
+		std::ostringstream output;
+		std::atomic<int> calls{0};
+		{
+			ThreadedLog tlog(output, Level::Info, "%L:", mode);
+			auto dump = [&] { calls.fetch_add(1); return std::string("dump"); };
+
+			auto worker = [&] {
+				for (int i = 0; i < 100; ++i) {
+					tlog << Level::Debug << dump << std::endl;
+					tlog << Level::Info << dump << std::endl;
+				}
+			};
+			std::vector<std::thread> pool;
+			for (int t = 0; t < 4; ++t) pool.emplace_back(worker);
+			for (auto& th : pool) th.join();
+		}
+
+		std::string out = output.str();
+		ASSERT_EQUAL("test_threadedlog_lazy_per_mode (calls)", 400, calls.load());
+		ASSERT_EQUAL("test_threadedlog_lazy_per_mode (lines)", std::string::difference_type{400},
+			std::count(out.begin(), out.end(), '\n'));
+	}
+	RETURN_TEST("test_threadedlog_lazy_per_mode", result);
+}
+
+int test_threadedlog_records_per_mode() {
+	int result = 0;
+	for (const auto mode : { LineMode::Locked, LineMode::Staged, LineMode::Sharded }) {
+		std::ostringstream output;
+		{
+			ThreadedLog tlog(output, Level::Info, "%L:", mode);
+
+			auto worker = [&](int id) {
+				for (int i = 0; i < 200; ++i) {
+					if (i % 2) {
+						auto record = tlog.Record(Level::Info);
+						record << "T" << id;
+						record << ":" << i;
+					} else {
+						tlog << Level::Info << "T" << id << ":" << i << endr;
+					}
+				}
+			};
+			std::vector<std::thread> pool;
+			for (int t = 0; t < 4; ++t) pool.emplace_back(worker, t);
+			for (auto& th : pool) th.join();
+		}
+
+		std::istringstream in(output.str());
+		std::string line;
+		int count = 0;
+		std::regex r("^Info\\s+: T\\d+:\\d+$");
+		while (std::getline(in, line)) {
+			if (!std::regex_match(line, r)) {
+				ASSERT_EQUAL("test_threadedlog_records_per_mode (line_format)", "OK", std::string("BAD: ") + line);
+				RETURN_TEST("test_threadedlog_records_per_mode", 1);
+			}
+			++count;
+		}
+		ASSERT_EQUAL("test_threadedlog_records_per_mode (count)", 800, count);
+	}
+	RETURN_TEST("test_threadedlog_records_per_mode", result);
+}
+
 int main() {
 	int result = 0;
 	result += test_threadedlog_basic();
@@ -228,6 +534,19 @@ int main() {
 	result += test_threadedlog_filtered_endl_no_deadlock();
 	result += test_threadedlog_filtered_multithreaded_then_info();
 	result += test_threadedlog_level_switch_flush();
+	result += test_threadedlog_staged_basic();
+	result += test_threadedlog_staged_multithreaded_ordering();
+	result += test_threadedlog_staged_unterminated_written_on_destruction();
+	result += test_threadedlog_staged_destructor_ends_partial_lines();
+	result += test_threadedlog_staged_exited_thread();
+	result += test_threadedlog_staged_flush_reaches_stream();
+	result += test_threadedlog_sharded_basic();
+	result += test_threadedlog_sharded_multithreaded_ordering();
+	result += test_threadedlog_sharded_time_order();
+	result += test_threadedlog_sharded_unterminated_written_on_destruction();
+	result += test_threadedlog_sharded_flush_reaches_stream();
+	result += test_threadedlog_lazy_per_mode();
+	result += test_threadedlog_records_per_mode();
 
 	if (result == 0) {
 		std::cout << "All tests passed!" << std::endl;
@@ -0,0 +1,145 @@
+#include <StormByte/logger/threaded_log.hxx>
+#include <StormByte/logger/throttle.hxx>
+#include <StormByte/test_handlers.h>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace StormByte::Logger;
+
+namespace {
+	// Allowed calls out of @p calls.
+	std::size_t allowed(Throttle& throttle, std::size_t calls, std::uint64_t key = 0) {
+		std::size_t passed = 0;
+		for (std::size_t i = 0; i < calls; ++i)
+			passed += throttle.Allow(key);
+		return passed;
+	}
+
+	// Lines of @p text.
+	std::size_t lines(const std::string& text) {
+		std::size_t count = 0;
+		for (const char c : text)
+			count += c == '\n';
+		return count;
+	}
+}
+
+int test_sampling() {
+	Throttle throttle({ .sample = 4 });
+	ASSERT_EQUAL("test_sampling (allowed)", std::size_t(25), allowed(throttle, 100));
+	ASSERT_EQUAL("test_sampling (suppressed)", std::uint64_t(75), throttle.Suppressed().count);
+	ASSERT_EQUAL("test_sampling (taken)", std::uint64_t(0), throttle.Suppressed().count);
+	RETURN_TEST("test_sampling", 0);
+}
+
+int test_rate_limit() {
+	Throttle throttle({ .rate = 0.001, .burst = 5 });
+	ASSERT_EQUAL("test_rate_limit (burst)", std::size_t(5), allowed(throttle, 100));
+	ASSERT_EQUAL("test_rate_limit (suppressed)", std::uint64_t(95), throttle.Suppressed().count);
+
+	Throttle fast({ .rate = 1000 });
+	ASSERT_EQUAL("test_rate_limit (first)", true, fast.Allow());
+	ASSERT_EQUAL("test_rate_limit (too soon)", false, fast.Allow());
+	std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	ASSERT_EQUAL("test_rate_limit (refilled)", true, fast.Allow());
+	RETURN_TEST("test_rate_limit", 0);
+}
+
+int test_collapse() {
+	Throttle throttle({ .collapse = std::chrono::milliseconds(50) });
+	ASSERT_EQUAL("test_collapse (first)", true, throttle.Allow(1));
+	ASSERT_EQUAL("test_collapse (repeats)", std::size_t(0), allowed(throttle, 3, 1));
+	ASSERT_EQUAL("test_collapse (other key)", true, throttle.Allow(2));
+	ASSERT_EQUAL("test_collapse (back to first key)", true, throttle.Allow(1));
+	ASSERT_EQUAL("test_collapse (suppressed)", std::uint64_t(3), throttle.Suppressed().count);
+	std::this_thread::sleep_for(std::chrono::milliseconds(60));
+	ASSERT_EQUAL("test_collapse (window over)", true, throttle.Allow(1));
+	RETURN_TEST("test_collapse", 0);
+}
+
+int test_statement() {
+	std::ostringstream out;
+	int evaluated = 0;
+	{
+		Log log(out, Level::Info, "%L");
+		for (int i = 0; i < 10; ++i)
+			STORMBYTE_LOG_THROTTLED(log, Level::Info, STORMBYTE_THROTTLE(.sample = 5)) << "hit " << (evaluated++, i) << endr;
+		for (int i = 0; i < 3; ++i)
+			STORMBYTE_LOG_THROTTLED(log, Level::Debug, STORMBYTE_THROTTLE()) << "filtered" << endr;
+	}
+	ASSERT_EQUAL("test_statement (operands)", 2, evaluated);
+	ASSERT_EQUAL("test_statement", std::string("Info     hit 0\nInfo     suppressed=4 hit 5\n"), out.str());
+	RETURN_TEST("test_statement", 0);
+}
+
+int test_structured_report() {
+	std::ostringstream out;
+	Throttle throttle({ .sample = 3 });
+	{
+		Log log(out, Level::Info, HeaderFormat("%L", Encoding::Json));
+		for (int i = 0; i < 4; ++i)
+			STORMBYTE_LOG_THROTTLED(log, Level::Error, throttle) << "failed" << endr;
+	}
+	ASSERT_EQUAL("test_structured_report", std::string(
+		"{\"level\":\"Error\",\"msg\":\"failed\"}\n"
+		"{\"level\":\"Error\",\"suppressed\":2,\"msg\":\"failed\"}\n"), out.str());
+	RETURN_TEST("test_structured_report", 0);
+}
+
+int test_group() {
+	ThrottleGroup group({ .rate = 0.001 }, 256);
+	ASSERT_EQUAL("test_group (same key)", true, &group.For("db") == &group.For("db"));
+	ASSERT_EQUAL("test_group (db)", std::size_t(1), allowed(group.For("db"), 10));
+	if (&group.For("db") != &group.For("cache"))
+		ASSERT_EQUAL("test_group (cache)", std::size_t(1), allowed(group.For("cache"), 10));
+
+	ThrottleGroup shared({ .rate = 0.001 }, 1);
+	ASSERT_EQUAL("test_group (one slot)", true, &shared.For("db") == &shared.For("cache"));
+	RETURN_TEST("test_group", 0);
+}
+
+int test_threads() {
+	// Every call is either emitted or counted exactly once.
+	std::ostringstream out;
+	Throttle throttle({ .rate = 0.001, .burst = 10 });
+	constexpr std::size_t threads = 8, calls = 20000;
+	std::uint64_t reported = 0;
+	{
+		ThreadedLog log(out, Level::Info, "%L");
+		std::vector<std::thread> workers;
+		for (std::size_t t = 0; t < threads; ++t) {
+			workers.emplace_back([&] {
+				for (std::size_t i = 0; i < calls; ++i)
+					STORMBYTE_LOG_THROTTLED(log, Level::Error, throttle) << "x" << endr;
+			});
+		}
+		for (auto& worker : workers)
+			worker.join();
+	}
+	const std::string text = out.str();
+	for (std::size_t at = text.find("suppressed="); at != std::string::npos; at = text.find("suppressed=", at + 1))
+		reported += std::stoull(text.substr(at + 11));
+	ASSERT_EQUAL("test_threads (lines)", std::size_t(10), lines(text));
+	ASSERT_EQUAL("test_threads (counted)", std::uint64_t(threads * calls), 10 + reported + throttle.Suppressed().count);
+	RETURN_TEST("test_threads", 0);
+}
+
+int main() {
+	int result = 0;
+	result += test_sampling();
+	result += test_rate_limit();
+	result += test_collapse();
+	result += test_statement();
+	result += test_structured_report();
+	result += test_group();
+	result += test_threads();
+
+	if (result == 0) {
+		std::cout << "All tests passed!" << std::endl;
+	} else {
+		std::cout << result << " tests failed." << std::endl;
+	}
+	return result;
+}
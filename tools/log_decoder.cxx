@@ -0,0 +1,63 @@
+#include <StormByte/logger/binary_log.hxx>
+
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+
+using namespace StormByte::Logger;
+
+// Renders a BinaryLog file as the text a Log with the same level and format would have written.
+namespace {
+	void usage(const char* program) {
+		std::cerr << "Usage: " << program << " [options] FILE\n"
+				<< "  --format F        Header format to use instead of the recorded one (see Log)\n"
+				<< "  --output PATH     Write the text to PATH instead of standard output\n";
+	}
+}
+
+int main(int argc, char** argv) {
+	std::optional<std::string> format;
+	std::string input, output;
+
+	for (int i = 1; i < argc; ++i) {
+		const std::string arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		if (arg == "--format" && has_value)
+			format = argv[++i];
+		else if (arg == "--output" && has_value)
+			output = argv[++i];
+		else if (input.empty() && !arg.starts_with("--"))
+			input = arg;
+		else {
+			usage(argv[0]);
+			return arg == "--help" ? 0 : 1;
+		}
+	}
+	if (input.empty()) {
+		usage(argv[0]);
+		return 1;
+	}
+
+	std::ifstream in(input, std::ios::binary);
+	if (!in) {
+		std::cerr << argv[0] << ": cannot open " << input << "\n";
+		return 1;
+	}
+	std::ofstream file;
+	if (!output.empty()) {
+		file.open(output, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			std::cerr << argv[0] << ": cannot create " << output << "\n";
+			return 1;
+		}
+	}
+	std::ostream& out = output.empty() ? std::cout : file;
+
+	const bool decoded = format ? BinaryLog::Decode(in, out, *format) : BinaryLog::Decode(in, out);
+	if (!decoded) {
+		std::cerr << argv[0] << ": " << input << " is not a binary log or is truncated\n";
+		return 2;
+	}
+	return 0;
+}